@@ -0,0 +1,450 @@
+/*
+ * benchgraph.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Benchmark that times loading a graph, batches of weighted and unweighted
+ * paths, batches of link predictions, and the minimum spanning tree on a
+ * generated power-law graph, reporting throughput with p50 and p99 latency.
+ * Unweighted paths are also timed with their searches interleaved by the
+ * batch engine. Paths and predictions can also be timed on a copy of the graph
+ * kept in huge pages, counting the dTLB misses of each
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ActorGraph.cpp"
+#include "ActorGraph.hpp"
+#include "BatchPathFinder.hpp"
+#include "GraphGenerator.hpp"
+#include "LinkPredictor.hpp"
+#include "MovieTraveler.hpp"
+#include "PathFinder.hpp"
+
+#define ARG_TWO 2
+#define ACTORS_FLAG "--actors"
+#define MOVIES_FLAG "--movies"
+#define QUERIES_FLAG "--queries"
+#define PREDICTIONS_FLAG "--predictions"
+#define RUNS_FLAG "--runs"
+#define SEED_FLAG "--seed"
+#define GRAPH_FLAG "--graph"
+#define HUGE_PAGES_FLAG "--huge-pages"
+#define BATCH_FLAG "--batch"
+#define GENERATED_FILE "benchgraph_generated.tsv"
+#define P50 0.50
+#define P99 0.99
+#define USAGE \
+    "Usage: ./benchgraph [--actors n] [--movies n] [--queries n] " \
+    "[--predictions n] [--runs n] [--seed n] [--graph movie_cast.tsv] " \
+    "[--huge-pages 0|1] [--batch searches]\n"
+
+using namespace std;
+
+// Defines the latencies of one scenario
+struct Scenario {
+    // Name printed in the report
+    const char* name;
+
+    // Unit of work counted by the throughput, such as rows or queries
+    const char* unit;
+
+    // Units of work done by each run
+    double unitsPerRun;
+
+    // Latency of each run in milliseconds
+    vector<double> latencies;
+
+    // Whether the dTLB misses of the runs were counted
+    bool tlbCounted;
+
+    // dTLB misses of every run together
+    long tlbMisses;
+};
+
+/**
+ * Opens a counter of the dTLB load misses of this thread, stopped and zeroed.
+ * Returns -1 if the counter is not available, such as in a container or
+ * outside of Linux
+ */
+static int openTlbCounter() {
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+/**
+ * Zeroes and starts a counter
+ *
+ * counter: counter returned by openTlbCounter
+ */
+static void startCounter(int counter) {
+#ifdef __linux__
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/**
+ * Stops a counter and adds its count to a scenario
+ *
+ * counter: counter returned by openTlbCounter
+ * scenario: scenario the count is added to
+ */
+static void stopCounter(int counter, Scenario& scenario) {
+#ifdef __linux__
+    long long misses = 0;
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) == sizeof(misses)) {
+            scenario.tlbCounted = true;
+            scenario.tlbMisses += misses;
+        }
+    }
+#endif
+}
+
+/**
+ * Returns the milliseconds elapsed since a time point
+ *
+ * start: time point to measure from
+ */
+static double millisSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+        .count();
+}
+
+/**
+ * Returns a latency percentile using the nearest rank
+ *
+ * sorted: latencies in increasing order
+ * percentile: percentile between 0 and 1
+ */
+static double percentile(const vector<double>& sorted, double percentile) {
+    size_t rank = (size_t)ceil(percentile * sorted.size());
+    return sorted[max(rank, (size_t)1) - 1];
+}
+
+/**
+ * Prints one line of the report
+ *
+ * scenario: scenario to be printed
+ */
+static void report(Scenario& scenario) {
+    vector<double>& latencies = scenario.latencies;
+    sort(latencies.begin(), latencies.end());
+
+    double totalMillis = 0;
+    for (double latency : latencies) {
+        totalMillis += latency;
+    }
+
+    double throughput =
+        scenario.unitsPerRun * latencies.size() / (totalMillis / 1000.0);
+
+    // Scenarios without a count show a dash
+    char misses[32] = "-";
+    if (scenario.tlbCounted) {
+        snprintf(misses, sizeof(misses), "%ld", scenario.tlbMisses);
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line),
+             "%-14s %6zu %14.1f %-8s %10.3f %10.3f %14s\n", scenario.name,
+             latencies.size(), throughput, scenario.unit,
+             percentile(latencies, P50), percentile(latencies, P99), misses);
+    cout << line;
+}
+
+/**
+ * Returns the number of rows in a tab-delimited file, without its header
+ *
+ * filename: file to be counted
+ */
+static long countRows(const char* filename) {
+    ifstream infile(filename);
+    long rows = 0;
+    string line;
+    while (getline(infile, line)) {
+        rows++;
+    }
+    return max(rows - 1, 0L);
+}
+
+/**
+ * Times a batch of path queries between random pairs of actors
+ *
+ * actorGraph: graph of actor and movie nodes
+ * weighted: if true, use weighted paths
+ * queries: number of pairs searched
+ * seed: seed the pairs are drawn with
+ * scenario: scenario the latencies are added to
+ */
+static void benchPaths(ActorGraph& actorGraph, bool weighted, int queries,
+                       uint64_t seed, Scenario& scenario) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    PathFinder pathFinder(actorGraph);
+    mt19937_64 rng(seed);
+    string path;
+
+    for (int i = 0; i < queries; i++) {
+        ActorNode* first = actors[rng() % actors.size()];
+        ActorNode* final = actors[rng() % actors.size()];
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        path.clear();
+        if (pathFinder.shortestPath(first, final, weighted) != nullptr) {
+            pathFinder.appendPath(path, final, first);
+        }
+        scenario.latencies.push_back(millisSince(start));
+    }
+}
+
+/**
+ * Times the same path queries as benchPaths searched together by the batch
+ * engine, the whole batch being one run
+ *
+ * actorGraph: graph of actor and movie nodes
+ * weighted: if true, use weighted paths
+ * queries: number of pairs searched
+ * width: number of searches in flight at once
+ * seed: seed the pairs are drawn with
+ * scenario: scenario the latency is added to
+ */
+static void benchBatchPaths(ActorGraph& actorGraph, bool weighted, int queries,
+                            int width, uint64_t seed, Scenario& scenario) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    BatchPathFinder batchPathFinder(actorGraph, width);
+    mt19937_64 rng(seed);
+
+    vector<PathQuery> batch;
+    for (int i = 0; i < queries; i++) {
+        ActorNode* first = actors[rng() % actors.size()];
+        ActorNode* final = actors[rng() % actors.size()];
+        batch.push_back(PathQuery{first, final, ""});
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    batchPathFinder.shortestPaths(batch, weighted);
+    scenario.latencies.push_back(millisSince(start));
+}
+
+/**
+ * Times a batch of collaborated and uncollaborated predictions for random
+ * actors, each actor's pair of queries being timed together
+ *
+ * actorGraph: graph of actor and movie nodes
+ * queries: number of actors predicted for
+ * seed: seed the actors are drawn with
+ * scenario: scenario the latencies are added to
+ */
+static void benchPredictions(ActorGraph& actorGraph, int queries,
+                             uint64_t seed, Scenario& scenario) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    LinkPredictor linkPredictor(actorGraph);
+    mt19937_64 rng(seed);
+    vector<ActorNode*> predictions;
+
+    for (int i = 0; i < queries; i++) {
+        ActorNode* query = actors[rng() % actors.size()];
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        predictions.clear();
+        linkPredictor.collaboratedActors(query, predictions);
+        predictions.clear();
+        linkPredictor.uncollaboratedActors(query, predictions);
+        scenario.latencies.push_back(millisSince(start));
+    }
+}
+
+/**
+ * Main function that generates the graph, runs every scenario and prints the
+ * report
+ *
+ * argc: number of command line args
+ * argv: array containing command line args
+ */
+int main(int argc, char* argv[]) {
+    // Default sizes keep a run under a minute on one core. Predictions grow
+    // much faster than paths with the graph, so fewer of them are timed
+    GraphShape shape(5000, 2500);
+    int queries = 200;
+    int predictions = 5;
+    int runs = 3;
+    const char* graphFilename = nullptr;
+    bool hugePages = false;
+    int width = BATCH_WIDTH;
+
+    // Parse the optional flags
+    for (int i = 1; i < argc; i += ARG_TWO) {
+        if (i + 1 == argc) {
+            cerr << USAGE;
+            return 1;
+        }
+
+        if (strcmp(argv[i], ACTORS_FLAG) == 0) {
+            shape.actors = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], MOVIES_FLAG) == 0) {
+            shape.movies = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], QUERIES_FLAG) == 0) {
+            queries = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], PREDICTIONS_FLAG) == 0) {
+            predictions = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], RUNS_FLAG) == 0) {
+            runs = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], SEED_FLAG) == 0) {
+            shape.seed = strtoull(argv[i + 1], nullptr, 10);
+        } else if (strcmp(argv[i], GRAPH_FLAG) == 0) {
+            graphFilename = argv[i + 1];
+        } else if (strcmp(argv[i], HUGE_PAGES_FLAG) == 0) {
+            hugePages = atoi(argv[i + 1]) != 0;
+        } else if (strcmp(argv[i], BATCH_FLAG) == 0) {
+            width = atoi(argv[i + 1]);
+        } else {
+            cerr << USAGE;
+            return 1;
+        }
+    }
+
+    if (shape.actors <= 0 || shape.movies <= 0 || queries <= 0 ||
+        predictions <= 0 || runs <= 0 || width <= 0) {
+        cerr << USAGE;
+        return 1;
+    }
+
+    // Generate a graph unless one was given
+    if (graphFilename == nullptr) {
+        graphFilename = GENERATED_FILE;
+        if (!generateGraph(shape, graphFilename)) {
+            return 1;
+        }
+    }
+
+    long rows = countRows(graphFilename);
+    cout << "graph " << graphFilename << ": " << rows << " rows" << endl;
+
+    Scenario load = {"load", "rows/s", (double)rows, {}, false, 0};
+    Scenario unweighted = {"path-u", "paths/s", 1, {}, false, 0};
+    Scenario weighted = {"path-w", "paths/s", 1, {}, false, 0};
+    Scenario batched = {"path-u-batch", "paths/s", (double)queries, {}, false,
+                        0};
+    Scenario predict = {"predict", "actors/s", 1, {}, false, 0};
+    Scenario mst = {"mst", "trees/s", 1, {}, false, 0};
+    Scenario unweightedHuge = {"path-u-huge", "paths/s", 1, {}, false, 0};
+    Scenario predictHuge = {"predict-huge", "actors/s", 1, {}, false, 0};
+
+    // Time each load, and keep the last graph of each kind for the queries
+    ActorGraph unweightedGraph;
+    ActorGraph weightedGraph;
+    for (int run = 0; run < runs; run++) {
+        unweightedGraph.deleteGraph();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (!unweightedGraph.loadFromFile(unweightedGraph, graphFilename,
+                                          false)) {
+            return 1;
+        }
+        load.latencies.push_back(millisSince(start));
+    }
+    weightedGraph.loadFromFile(weightedGraph, graphFilename, true);
+
+    if (unweightedGraph.getNodeCount(unweightedGraph) == 0) {
+        cerr << "Graph " << graphFilename << " has no actors" << endl;
+        return 1;
+    }
+
+    // Count the dTLB misses of the queries that reach the graph at random
+    int tlbCounter = openTlbCounter();
+    startCounter(tlbCounter);
+    benchPaths(unweightedGraph, false, queries, shape.seed, unweighted);
+    stopCounter(tlbCounter, unweighted);
+    benchPaths(weightedGraph, true, queries, shape.seed, weighted);
+    startCounter(tlbCounter);
+    benchBatchPaths(unweightedGraph, false, queries, width, shape.seed,
+                    batched);
+    stopCounter(tlbCounter, batched);
+    startCounter(tlbCounter);
+    benchPredictions(unweightedGraph, predictions, shape.seed, predict);
+    stopCounter(tlbCounter, predict);
+
+    // Run the same queries on the graph kept in huge pages
+    if (hugePages) {
+        ActorGraph hugeGraph;
+        hugeGraph.setHugePages(hugeGraph, true);
+        if (!hugeGraph.loadFromFile(hugeGraph, graphFilename, false)) {
+            return 1;
+        }
+        startCounter(tlbCounter);
+        benchPaths(hugeGraph, false, queries, shape.seed, unweightedHuge);
+        stopCounter(tlbCounter, unweightedHuge);
+        startCounter(tlbCounter);
+        benchPredictions(hugeGraph, predictions, shape.seed, predictHuge);
+        stopCounter(tlbCounter, predictHuge);
+    }
+
+    for (int run = 0; run < runs; run++) {
+        SpanningTree tree;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        movieTraveler(weightedGraph, tree);
+        mst.latencies.push_back(millisSince(start));
+    }
+
+    char header[256];
+    snprintf(header, sizeof(header),
+             "%-14s %6s %14s %-8s %10s %10s %14s\n", "scenario", "runs",
+             "throughput", "", "p50(ms)", "p99(ms)", "dtlb-misses");
+    cout << header;
+    report(load);
+    report(unweighted);
+    report(weighted);
+    report(batched);
+    report(predict);
+    report(mst);
+    if (hugePages) {
+        report(unweightedHuge);
+        report(predictHuge);
+    }
+
+#ifdef __linux__
+    if (tlbCounter >= 0) {
+        close(tlbCounter);
+    }
+#endif
+
+    // Remove the generated graph
+    if (strcmp(graphFilename, GENERATED_FILE) == 0) {
+        remove(GENERATED_FILE);
+    }
+
+    return 0;
+}
@@ -7,6 +7,11 @@
  */
 
 #include "ActorGraph.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -17,8 +22,9 @@
 #define TAB_CHAR '\t'
 #define COLUMNS 3
 #define ARG_TWO 2
-#define CURR_YEAR 2019
 #define READ_FAILURE "Failed to read "
+#define WRITE_FAILURE "Failed to write "
+#define SNAPSHOT_HEADER "Actor/Actress\tMovie\tYear"
 #define FAILURE_PUNCT "!\n"
 
 using namespace std;
@@ -26,7 +32,15 @@ using namespace std;
 /**
  * Constructor of the Actor graph
  */
-ActorGraph::ActorGraph(void) {}
+ActorGraph::ActorGraph(void)
+    : nodeCount(0),
+      weightedEdges(false),
+      heavyCast(HEAVY_CAST),
+      heavyCount(0),
+      duplicateCount(0),
+      malformedCount(0),
+      recordLinks(false),
+      linkCount(0) {}
 
 /**
  * Return the actorNode given the actor name
@@ -34,22 +48,42 @@ ActorGraph::ActorGraph(void) {}
  * actorGraph: graph of actor and movie nodes
  * actorName: actorNode to be returned
  */
-ActorNode* ActorGraph::get(ActorGraph& actorGraph, string actorName) {
-    // Iterator to search map for actor name
-    unordered_map<string, ActorNode*>::const_iterator actorItr =
-        actorMap.find(actorName);
-
-    // Return actorNode that corresponds to the actor name
-    if (actorItr != actorMap.end()) {
-        return actorMap.at(actorName);
-    }
+ActorNode* ActorGraph::get(const ActorGraph& actorGraph,
+                           const string& actorName) const {
+    return get(actorGraph, NameKey(actorName));
+}
+
+/**
+ * Return the actorNode given a view of the actor name, without building a
+ * string for it
+ *
+ * actorGraph: graph of actor and movie nodes
+ * actorName: actorNode to be returned
+ */
+ActorNode* ActorGraph::get(const ActorGraph& actorGraph,
+                           NameKey actorName) const {
+    // Return nullptr if not found
+    return actorMap.find(HashNameKey()(actorName), actorName.data,
+                         actorName.size,
+                         [](const ActorNode*) { return true; });
+}
 
+/**
+ * Return the movieNode given a view of its title and its year
+ *
+ * actorGraph: graph of actor and movie nodes
+ * movie: title and year of the movieNode to be returned
+ */
+MovieNode* ActorGraph::getMovie(const ActorGraph& actorGraph,
+                                MovieKey movie) const {
     // Return nullptr if not found
-    return nullptr;
+    return movieMap.find(
+        HashMovieKey()(movie), movie.title.data, movie.title.size,
+        [&](const MovieNode* node) { return node->year == movie.year; });
 }
 
 /**
- * Returns the vector of edges in the graph
+ * Returns a copy of the vector of edges in the graph. Prefer getMovies
  *
  * actorGraph: graph of actor and movie nodes
  */
@@ -58,220 +92,577 @@ vector<MovieNode*> ActorGraph::getEdgeVect(ActorGraph& actorGraph) {
 }
 
 /**
- * Returns the disjoint set map of the index mapping to a pair of the
- * disjoint set value and the actor node
+ * Builds the disjoint set map of the index mapping to a pair of the
+ * disjoint set value and the actor node. Prefer getActors
  *
  * actorGraph: graph of actor and movie nodes
  */
 unordered_map<int, pair<int, ActorNode*>> ActorGraph::getDSM(
     ActorGraph& actorGraph) {
+    unordered_map<int, pair<int, ActorNode*>> disjointSetMap;
+    for (ActorNode* actorNode : actorVect) {
+        disjointSetMap[actorNode->index] = make_pair(-1, actorNode);
+    }
     return disjointSetMap;
 }
 
 /**
- * Returns the index map mapping an actor node to an index
+ * Builds the index map mapping an actor node to an index. Prefer the node's
+ * own index
  *
  * actorGraph: graph of actor and movie nodes
  */
 unordered_map<ActorNode*, int> ActorGraph::getIndexMap(ActorGraph& actorGraph) {
+    unordered_map<ActorNode*, int> indexMap;
+    for (ActorNode* actorNode : actorVect) {
+        indexMap[actorNode] = actorNode->index;
+    }
     return indexMap;
 }
 
+/**
+ * Returns the bytes an unordered_map of a given size would reserve: a node
+ * holding the next pointer and the element for each element, and a bucket
+ * pointer for each element at the default load factor
+ *
+ * size: number of elements
+ */
+template <typename Map>
+static size_t hashMapBytes(size_t size) {
+    return size * (2 * sizeof(void*) + sizeof(typename Map::value_type));
+}
+
+/**
+ * Appends the bytes reserved by each structure the graph holds, along with
+ * those the maps built on demand would reserve. The vectors and names held by
+ * each node are not included
+ *
+ * actorGraph: graph of actor and movie nodes
+ * structures: vector the structures are appended to
+ */
+void ActorGraph::getStructureBytes(const ActorGraph& actorGraph,
+                                   vector<StructureBytes>& structures) const {
+    size_t idBytes = sizeof(uint32_t);
+    structures.push_back(
+        StructureBytes{"actorArena", actorArena.bytesReserved(), false});
+    structures.push_back(
+        StructureBytes{"movieArena", movieArena.bytesReserved(), false});
+    structures.push_back(
+        StructureBytes{"actorMap", actorMap.bytesReserved(), false});
+    structures.push_back(
+        StructureBytes{"movieMap", movieMap.bytesReserved(), false});
+    structures.push_back(StructureBytes{
+        "edgeVect", edgeVect.capacity() * sizeof(MovieNode*), false});
+    structures.push_back(StructureBytes{
+        "actorVect", actorVect.capacity() * sizeof(ActorNode*), false});
+    structures.push_back(
+        StructureBytes{"movieIds", movieIds.capacity() * idBytes, false});
+    structures.push_back(StructureBytes{
+        "movieIdRuns", movieIdRuns.capacity() * idBytes, false});
+    structures.push_back(
+        StructureBytes{"castIds", castIds.capacity() * idBytes, false});
+    structures.push_back(
+        StructureBytes{"castIdRuns", castIdRuns.capacity() * idBytes, false});
+    structures.push_back(StructureBytes{
+        "appendedLinks",
+        appendedLinks.capacity() * sizeof(pair<ActorNode*, MovieNode*>),
+        false});
+
+    // Built by getDSM and getIndexMap, one element per actor
+    structures.push_back(StructureBytes{
+        "disjointSetMap",
+        hashMapBytes<unordered_map<int, pair<int, ActorNode*>>>(
+            actorVect.size()),
+        true});
+    structures.push_back(StructureBytes{
+        "indexMap",
+        hashMapBytes<unordered_map<ActorNode*, int>>(actorVect.size()), true});
+}
+
 /**
  * Returns the number of nodes within actorGraph
  *
  * actorGraph: graph of actor and movie nodes
  */
-int ActorGraph::getNodeCount(ActorGraph& actorGraph) { return nodeCount; }
+int ActorGraph::getNodeCount(const ActorGraph& actorGraph) const {
+    return nodeCount;
+}
 
 /**
- * Load the graph from a tab-delimited file of actor->movie relationships.
+ * Returns the number of movies within actorGraph
  *
- * in_filename: input filename
- * use_weighted_edges: if true, compute edge weights as 1 + (2019 -
- * movie_year), otherwise all edge weights will be 1
+ * actorGraph: graph of actor and movie nodes
  */
-bool ActorGraph::loadFromFile(ActorGraph& actorGraph, const char* in_filename,
-                              bool use_weighted_edges) {
-    // Initialize the file stream
-    ifstream infile(in_filename);
+int ActorGraph::getMovieCount(const ActorGraph& actorGraph) const {
+    return edgeVect.size();
+}
 
-    // Skips header
-    bool have_header = false;
+/**
+ * Sets the number of actors above which a movie's cast is heavy, and
+ * classifies every movie again. Movies are classified as they are loaded, so
+ * this is only needed to change the default of HEAVY_CAST
+ *
+ * actorGraph: graph of actor and movie nodes
+ * heavyCast: number of actors above which a cast is heavy
+ */
+void ActorGraph::setHeavyCast(ActorGraph& actorGraph, size_t heavyCast) {
+    this->heavyCast = heavyCast;
+    heavyCount = 0;
+    for (MovieNode* movieNode : edgeVect) {
+        movieNode->heavy = movieNode->actorVect.size() > heavyCast;
+        heavyCount += movieNode->heavy;
+    }
+}
 
-    int mapCounter = 0;
+/**
+ * Returns the number of movies whose cast is heavy
+ *
+ * actorGraph: graph of actor and movie nodes
+ */
+int ActorGraph::getHeavyCount(const ActorGraph& actorGraph) const {
+    return heavyCount;
+}
 
-    // keep reading lines until the end of file is reached
-    while (infile) {
-        string s;
+/**
+ * Returns the number of rows dropped by every load so far because their actor
+ * was already linked to their movie
+ *
+ * actorGraph: graph of actor and movie nodes
+ */
+long ActorGraph::getDuplicateCount(const ActorGraph& actorGraph) const {
+    return duplicateCount;
+}
 
-        // get the next line
-        if (!getline(infile, s)) break;
+/**
+ * Returns the number of rows dropped by every load so far because their year
+ * was not a number
+ *
+ * actorGraph: graph of actor and movie nodes
+ */
+long ActorGraph::getMalformedCount(const ActorGraph& actorGraph) const {
+    return malformedCount;
+}
 
-        if (!have_header) {
-            // skip the header
-            have_header = true;
-            continue;
-        }
+/**
+ * Sets whether the nodes and sorted index runs are kept in huge pages, which
+ * lets searches that reach them at random miss the TLB less often. Only an
+ * empty graph can change, so this is called before loading, and false is
+ * returned for a graph that is not empty
+ *
+ * actorGraph: graph of actor and movie nodes
+ * enabled: if true, keep the graph in huge pages
+ */
+bool ActorGraph::setHugePages(ActorGraph& actorGraph, bool enabled) {
+    if (actorArena.size() > 0 || movieArena.size() > 0) {
+        return false;
+    }
 
-        istringstream ss(s);
-        vector<string> record;
+    actorArena.setHugePages(enabled);
+    movieArena.setHugePages(enabled);
 
-        while (ss) {
-            string str;
+    // The runs take the allocator of the vectors they are assigned
+    HugePageAllocator<uint32_t> allocator(enabled);
+    movieIds = IdVector(allocator);
+    movieIdRuns = IdVector(allocator);
+    castIds = IdVector(allocator);
+    castIdRuns = IdVector(allocator);
+    return true;
+}
 
-            // get the next string before hitting a tab character and put it in
-            // 'str'
-            if (!getline(ss, str, TAB_CHAR)) break;
-            record.push_back(str);
-        }
+/**
+ * Returns whether the nodes and sorted index runs are kept in huge pages
+ *
+ * actorGraph: graph of actor and movie nodes
+ */
+bool ActorGraph::usesHugePages(const ActorGraph& actorGraph) const {
+    return actorArena.usesHugePages();
+}
 
-        if (record.size() != COLUMNS) {
-            // we should have exactly 3 columns
-            continue;
+/**
+ * Moves the run of every owner that gained ids to the end of the ids, with
+ * the new ids merged in, so that no other run moves
+ *
+ * ids: index runs of every owner
+ * runs: start and end of each owner's run, two entries per owner
+ * added: owner and new id of each added link, sorted
+ */
+static void extendRuns(IdVector& ids, IdVector& runs,
+                       const vector<pair<uint32_t, uint32_t>>& added) {
+    // Make room first, so that copying a run onto the end cannot move it
+    size_t needed = added.size();
+    for (size_t i = 0; i < added.size(); i++) {
+        if (i == 0 || added[i].first != added[i - 1].first) {
+            uint32_t owner = added[i].first;
+            needed += runs[2 * owner + 1] - runs[2 * owner];
         }
+    }
+    if (ids.size() + needed > ids.capacity()) {
+        ids.reserve(max(ids.size() + needed, 2 * ids.capacity()));
+    }
 
-        string actor(record[0]);
-        string movie_title(record[1]);
-        int year = stoi(record[ARG_TWO]);
+    size_t i = 0;
+    while (i < added.size()) {
+        uint32_t owner = added[i].first;
+        uint32_t start = runs[2 * owner];
+        uint32_t end = runs[2 * owner + 1];
+
+        // A run that is already last grows in place
+        size_t newStart = start;
+        if (end != ids.size()) {
+            newStart = ids.size();
+            for (uint32_t j = start; j < end; j++) {
+                ids.push_back(ids[j]);
+            }
+        }
 
-        bool actorExists = false;
-        bool movieExists = false;
+        size_t middle = ids.size();
+        for (; i < added.size() && added[i].first == owner; i++) {
+            ids.push_back(added[i].second);
+        }
+        inplace_merge(ids.begin() + newStart, ids.begin() + middle,
+                      ids.end());
 
-        pair<string, int> movie = make_pair(movie_title, year);
+        runs[2 * owner] = newStart;
+        runs[2 * owner + 1] = ids.size();
+    }
+}
 
-        unordered_map<string, ActorNode*>::const_iterator actorItr =
-            actorMap.find(actor);
+/**
+ * Copies every run in owner order into an array without the holes left by
+ * runs that moved
+ *
+ * ids: index runs of every owner
+ * runs: start and end of each owner's run, two entries per owner
+ * liveIds: number of ids in the runs
+ */
+static void compactRuns(IdVector& ids, IdVector& runs, size_t liveIds) {
+    IdVector compacted(ids.get_allocator());
+    compacted.reserve(liveIds);
+    for (size_t owner = 0; 2 * owner < runs.size(); owner++) {
+        uint32_t start = runs[2 * owner];
+        uint32_t end = runs[2 * owner + 1];
+        runs[2 * owner] = compacted.size();
+        compacted.insert(compacted.end(), ids.begin() + start,
+                         ids.begin() + end);
+        runs[2 * owner + 1] = compacted.size();
+    }
+    ids.swap(compacted);
+}
 
-        // Check if actor exists in map
-        if (actorItr != actorMap.end()) {
-            actorExists = true;
+/**
+ * Rebuilds the sorted index runs of every actor and movie
+ */
+void ActorGraph::sortAdjacency() {
+    size_t links = 0;
+    movieIdRuns.clear();
+    for (ActorNode* actorNode : actorVect) {
+        movieIdRuns.push_back(links);
+        links += actorNode->movieVect.size();
+        movieIdRuns.push_back(links);
+    }
+    links = 0;
+    castIdRuns.clear();
+    for (MovieNode* movieNode : edgeVect) {
+        castIdRuns.push_back(links);
+        links += movieNode->actorVect.size();
+        castIdRuns.push_back(links);
+    }
+    linkCount = links;
+
+    // Walking the movies in index order drops each one into the runs of its
+    // actors in increasing order, so no run needs sorting. Likewise for the
+    // actors
+    movieIds.resize(links);
+    castIds.resize(links);
+    vector<uint32_t> next(actorVect.size());
+    for (size_t i = 0; i < next.size(); i++) {
+        next[i] = movieIdRuns[2 * i];
+    }
+    for (MovieNode* movieNode : edgeVect) {
+        for (ActorNode* actorNode : movieNode->actorVect) {
+            movieIds[next[actorNode->index]++] = movieNode->index;
         }
-
-        // Check if movie with year exists in map
-        if (movieMap.find(movie) != movieMap.end()) {
-            movieExists = true;
+    }
+    next.resize(edgeVect.size());
+    for (size_t i = 0; i < next.size(); i++) {
+        next[i] = castIdRuns[2 * i];
+    }
+    for (ActorNode* actorNode : actorVect) {
+        for (MovieNode* movieNode : actorNode->movieVect) {
+            castIds[next[movieNode->index]++] = actorNode->index;
         }
+    }
+}
 
-        // Link actor and movie if both exists
-        if (actorExists && movieExists) {
-            // Find actor and movie nodes
-            ActorNode* actorNode = actorMap.at(actor);
-            MovieNode* movieNode = movieMap.at(movie);
+/**
+ * Adds the links of the last append to the sorted index runs. Only the runs
+ * of the actors and movies they touch are moved
+ */
+void ActorGraph::extendAdjacency() {
+    // Actors and movies added by the append start with empty runs
+    movieIdRuns.resize(2 * actorVect.size(), 0);
+    castIdRuns.resize(2 * edgeVect.size(), 0);
+
+    // Group the new ids by the run they join
+    vector<pair<uint32_t, uint32_t>> added;
+    added.reserve(appendedLinks.size());
+    for (const pair<ActorNode*, MovieNode*>& link : appendedLinks) {
+        added.push_back(make_pair(link.first->index, link.second->index));
+    }
+    sort(added.begin(), added.end());
+    extendRuns(movieIds, movieIdRuns, added);
 
-            // Link the two together
-            actorNode->movieVect.push_back(movieNode);
-            movieNode->actorVect.push_back(actorNode);
-        }
+    added.clear();
+    for (const pair<ActorNode*, MovieNode*>& link : appendedLinks) {
+        added.push_back(make_pair(link.second->index, link.first->index));
+    }
+    sort(added.begin(), added.end());
+    extendRuns(castIds, castIdRuns, added);
+    linkCount += appendedLinks.size();
+
+    // Compact once the holes outnumber the ids in use. Runs only move as far
+    // as the ids copied to move them, so this stays linear in them overall
+    if (movieIds.size() > 2 * linkCount) {
+        compactRuns(movieIds, movieIdRuns, linkCount);
+    }
+    if (castIds.size() > 2 * linkCount) {
+        compactRuns(castIds, castIdRuns, linkCount);
+    }
+}
 
-        // Create movie node and link together
-        if (actorExists && !movieExists) {
-            // Find actor node
-            ActorNode* actorNode = actorMap.at(actor);
+/**
+ * Links an actor to a movie, creating either node if it does not exist
+ *
+ * actor: name of the actor
+ * movieTitle: title of the movie
+ * year: year of the movie
+ * use_weighted_edges: if true, weight a new movie by its age
+ */
+void ActorGraph::addLink(NameKey actor, NameKey movieTitle, int year,
+                         bool use_weighted_edges) {
+    // Check if actor exists in map
+    ActorNode* actorNode = get(*this, actor);
+
+    // Check if movie with year exists in map
+    MovieNode* movieNode = getMovie(*this, MovieKey(movieTitle, year));
+
+    // Create movie node in the arena if it does not exist yet
+    if (movieNode == nullptr) {
+        movieNode = movieArena.create(
+            string(movieTitle.data, movieTitle.size), year);
+
+        // If using weighted edges, edge is how old the movie is, otherwise
+        // edge is 1
+        if (use_weighted_edges) {
+            movieNode->edgeWeight = 1 + (CURR_YEAR - year);
+        }
 
-            // Add actor node to actor vector
-            vector<ActorNode*> actorVect;
+        // The movie's index is its position in the edge vector
+        movieNode->index = edgeVect.size();
+        edgeVect.push_back(movieNode);
 
-            // Create new movie node with movie, year, and vector containing the
-            // actor
-            MovieNode* movieNode = new MovieNode(movie_title, year, actorVect);
+        // Index the movie on the title stored in the node itself
+        movieMap.insert(HashMovieNode()(movieNode), movieNode);
+    }
 
-            // Link them together
-            movieNode->actorVect.push_back(actorNode);
-            actorNode->movieVect.push_back(movieNode);
+    // Create actor node in the arena if it does not exist yet
+    if (actorNode == nullptr) {
+        actorNode = actorArena.create(string(actor.data, actor.size));
 
-            // If using weighted edges, edge is how old the movie is, otherwise
-            // edge is 1
-            if (use_weighted_edges) {
-                movieNode->edgeWeight = 1 + (CURR_YEAR - year);
-            }
+        // The actor's index is its position in the actor vector
+        actorNode->index = nodeCount;
+        actorVect.push_back(actorNode);
 
-            edgeVect.push_back(movieNode);
+        // One more actor node added to graph
+        nodeCount++;
 
-            // Insert movie into movie map
-            // movieMap.insert(make_pair(movie, movieNode));
-            movieMap[movie] = movieNode;
-        }
+        // Index the actor on the name stored in the node itself
+        actorMap.insert(HashActorNode()(actorNode), actorNode);
+    }
 
-        // Create actor node and link together
-        if (!actorExists && movieExists) {
-            // Find movie node
-            MovieNode* movieNode = movieMap.at(movie);
+    // Drop the row if the two are already linked. Only nodes that both
+    // existed can be, and the shorter of their vectors is searched
+    if (actorNode->movieVect.size() < movieNode->actorVect.size()
+            ? find(actorNode->movieVect.begin(), actorNode->movieVect.end(),
+                   movieNode) != actorNode->movieVect.end()
+            : find(movieNode->actorVect.begin(), movieNode->actorVect.end(),
+                   actorNode) != movieNode->actorVect.end()) {
+        duplicateCount++;
+        return;
+    }
 
-            // Add movie node to movie vector
-            vector<MovieNode*> movieVect;
+    // Link the two together
+    actorNode->movieVect.push_back(movieNode);
+    movieNode->actorVect.push_back(actorNode);
+    if (recordLinks) {
+        appendedLinks.push_back(make_pair(actorNode, movieNode));
+    }
 
-            // Create new actor node with actor and vector containing the movie
-            ActorNode* actorNode = new ActorNode(actor, movieVect);
+    // A cast only grows, so it becomes heavy at most once
+    if (!movieNode->heavy && movieNode->actorVect.size() > heavyCast) {
+        movieNode->heavy = true;
+        heavyCount++;
+    }
 
-            // Link them together
-            movieNode->actorVect.push_back(actorNode);
-            actorNode->movieVect.push_back(movieNode);
+    // Keep the actor's movies sorted by year, after any of the same year,
+    // along with their positions in movieVect
+    vector<MovieNode*>& byYear = actorNode->moviesByYear;
+    size_t at = upper_bound(byYear.begin(), byYear.end(), year,
+                            [](int year, const MovieNode* movie) {
+                                return year < movie->year;
+                            }) -
+                byYear.begin();
+    byYear.insert(byYear.begin() + at, movieNode);
+    actorNode->yearPositions.insert(actorNode->yearPositions.begin() + at,
+                                    actorNode->movieVect.size() - 1);
+}
 
-            // Add actor node and its initial sentinel value of -1 to a hashmap
-            disjointSetMap[mapCounter] = make_pair(-1, actorNode);
+/**
+ * Load the graph from a tab-delimited file of actor->movie relationships.
+ * A row repeating a link already loaded is dropped and counted, so every actor
+ * and movie is linked at most once, and the sorted index runs are rebuilt at
+ * the end.
+ *
+ * in_filename: input filename
+ * use_weighted_edges: if true, compute edge weights as 1 + (2019 -
+ * movie_year), otherwise all edge weights will be 1
+ */
+bool ActorGraph::loadFromFile(ActorGraph& actorGraph, const char* in_filename,
+                              bool use_weighted_edges) {
+    // Initialize the file stream
+    ifstream infile(in_filename);
 
-            // Set the actor node's value to an index in disjointSetMap
-            indexMap[actorNode] = mapCounter;
+    // Remember the weighting so that deltas are weighted the same way
+    weightedEdges = use_weighted_edges;
 
-            // One more actor node added to graph
-            nodeCount++;
+    // Skips header
+    bool have_header = false;
 
-            // Increment indexMap's index
-            mapCounter++;
+    // Line buffer reused for every record
+    string s;
 
-            // Insert actor into actor map
-            // actorMap.insert(make_pair(actor, actorNode));
-            actorMap[actor] = actorNode;
-        }
+    // Offsets of the tab characters within a record
+    size_t tabs[COLUMNS];
 
-        // Create actor and movie nodes to link together
-        if (!actorExists && !movieExists) {
-            // Create empty movie vector and actor vector
-            vector<MovieNode*> movieVect;
-            vector<ActorNode*> actorVect;
+    // keep reading lines until the end of file is reached
+    while (infile) {
+        // get the next line
+        if (!getline(infile, s)) break;
 
-            // Create new actor node with actor and empty vector
-            ActorNode* actorNode = new ActorNode(actor, movieVect);
+        if (!have_header) {
+            // skip the header
+            have_header = true;
+            continue;
+        }
 
-            // Create new movie node with movie, year, and empty vector
-            MovieNode* movieNode = new MovieNode(movie_title, year, actorVect);
+        // Find the tab characters in place instead of copying every column
+        size_t columns = s.empty() ? 0 : 1;
+        for (size_t pos = s.find(TAB_CHAR); pos != string::npos;
+             pos = s.find(TAB_CHAR, pos + 1)) {
+            // A trailing tab does not start another column
+            if (pos + 1 == s.size()) break;
+            if (columns < COLUMNS) tabs[columns] = pos;
+            columns++;
+        }
 
-            // Link together
-            actorNode->movieVect.push_back(movieNode);
-            movieNode->actorVect.push_back(actorNode);
+        if (columns != COLUMNS) {
+            // we should have exactly 3 columns
+            continue;
+        }
 
-            // If using weighted edges, edge is how old the movie is, otherwise
-            // edge is 1
-            if (use_weighted_edges) {
-                movieNode->edgeWeight = 1 + (CURR_YEAR - year);
-            }
+        NameKey actor(s.data(), tabs[1]);
+        NameKey movie_title(s.data() + tabs[1] + 1,
+                            tabs[ARG_TWO] - tabs[1] - 1);
+
+        // The year must be a whole number, optionally followed by spaces
+        const char* yearStart = s.c_str() + tabs[ARG_TWO] + 1;
+        char* yearEnd;
+        errno = 0;
+        long year = strtol(yearStart, &yearEnd, 10);
+        while (isspace((unsigned char)*yearEnd)) yearEnd++;
+        if (yearEnd == yearStart || *yearEnd != '\0' || errno == ERANGE ||
+            year < INT_MIN || year > INT_MAX) {
+            malformedCount++;
+            continue;
+        }
 
-            edgeVect.push_back(movieNode);
+        addLink(actor, movie_title, year, use_weighted_edges);
+    }
 
-            // Add actor node and its initial sentinel value of -1 to a hashmap
-            disjointSetMap[mapCounter] = make_pair(-1, actorNode);
+    // Keep the sorted runs in step with the links, even after a failed read
+    if (recordLinks) {
+        extendAdjacency();
+    } else {
+        sortAdjacency();
+    }
 
-            // Set the actor node's value to an index in disjointSetMap
-            indexMap[actorNode] = mapCounter;
+    if (!infile.eof()) {
+        cerr << READ_FAILURE << in_filename << FAILURE_PUNCT;
+        return false;
+    }
+    infile.close();
 
-            // Increment indexMap's index
-            mapCounter++;
+    return true;
+}
 
-            // One more actor node added to graph
-            nodeCount++;
+/**
+ * Add the rows of a tab-delimited delta file to an already loaded graph.
+ * New actors and movies are created, new links are added to existing nodes,
+ * and movies are weighted the same way as in loadFromFile. Only the rows of
+ * the delta are read, and only the sorted index runs of the actors and movies
+ * it touches are moved, so the cost does not depend on the size of the graph.
+ *
+ * actorGraph: graph of actor and movie nodes
+ * in_filename: delta filename, with a header line like loadFromFile
+ */
+bool ActorGraph::appendFromFile(ActorGraph& actorGraph,
+                                const char* in_filename) {
+    // addLink already extends the indexes, edgeVect, and actorVect, and
+    // records the links it adds
+    appendedLinks.clear();
+    recordLinks = true;
+    bool loaded = loadFromFile(actorGraph, in_filename, weightedEdges);
+    recordLinks = false;
+    return loaded;
+}
 
-            // Insert actor into actor map, and movie into movie map
-            actorMap[actor] = actorNode;
-            movieMap[movie] = movieNode;
+/**
+ * Write the graph as a tab-delimited file that loadFromFile can read back.
+ * Actors are written in the order they were added, each with its movies in
+ * order, so a reloaded graph keeps every actor's index.
+ *
+ * actorGraph: graph of actor and movie nodes
+ * out_filename: snapshot filename
+ */
+bool ActorGraph::saveToFile(ActorGraph& actorGraph, const char* out_filename) {
+    ofstream outfile(out_filename);
+
+    outfile << SNAPSHOT_HEADER << '\n';
+
+    // Record buffer reused for every row
+    string row;
+
+    // Write every link of every actor in index order
+    for (int index = 0; index < nodeCount; index++) {
+        ActorNode* actorNode = actorVect[index];
+
+        for (MovieNode* movieNode : actorNode->movieVect) {
+            row.assign(actorNode->actorName);
+            row += TAB_CHAR;
+            row += movieNode->movieName;
+            row += TAB_CHAR;
+            row += to_string(movieNode->year);
+            row += '\n';
+            outfile.write(row.data(), row.size());
         }
     }
 
-    if (!infile.eof()) {
-        cerr << READ_FAILURE << in_filename << FAILURE_PUNCT;
+    outfile.close();
+
+    if (!outfile) {
+        cerr << WRITE_FAILURE << out_filename << FAILURE_PUNCT;
         return false;
     }
-    infile.close();
 
     return true;
 }
@@ -280,18 +671,28 @@ bool ActorGraph::loadFromFile(ActorGraph& actorGraph, const char* in_filename,
  * Helper function to delete Actor graph
  */
 void ActorGraph::deleteGraph() {
-    // For every entry in actorMap, delete its actorNode
-    for (auto entry : actorMap) {
-        delete entry.second;
-    }
-
-    // For every entry in movieMap, delete its movieNode
-    for (auto entry : movieMap) {
-        delete entry.second;
-    }
+    // Drop the maps first since their keys point into the nodes
+    actorMap.clear();
+    movieMap.clear();
+    edgeVect.clear();
+    actorVect.clear();
+    nodeCount = 0;
+    heavyCount = 0;
+    duplicateCount = 0;
+    malformedCount = 0;
+    appendedLinks.clear();
+    movieIds.clear();
+    movieIdRuns.clear();
+    castIds.clear();
+    castIdRuns.clear();
+    linkCount = 0;
+
+    // Release every node at once
+    actorArena.release();
+    movieArena.release();
 }
 
 /**
  * Destructor of the Actor graph
  */
-ActorGraph::~ActorGraph() { deleteGraph(); }
\ No newline at end of file
+ActorGraph::~ActorGraph() { deleteGraph(); }
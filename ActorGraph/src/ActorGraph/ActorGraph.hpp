@@ -10,24 +10,154 @@
 #ifndef ACTORGRAPH_HPP
 #define ACTORGRAPH_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <queue>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "FlatIndex.hpp"
+#include "HugePages.hpp"
+#include "NodeArena.hpp"
+
 using namespace std;
 
-class ActorNode;
-class MovieNode;
+// Year that weighted edges measure a movie's age from
+#define CURR_YEAR 2019
+
+// Default number of actors above which a movie's cast is heavy
+#define HEAVY_CAST 100
+
+struct ActorNode;
+struct MovieNode;
+
+// Non-owning view of a name, used to look up nodes without copying the name
+struct NameKey {
+    // First character of the name
+    const char* data;
+
+    // Number of characters in the name
+    size_t size;
+
+    NameKey(const char* data, size_t size) : data(data), size(size) {}
+
+    NameKey(const string& name) : data(name.data()), size(name.size()) {}
+
+    bool operator==(const NameKey& other) const {
+        return size == other.size && memcmp(data, other.data, size) == 0;
+    }
+};
+
+// Key of a movie: a view of its title along with its year
+struct MovieKey {
+    NameKey title;
+    int year;
+
+    MovieKey(NameKey title, int year) : title(title), year(year) {}
 
-// Struct that hashes pairs into an unordered map
-struct HashPairs {
-    size_t operator()(const pair<string, int>& pair) const {
-        return hash<string>()(pair.first) ^ hash<int>()(pair.second);
+    bool operator==(const MovieKey& other) const {
+        return year == other.year && title == other.title;
     }
 };
 
+// Read-only range of node pointers that a range-based for loop can iterate.
+// It points into a vector owned by the graph or a node, so it is only valid
+// until that vector next grows
+template <typename Node>
+struct NodeRange {
+    Node* const* first;
+    Node* const* last;
+
+    Node* const* begin() const { return first; }
+    Node* const* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    Node* operator[](size_t i) const { return first[i]; }
+};
+
+// Range of actors, such as every actor of the graph or the cast of a movie
+typedef NodeRange<ActorNode> ActorRange;
+
+// Range of movies, such as every movie of the graph or those of an actor
+typedef NodeRange<MovieNode> MovieRange;
+
+// Read-only range of node indices, sorted in increasing order
+struct IdRange {
+    const uint32_t* first;
+    const uint32_t* last;
+
+    const uint32_t* begin() const { return first; }
+    const uint32_t* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    uint32_t operator[](size_t i) const { return first[i]; }
+};
+
+// Vector of node indices, kept in huge pages when the graph asks for them
+typedef vector<uint32_t, HugePageAllocator<uint32_t>> IdVector;
+
+// Defines the memory used by one structure of a graph
+struct StructureBytes {
+    // Name of the structure
+    string name;
+
+    // Bytes reserved by the structure, not counting the allocator's overhead
+    size_t bytes;
+
+    // Whether the structure is only built when asked for, in which case
+    // bytes is what it would reserve and the graph does not hold it
+    bool onDemand;
+};
+
+/**
+ * Returns a range over the whole of a vector of node pointers
+ *
+ * nodes: vector to be viewed
+ */
+template <typename Node>
+inline NodeRange<Node> rangeOf(const vector<Node*>& nodes) {
+    return NodeRange<Node>{nodes.data(), nodes.data() + nodes.size()};
+}
+
+// Struct that hashes names
+struct HashNameKey {
+    uint64_t operator()(const NameKey& key) const {
+        return hashBytes(key.data, key.size, 0);
+    }
+};
+
+// Struct that hashes movie keys, seeding the title's hash with the year
+struct HashMovieKey {
+    uint64_t operator()(const MovieKey& key) const {
+        return hashBytes(key.title.data, key.title.size,
+                         hashMix((uint64_t)key.year, 0x9e3779b97f4a7c15ULL));
+    }
+};
+
+// Struct that hashes an actor node on its name
+struct HashActorNode {
+    uint64_t operator()(const ActorNode* node) const;
+};
+
+// Struct that hashes a movie node on its title and year
+struct HashMovieNode {
+    uint64_t operator()(const MovieNode* node) const;
+};
+
+// Struct that returns the name an actor node is indexed on
+struct ActorNodeName {
+    const string& operator()(const ActorNode* node) const;
+};
+
+// Struct that returns the title a movie node is indexed on
+struct MovieNodeName {
+    const string& operator()(const MovieNode* node) const;
+};
+
 /**
  * Class that defines the actor graph that contains actor nodes with vectors of
  * movie nodes and movies nodes with vectors of actor nodes connecting each
@@ -35,24 +165,85 @@ struct HashPairs {
  */
 class ActorGraph {
   protected:
-    // Map storing actors and their corresponding actorNode
-    unordered_map<string, ActorNode*> actorMap;
+    // Arena owning every actorNode in the graph
+    NodeArena<ActorNode> actorArena;
 
-    // Map storing movies and their corresponding movieNode
-    unordered_map<pair<string, int>, MovieNode*, HashPairs> movieMap;
+    // Arena owning every movieNode in the graph
+    NodeArena<MovieNode> movieArena;
 
-    // Vector of all movie edges
-    vector<MovieNode*> edgeVect;
+    // Index of actors, keyed on the name held by their actorNode
+    FlatIndex<ActorNode, HashActorNode, ActorNodeName> actorMap;
+
+    // Index of movies, keyed on the title and year held by their movieNode
+    FlatIndex<MovieNode, HashMovieNode, MovieNodeName> movieMap;
 
-    // Map mapping an index to its disjoint set value, and the node itself
-    unordered_map<int, pair<int, ActorNode*>> disjointSetMap;
+    // Vector of all movie edges, indexed by movie index
+    vector<MovieNode*> edgeVect;
 
-    // Map mapping actor node to an index
-    unordered_map<ActorNode*, int> indexMap;
+    // Vector of all actor nodes, indexed by actor index
+    vector<ActorNode*> actorVect;
 
     // Number of nodes in the graph
     int nodeCount;
 
+    // Whether movies are weighted by their age
+    bool weightedEdges;
+
+    // Number of actors above which a movie's cast is heavy
+    size_t heavyCast;
+
+    // Number of movies whose cast is heavy
+    int heavyCount;
+
+    // Number of rows dropped because their actor was already linked to
+    // their movie
+    long duplicateCount;
+
+    // Number of rows dropped because their year was not a number
+    long malformedCount;
+
+    // Links added by the last appendFromFile, in the order they were read
+    vector<pair<ActorNode*, MovieNode*>> appendedLinks;
+
+    // Whether addLink records the links it adds
+    bool recordLinks;
+
+    // Movie indices of every actor, sorted, one run per actor. Actor i's run
+    // is movieIds from movieIdRuns[2 * i] up to movieIdRuns[2 * i + 1]. A run
+    // that an append extends moves to the end, leaving a hole behind
+    IdVector movieIds;
+    IdVector movieIdRuns;
+
+    // Actor indices of every cast, sorted, one run per movie. Movie i's run
+    // is castIds from castIdRuns[2 * i] up to castIdRuns[2 * i + 1]
+    IdVector castIds;
+    IdVector castIdRuns;
+
+    // Number of links, which is the number of ids in use in either array
+    size_t linkCount;
+
+    /**
+     * Rebuilds the sorted index runs of every actor and movie
+     */
+    void sortAdjacency();
+
+    /**
+     * Adds the links of the last append to the sorted index runs. Only the
+     * runs of the actors and movies they touch are moved
+     */
+    void extendAdjacency();
+
+    /**
+     * Links an actor to a movie, creating either node if it does not exist
+     *
+     * actor: name of the actor
+     * movieTitle: title of the movie
+     * year: year of the movie
+     * use_weighted_edges: if true, weight a new movie by its age
+     */
+    void addLink(NameKey actor, NameKey movieTitle, int year,
+                 bool use_weighted_edges);
+
   public:
     /**
      * Constuctor of the Actor graph
@@ -75,39 +266,181 @@ class ActorGraph {
      * actorGraph: graph of actor and movie nodes
      * actorName: actorNode to be returned
      */
-    ActorNode* get(ActorGraph& actorGraph, string actorName);
+    ActorNode* get(const ActorGraph& actorGraph,
+                   const string& actorName) const;
+
+    /**
+     * Return the actorNode given a view of the actor name, without building a
+     * string for it
+     *
+     * actorGraph: graph of actor and movie nodes
+     * actorName: actorNode to be returned
+     */
+    ActorNode* get(const ActorGraph& actorGraph, NameKey actorName) const;
+
+    /**
+     * Return the movieNode given a view of its title and its year
+     *
+     * actorGraph: graph of actor and movie nodes
+     * movie: title and year of the movieNode to be returned
+     */
+    MovieNode* getMovie(const ActorGraph& actorGraph, MovieKey movie) const;
 
     /**
-     * Returns the vector of edges in the graph
+     * Returns a view of every actor, indexed by actor index, without copying
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    ActorRange getActors(const ActorGraph& actorGraph) const {
+        return rangeOf(actorVect);
+    }
+
+    /**
+     * Returns a view of every movie edge, indexed by movie index, without
+     * copying
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    MovieRange getMovies(const ActorGraph& actorGraph) const {
+        return rangeOf(edgeVect);
+    }
+
+    /**
+     * Returns a copy of the vector of edges in the graph. Prefer getMovies
      *
      * actorGraph: graph of actor and movie nodes
      */
     vector<MovieNode*> getEdgeVect(ActorGraph& actorGraph);
 
     /**
-     * Returns the disjoint set map of the index mapping to a pair of the
-     * disjoint set value and the actor node
+     * Builds the disjoint set map of the index mapping to a pair of the
+     * disjoint set value and the actor node. Prefer getActors
      *
      * actorGraph: graph of actor and movie nodes
      */
     unordered_map<int, pair<int, ActorNode*>> getDSM(ActorGraph& actorGraph);
 
     /**
-     * Returns the index map mapping an actor node to an index
+     * Builds the index map mapping an actor node to an index. Prefer the
+     * node's own index
      *
      * actorGraph: graph of actor and movie nodes
      */
     unordered_map<ActorNode*, int> getIndexMap(ActorGraph& actorGraph);
 
+    /**
+     * Appends the bytes reserved by each structure the graph holds, along
+     * with those the maps built on demand would reserve. The vectors and
+     * names held by each node are not included
+     *
+     * actorGraph: graph of actor and movie nodes
+     * structures: vector the structures are appended to
+     */
+    void getStructureBytes(const ActorGraph& actorGraph,
+                           vector<StructureBytes>& structures) const;
+
     /**
      * Returns the number of nodes within actorGraph
      *
      * actorGraph: graph of actor and movie nodes
      */
-    int getNodeCount(ActorGraph& actorGraph);
+    int getNodeCount(const ActorGraph& actorGraph) const;
+
+    /**
+     * Returns the number of movies within actorGraph
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    int getMovieCount(const ActorGraph& actorGraph) const;
+
+    /**
+     * Sets the number of actors above which a movie's cast is heavy, and
+     * classifies every movie again. Movies are classified as they are loaded,
+     * so this is only needed to change the default of HEAVY_CAST
+     *
+     * actorGraph: graph of actor and movie nodes
+     * heavyCast: number of actors above which a cast is heavy
+     */
+    void setHeavyCast(ActorGraph& actorGraph, size_t heavyCast);
+
+    /**
+     * Returns the number of movies whose cast is heavy
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    int getHeavyCount(const ActorGraph& actorGraph) const;
+
+    /**
+     * Returns the number of rows dropped by every load so far because their
+     * actor was already linked to their movie
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    long getDuplicateCount(const ActorGraph& actorGraph) const;
+
+    /**
+     * Returns the number of rows dropped by every load so far because their
+     * year was not a number
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    long getMalformedCount(const ActorGraph& actorGraph) const;
+
+    /**
+     * Returns the links added by the last appendFromFile, in the order they
+     * were read, which lets results over the graph be updated instead of
+     * computed again
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    const vector<pair<ActorNode*, MovieNode*>>& getAppendedLinks(
+        const ActorGraph& actorGraph) const {
+        return appendedLinks;
+    }
+
+    /**
+     * Sets whether the nodes and sorted index runs are kept in huge pages,
+     * which lets searches that reach them at random miss the TLB less often.
+     * Only an empty graph can change, so this is called before loading, and
+     * false is returned for a graph that is not empty
+     *
+     * actorGraph: graph of actor and movie nodes
+     * enabled: if true, keep the graph in huge pages
+     */
+    bool setHugePages(ActorGraph& actorGraph, bool enabled);
+
+    /**
+     * Returns whether the nodes and sorted index runs are kept in huge pages
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    bool usesHugePages(const ActorGraph& actorGraph) const;
+
+    /**
+     * Returns the indices of an actor's movies in increasing order, which
+     * allows merging them with another actor's
+     *
+     * actorGraph: graph of actor and movie nodes
+     * actorNode: actor whose movies are returned
+     */
+    IdRange getMovieIds(const ActorGraph& actorGraph,
+                        const ActorNode* actorNode) const;
+
+    /**
+     * Returns the indices of a movie's actors in increasing order, which
+     * allows merging them with another movie's
+     *
+     * actorGraph: graph of actor and movie nodes
+     * movieNode: movie whose actors are returned
+     */
+    IdRange getCastIds(const ActorGraph& actorGraph,
+                       const MovieNode* movieNode) const;
 
     /**
      * Load the graph from a tab-delimited file of actor->movie relationships.
+     * A row repeating a link already loaded is dropped and counted, so every
+     * actor and movie is linked at most once, and the sorted index runs are
+     * rebuilt at the end.
      *
      * in_filename: input filename
      * use_weighted_edges: if true, compute edge weights as 1 + (2019 -
@@ -115,6 +448,29 @@ class ActorGraph {
      */
     bool loadFromFile(ActorGraph& actorGraph, const char* in_filename,
                       bool use_weighted_edges);
+
+    /**
+     * Add the rows of a tab-delimited delta file to an already loaded graph.
+     * New actors and movies are created, new links are added to existing
+     * nodes, and movies are weighted the same way as in loadFromFile. Only
+     * the rows of the delta are read, and only the sorted index runs of the
+     * actors and movies it touches are moved, so the cost does not depend on
+     * the size of the graph.
+     *
+     * actorGraph: graph of actor and movie nodes
+     * in_filename: delta filename, with a header line like loadFromFile
+     */
+    bool appendFromFile(ActorGraph& actorGraph, const char* in_filename);
+
+    /**
+     * Write the graph as a tab-delimited file that loadFromFile can read
+     * back. Actors are written in the order they were added, each with its
+     * movies in order, so a reloaded graph keeps every actor's index.
+     *
+     * actorGraph: graph of actor and movie nodes
+     * out_filename: snapshot filename
+     */
+    bool saveToFile(ActorGraph& actorGraph, const char* out_filename);
 };
 
 // Defines an actorNode
@@ -122,23 +478,29 @@ struct ActorNode {
     // Name of actor
     string actorName;
 
-    // Vector containing movies the actor has been in
+    // Vector containing movies the actor has been in, each once, in the order
+    // they were loaded
     vector<MovieNode*> movieVect;
 
-    // Initialize dist to infinity
-    double dist;
+    // The same movies sorted by year, so a year window is found with a
+    // binary search. Movies of the same year keep their movieVect order
+    vector<MovieNode*> moviesByYear;
 
-    // Initialize prev to nullptr
-    MovieNode* prev;
+    // Position in movieVect of each movie of moviesByYear, so a window's
+    // movies can be walked in the order they were loaded
+    vector<uint32_t> yearPositions;
 
-    // Initialize done to false
-    bool done;
+    // Index of the actor in the actor vector, used by searches to keep
+    // their per-query state outside of the node
+    int index;
 
     ActorNode(string actorName, vector<MovieNode*> movieVect)
-        : actorName(actorName), movieVect(movieVect) {
-        dist = numeric_limits<double>::infinity();
-        prev = nullptr;
-        done = false;
+        : actorName(move(actorName)), movieVect(move(movieVect)) {
+        index = -1;
+    }
+
+    explicit ActorNode(string actorName) : actorName(move(actorName)) {
+        index = -1;
     }
 };
 
@@ -150,22 +512,223 @@ struct MovieNode {
     // Year of movie
     int year;
 
-    // Vector containing actors in the movie
+    // Vector containing actors in the movie, each once, in the order they
+    // were loaded
     vector<ActorNode*> actorVect;
 
-    // Initialize prev to nullptr
-    ActorNode* prev;
-
     // Initialize edgeWeight to 1
     int edgeWeight;
 
+    // Index of the movie in the edge vector
+    int index;
+
+    // Whether the cast is large enough that searches may treat the movie
+    // specially, such as documentaries and award shows
+    bool heavy;
+
     MovieNode(string movieName, int year, vector<ActorNode*> actorVect)
-        : movieName(movieName), year(year), actorVect(actorVect) {
-        prev = nullptr;
+        : movieName(move(movieName)), year(year), actorVect(move(actorVect)) {
         edgeWeight = 1;
+        index = -1;
+        heavy = false;
+    }
+
+    MovieNode(string movieName, int year)
+        : movieName(move(movieName)), year(year) {
+        edgeWeight = 1;
+        index = -1;
+        heavy = false;
+    }
+};
+
+// Range of years a query is restricted to, along with the year that weighted
+// queries measure a movie's age from
+struct YearWindow {
+    // Earliest year of a movie in the window
+    int minYear;
+
+    // Latest year of a movie in the window
+    int maxYear;
+
+    // Year a movie's age is measured from
+    int refYear;
+
+    YearWindow()
+        : minYear(numeric_limits<int>::min()),
+          maxYear(numeric_limits<int>::max()),
+          refYear(CURR_YEAR) {}
+
+    // Whether the window holds every year
+    bool isUnbounded() const {
+        return minYear == numeric_limits<int>::min() &&
+               maxYear == numeric_limits<int>::max();
     }
 };
 
+/**
+ * Returns the movies of an actor, in the order they were added
+ *
+ * node: actor whose movies are returned
+ */
+inline MovieRange moviesOf(const ActorNode* node) {
+    return rangeOf(node->movieVect);
+}
+
+/**
+ * Returns the cast of a movie, in the order they were added
+ *
+ * node: movie whose actors are returned
+ */
+inline ActorRange castOf(const MovieNode* node) {
+    return rangeOf(node->actorVect);
+}
+
+// Range of the movies of an actor that fall in a year window, in the order
+// they were loaded. It spans the movieVect positions from the first to the
+// last movie in the window, and skips the movies between them that are not
+struct WindowRange {
+    // Iterator that skips the movies outside the window if filtered is set
+    struct iterator {
+        MovieNode* const* pos;
+        MovieNode* const* last;
+        int minYear;
+        int maxYear;
+        bool filtered;
+
+        MovieNode* operator*() const { return *pos; }
+
+        iterator& operator++() {
+            ++pos;
+            while (filtered && pos != last &&
+                   ((*pos)->year < minYear || (*pos)->year > maxYear)) {
+                ++pos;
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const {
+            return pos == other.pos;
+        }
+        bool operator!=(const iterator& other) const {
+            return pos != other.pos;
+        }
+    };
+
+    // First and one past the last movie of the span, both in the window
+    MovieNode* const* first;
+    MovieNode* const* last;
+
+    // Years of the window, tested only if some movie of the span is outside
+    int minYear;
+    int maxYear;
+    bool filtered;
+
+    iterator begin() const {
+        return iterator{first, last, minYear, maxYear, filtered};
+    }
+    iterator end() const {
+        return iterator{last, last, minYear, maxYear, filtered};
+    }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * Returns the run of moviesByYear that falls in a year window, or movieVect
+ * itself for an unbounded window
+ *
+ * node: actor whose movies are returned
+ * window: years the movies are restricted to
+ */
+inline MovieRange moviesByYearInWindow(const ActorNode* node,
+                                       const YearWindow& window) {
+    if (window.isUnbounded()) {
+        return moviesOf(node);
+    }
+
+    MovieNode* const* first = node->moviesByYear.data();
+    MovieNode* const* last = first + node->moviesByYear.size();
+
+    // Skip movies before the window, then stop at the first one after it
+    first = lower_bound(first, last, window.minYear,
+                        [](const MovieNode* movie, int year) {
+                            return movie->year < year;
+                        });
+    last = upper_bound(first, last, window.maxYear,
+                       [](int year, const MovieNode* movie) {
+                           return year < movie->year;
+                       });
+    return MovieRange{first, last};
+}
+
+/**
+ * Returns the movies of an actor that fall in a year window, in the order they
+ * were loaded, so that searches break ties between movies the same way as
+ * over a graph loaded with only the window's rows. The window is found in
+ * moviesByYear, and only the span of movieVect it covers is walked
+ *
+ * node: actor whose movies are returned
+ * window: years the movies are restricted to
+ */
+inline WindowRange moviesInWindow(const ActorNode* node,
+                                  const YearWindow& window) {
+    MovieNode* const* movies = node->movieVect.data();
+    if (window.isUnbounded()) {
+        return WindowRange{movies, movies + node->movieVect.size(),
+                           window.minYear, window.maxYear, false};
+    }
+
+    MovieRange run = moviesByYearInWindow(node, window);
+    if (run.empty()) {
+        return WindowRange{movies, movies, window.minYear, window.maxYear,
+                           false};
+    }
+
+    // Find where the window's movies start and end in movieVect
+    const uint32_t* positions = node->yearPositions.data() +
+                                (run.begin() - node->moviesByYear.data());
+    uint32_t firstPosition = positions[0];
+    uint32_t lastPosition = positions[0];
+    for (size_t i = 1; i < run.size(); i++) {
+        firstPosition = min(firstPosition, positions[i]);
+        lastPosition = max(lastPosition, positions[i]);
+    }
+
+    // Years are only tested if movies outside the window lie in between
+    bool filtered = lastPosition - firstPosition + 1 != run.size();
+    return WindowRange{movies + firstPosition, movies + lastPosition + 1,
+                       window.minYear, window.maxYear, filtered};
+}
+
+inline IdRange ActorGraph::getMovieIds(const ActorGraph& actorGraph,
+                                       const ActorNode* actorNode) const {
+    const uint32_t* ids = movieIds.data();
+    const uint32_t* run = movieIdRuns.data() + 2 * actorNode->index;
+    return IdRange{ids + run[0], ids + run[1]};
+}
+
+inline IdRange ActorGraph::getCastIds(const ActorGraph& actorGraph,
+                                      const MovieNode* movieNode) const {
+    const uint32_t* ids = castIds.data();
+    const uint32_t* run = castIdRuns.data() + 2 * movieNode->index;
+    return IdRange{ids + run[0], ids + run[1]};
+}
+
+inline uint64_t HashActorNode::operator()(const ActorNode* node) const {
+    return HashNameKey()(NameKey(node->actorName));
+}
+
+inline uint64_t HashMovieNode::operator()(const MovieNode* node) const {
+    return HashMovieKey()(MovieKey(NameKey(node->movieName), node->year));
+}
+
+inline const string& ActorNodeName::operator()(const ActorNode* node) const {
+    return node->actorName;
+}
+
+inline const string& MovieNodeName::operator()(const MovieNode* node) const {
+    return node->movieName;
+}
+
 // Comparator that sorts by edgeWeight then by movie name
 struct EdgeWeight {
     bool operator()(MovieNode*& lhs, MovieNode*& rhs) {
@@ -0,0 +1,85 @@
+/*
+ * BatchPathFinder.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that interleaves many shortest path searches on one
+ * thread
+ */
+
+#include "BatchPathFinder.hpp"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Constructor of a BatchPathFinder over a graph
+ *
+ * actorGraph: graph to traverse
+ * width: number of searches in flight at once
+ */
+BatchPathFinder::BatchPathFinder(ActorGraph& actorGraph, int width)
+    : actorGraph(actorGraph) {
+    finders.reserve(max(width, 1));
+    for (int i = 0; i < max(width, 1); i++) {
+        finders.push_back(PathFinder(actorGraph));
+    }
+}
+
+/**
+ * Finds the shortest path of every query, filling in their paths
+ *
+ * queries: queries to be searched
+ * weighted: if true, weight each movie by its age, otherwise weights are 1
+ * window: years of the movies the paths may go through, as in PathFinder
+ */
+void BatchPathFinder::shortestPaths(vector<PathQuery>& queries, bool weighted,
+                                    const YearWindow& window) {
+    // Rank the names again if actors were added since the last batch
+    if (nameRanks.size() != (size_t)actorGraph.getNodeCount(actorGraph)) {
+        PathFinder::rankNames(actorGraph, nameRanks);
+    }
+
+    // Query searched by each finder, or nullptr if it is idle
+    vector<PathQuery*> running(finders.size(), nullptr);
+    size_t next = 0;
+    size_t active = 0;
+
+    // Start the next query that has a first actor on a finder
+    auto startNext = [&](size_t f) {
+        running[f] = nullptr;
+        while (next < queries.size()) {
+            PathQuery& query = queries[next++];
+            query.path.clear();
+            if (query.firstActor != nullptr) {
+                finders[f].startSearch(query.firstActor, query.finalActor,
+                                       weighted, window, nameRanks);
+                running[f] = &query;
+                active++;
+                return;
+            }
+        }
+    };
+
+    for (size_t f = 0; f < finders.size(); f++) {
+        startNext(f);
+    }
+
+    // Step each search in turn, so one runs while the others' prefetches load
+    while (active > 0) {
+        for (size_t f = 0; f < finders.size(); f++) {
+            PathQuery* query = running[f];
+            if (query == nullptr || finders[f].stepSearch()) {
+                continue;
+            }
+
+            // Write the path before the finder starts another search
+            ActorNode* found = finders[f].searchResult();
+            if (found != nullptr) {
+                finders[f].appendPath(query->path, found, query->firstActor);
+            }
+            active--;
+            startNext(f);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * BatchPathFinder.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the batch engine that interleaves many shortest path
+ * searches on one thread
+ */
+
+#ifndef BATCHPATHFINDER_HPP
+#define BATCHPATHFINDER_HPP
+
+#include <string>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "PathFinder.hpp"
+
+using namespace std;
+
+// Default number of searches in flight at once
+#define BATCH_WIDTH 4
+
+// Defines one query of a batch
+struct PathQuery {
+    // Actor to begin searching, or nullptr to skip the query
+    ActorNode* firstActor;
+
+    // Actor to find, which may be nullptr
+    ActorNode* finalActor;
+
+    // Path in the format of PathFinder::appendPath, empty if none was found
+    string path;
+};
+
+/**
+ * Class that runs many independent shortest path searches on one thread. A
+ * search is stepped until it has to wait on memory it prefetched, then the
+ * next search is stepped while that memory loads, so the cache misses of the
+ * searches overlap. Each search finds the same path as PathFinder.
+ */
+class BatchPathFinder {
+  private:
+    // Graph to be searched
+    ActorGraph& actorGraph;
+
+    // Search state of each search in flight
+    vector<PathFinder> finders;
+
+    // Rank of each actor's name, which the searches break ties with
+    vector<uint32_t> nameRanks;
+
+  public:
+    /**
+     * Constructor of a BatchPathFinder over a graph
+     *
+     * actorGraph: graph to traverse
+     * width: number of searches in flight at once
+     */
+    BatchPathFinder(ActorGraph& actorGraph, int width = BATCH_WIDTH);
+
+    /**
+     * Finds the shortest path of every query, filling in their paths
+     *
+     * queries: queries to be searched
+     * weighted: if true, weight each movie by its age, otherwise weights are 1
+     * window: years of the movies the paths may go through, as in PathFinder
+     */
+    void shortestPaths(vector<PathQuery>& queries, bool weighted,
+                       const YearWindow& window = YearWindow());
+};
+
+#endif  // BATCHPATHFINDER_HPP
@@ -0,0 +1,310 @@
+/*
+ * FlatIndex.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the open-addressing hash index that ActorGraph uses to
+ * look up actor and movie nodes by name
+ */
+
+#ifndef FLATINDEX_HPP
+#define FLATINDEX_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Folds the 128-bit product of two 64-bit words into 64 bits
+ *
+ * a: first word
+ * b: second word
+ */
+inline uint64_t hashMix(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t product = (__uint128_t)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    // Multiply by 32-bit halves where there is no 128-bit integer type
+    const uint64_t LOW_MASK = 0xffffffffULL;
+    uint64_t aLow = a & LOW_MASK;
+    uint64_t aHigh = a >> 32;
+    uint64_t bLow = b & LOW_MASK;
+    uint64_t bHigh = b >> 32;
+
+    uint64_t lowLow = aLow * bLow;
+    uint64_t highLow = aHigh * bLow;
+    uint64_t lowHigh = aLow * bHigh;
+    uint64_t highHigh = aHigh * bHigh;
+
+    // Sum the middle terms with the carry out of the low word
+    uint64_t middle = (lowLow >> 32) + (highLow & LOW_MASK) + lowHigh;
+    uint64_t low = (middle << 32) | (lowLow & LOW_MASK);
+    uint64_t high = highHigh + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+/**
+ * Hashes a run of bytes eight at a time. Every input bit affects every output
+ * bit, so both the high and low bits of the result are usable
+ *
+ * data: first byte to hash
+ * size: number of bytes to hash
+ * seed: value mixed into the hash, used to combine further fields
+ */
+inline uint64_t hashBytes(const char* data, size_t size, uint64_t seed) {
+    const uint64_t PRIME_ONE = 0xa0761d6478bd642fULL;
+    const uint64_t PRIME_TWO = 0xe7037ed1a0b428dbULL;
+
+    uint64_t hash = seed ^ PRIME_ONE;
+    size_t remaining = size;
+
+    // Mix in each full word
+    while (remaining >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(uint64_t));
+        hash = hashMix(hash ^ word, PRIME_TWO);
+        data += sizeof(uint64_t);
+        remaining -= sizeof(uint64_t);
+    }
+
+    // Mix in the remaining bytes, padded with zeros
+    uint64_t tail = 0;
+    memcpy(&tail, data, remaining);
+    hash = hashMix(hash ^ tail, PRIME_TWO);
+
+    // Mix in the length so that zero padding cannot collide
+    return hashMix(hash ^ size, PRIME_ONE);
+}
+
+/**
+ * Open-addressing hash index of node pointers. Slots are grouped by 16, and
+ * each slot has a control byte holding 7 bits of its node's hash, so a probe
+ * compares a whole group of tags at once and only touches the slots whose tag
+ * matches. Each slot also keeps a view of its node's name, so a lookup
+ * compares names without loading the node. The index never removes single
+ * nodes, so it needs no tombstones.
+ *
+ * Node: type of node stored in the index
+ * NodeHash: functor returning the 64-bit hash of a stored node
+ * NodeName: functor returning the name of a stored node
+ */
+template <typename Node, typename NodeHash, typename NodeName>
+class FlatIndex {
+  private:
+    enum : size_t {
+        // Number of slots in a probe group
+        GROUP_SIZE = 16
+    };
+
+    enum : uint8_t {
+        // Control byte of a slot that holds no node
+        EMPTY = 0x80
+    };
+
+    // Control bytes, one per slot
+    vector<uint8_t> ctrl;
+
+    // Name and node stored in each slot
+    struct Slot {
+        const char* name;
+        size_t nameSize;
+        Node* node;
+    };
+
+    // Slots of the index
+    vector<Slot> slots;
+
+    // Number of nodes in the index
+    size_t count;
+
+    /**
+     * Returns a bit mask of the slots in a group whose control byte equals
+     * the given byte
+     *
+     * group: first control byte of the group
+     * byte: control byte to match
+     */
+    static uint32_t matchGroup(const uint8_t* group, uint8_t byte) {
+#ifdef __SSE2__
+        __m128i tags = _mm_loadu_si128((const __m128i*)group);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(byte)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_SIZE; i++) {
+            if (group[i] == byte) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    /**
+     * Returns the tag stored in a control byte for a hash
+     *
+     * hash: hash of the node
+     */
+    static uint8_t tagOf(uint64_t hash) { return hash & 0x7f; }
+
+    /**
+     * Returns the first group probed for a hash
+     *
+     * hash: hash of the node
+     */
+    size_t groupOf(uint64_t hash) const {
+        return (hash >> 7) & (slots.size() / GROUP_SIZE - 1);
+    }
+
+    /**
+     * Places a node in the first empty slot of its probe sequence
+     *
+     * hash: hash of the node
+     * node: node to be placed
+     */
+    void place(uint64_t hash, Node* node) {
+        size_t groupMask = slots.size() / GROUP_SIZE - 1;
+        size_t group = groupOf(hash);
+
+        // Probe groups triangularly until one has an empty slot
+        for (size_t step = 1;; step++) {
+            size_t base = group * GROUP_SIZE;
+            uint32_t empty = matchGroup(&ctrl[base], EMPTY);
+            if (empty != 0) {
+                size_t slot = base + __builtin_ctz(empty);
+                const string& name = NodeName()(node);
+                ctrl[slot] = tagOf(hash);
+                slots[slot].name = name.data();
+                slots[slot].nameSize = name.size();
+                slots[slot].node = node;
+                return;
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    /**
+     * Doubles the number of slots and places every node again
+     */
+    void grow() {
+        vector<uint8_t> oldCtrl;
+        vector<Slot> oldSlots;
+        oldCtrl.swap(ctrl);
+        oldSlots.swap(slots);
+
+        size_t capacity = oldSlots.empty() ? GROUP_SIZE : 2 * oldSlots.size();
+        ctrl.assign(capacity, EMPTY);
+        slots.assign(capacity, Slot());
+
+        for (size_t i = 0; i < oldSlots.size(); i++) {
+            if (oldCtrl[i] != EMPTY) {
+                place(NodeHash()(oldSlots[i].node), oldSlots[i].node);
+            }
+        }
+    }
+
+  public:
+    /**
+     * Constructor of an empty index
+     */
+    FlatIndex() : count(0) {}
+
+    /**
+     * Returns the node with the given hash and name that satisfies matches, or
+     * nullptr if there is none
+     *
+     * hash: hash of the key being searched for
+     * name: first character of the name being searched for
+     * nameSize: number of characters in the name being searched for
+     * matches: predicate that checks the rest of the key against a node whose
+     * name is equal
+     */
+    template <typename Matches>
+    Node* find(uint64_t hash, const char* name, size_t nameSize,
+               Matches matches) const {
+        if (count == 0) {
+            return nullptr;
+        }
+
+        size_t groupMask = slots.size() / GROUP_SIZE - 1;
+        size_t group = groupOf(hash);
+        uint8_t tag = tagOf(hash);
+
+        for (size_t step = 1;; step++) {
+            size_t base = group * GROUP_SIZE;
+
+            // Only compare the slots whose tag matches
+            for (uint32_t hits = matchGroup(&ctrl[base], tag); hits != 0;
+                 hits &= hits - 1) {
+                const Slot& slot = slots[base + __builtin_ctz(hits)];
+                if (slot.nameSize == nameSize &&
+                    memcmp(slot.name, name, nameSize) == 0 &&
+                    matches(slot.node)) {
+                    return slot.node;
+                }
+            }
+
+            // An empty slot ends the probe sequence
+            if (matchGroup(&ctrl[base], EMPTY) != 0) {
+                return nullptr;
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    /**
+     * Inserts a node that is not yet in the index
+     *
+     * hash: hash of the node
+     * node: node to be inserted
+     */
+    void insert(uint64_t hash, Node* node) {
+        // Keep the load factor at or below 7/8
+        if (8 * (count + 1) > 7 * slots.size()) {
+            grow();
+        }
+
+        place(hash, node);
+        count++;
+    }
+
+    /**
+     * Makes room for at least the given number of nodes
+     *
+     * expected: number of nodes expected in the index
+     */
+    void reserve(size_t expected) {
+        while (8 * expected > 7 * slots.size()) {
+            grow();
+        }
+    }
+
+    /**
+     * Removes every node from the index
+     */
+    void clear() {
+        ctrl.clear();
+        slots.clear();
+        count = 0;
+    }
+
+    /**
+     * Returns the number of nodes in the index
+     */
+    size_t size() const { return count; }
+
+    /**
+     * Returns the number of bytes used by the index's slots
+     */
+    size_t bytesReserved() const {
+        return ctrl.capacity() + slots.capacity() * sizeof(Slot);
+    }
+};
+
+#endif  // FLATINDEX_HPP
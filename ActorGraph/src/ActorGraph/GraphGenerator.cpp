@@ -0,0 +1,128 @@
+/*
+ * GraphGenerator.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that generates synthetic actor/movie files whose cast
+ * sizes and actor popularity follow power laws, like the IMDB data
+ */
+
+#include "GraphGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#define TAB_CHAR '\t'
+#define FILE_HEADER "Actor/Actress\tMovie\tYear"
+#define ACTOR_PREFIX "Actor "
+#define MOVIE_PREFIX "Movie "
+#define WRITE_FAILURE "Failed to write "
+#define FAILURE_PUNCT "!\n"
+#define MAX_DRAWS 8
+
+using namespace std;
+
+/**
+ * Returns a uniformly distributed number in [0, 1) built from the top 53 bits
+ * of the generator, so the same seed gives the same graph on every platform
+ *
+ * rng: random number generator
+ */
+static double uniform(mt19937_64& rng) {
+    return (rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Returns the name generateGraph gives an actor
+ *
+ * actor: number of the actor, from 0 to shape.actors - 1
+ */
+string generatedActorName(int actor) { return ACTOR_PREFIX + to_string(actor); }
+
+/**
+ * Writes a tab-delimited actor/movie file with the given shape, in the format
+ * loadFromFile reads. Rows are grouped by actor, like the IMDB files the tools
+ * are run on. Returns false if the file cannot be written
+ *
+ * shape: size and shape of the graph
+ * out_filename: filename of the generated file
+ */
+bool generateGraph(const GraphShape& shape, const char* out_filename) {
+    mt19937_64 rng(shape.seed);
+
+    // Cumulative Zipf weights, so actor i is cast with weight 1 / (i + 1)^s
+    vector<double> popularity(shape.actors);
+    double total = 0;
+    for (int i = 0; i < shape.actors; i++) {
+        total += pow(i + 1.0, -shape.popularityExponent);
+        popularity[i] = total;
+    }
+
+    int maxCast = min(shape.maxCast, shape.actors);
+    int yearSpan = shape.lastYear - shape.firstYear + 1;
+
+    // Movies each actor is cast in, and the year of each movie
+    vector<vector<int>> roles(shape.actors);
+    vector<int> years(shape.movies);
+    vector<int> cast;
+
+    for (int movie = 0; movie < shape.movies; movie++) {
+        years[movie] = shape.firstYear + rng() % yearSpan;
+
+        // Draw the cast size from a Pareto distribution by inverting its CDF
+        double size = shape.minCast * pow(1.0 - uniform(rng),
+                                          -1.0 / (shape.castExponent - 1.0));
+        int castSize = min((double)maxCast, floor(size));
+
+        // Cast actors by popularity, redrawing the few that repeat
+        cast.clear();
+        for (int slot = 0; slot < castSize; slot++) {
+            for (int draw = 0; draw < MAX_DRAWS; draw++) {
+                int actor = upper_bound(popularity.begin(), popularity.end(),
+                                        uniform(rng) * total) -
+                            popularity.begin();
+                actor = min(actor, shape.actors - 1);
+
+                if (find(cast.begin(), cast.end(), actor) == cast.end()) {
+                    cast.push_back(actor);
+                    break;
+                }
+            }
+        }
+
+        for (int actor : cast) {
+            roles[actor].push_back(movie);
+        }
+    }
+
+    ofstream outfile(out_filename);
+    outfile << FILE_HEADER << '\n';
+
+    // Record buffer reused for every row
+    string row;
+
+    for (int actor = 0; actor < shape.actors; actor++) {
+        for (int movie : roles[actor]) {
+            row.assign(generatedActorName(actor));
+            row += TAB_CHAR;
+            row += MOVIE_PREFIX;
+            row += to_string(movie);
+            row += TAB_CHAR;
+            row += to_string(years[movie]);
+            row += '\n';
+            outfile.write(row.data(), row.size());
+        }
+    }
+
+    outfile.close();
+
+    if (!outfile) {
+        cerr << WRITE_FAILURE << out_filename << FAILURE_PUNCT;
+        return false;
+    }
+
+    return true;
+}
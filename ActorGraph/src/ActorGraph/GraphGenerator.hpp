@@ -0,0 +1,74 @@
+/*
+ * GraphGenerator.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the generator of synthetic actor/movie files used by
+ * graphgen and the benchmarks
+ */
+
+#ifndef GRAPHGENERATOR_HPP
+#define GRAPHGENERATOR_HPP
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Defines the size and shape of a generated graph
+struct GraphShape {
+    // Number of actors that may be cast
+    int actors;
+
+    // Number of movies generated
+    int movies;
+
+    // Smallest and largest cast of a movie
+    int minCast;
+    int maxCast;
+
+    // Exponent of the power law cast sizes are drawn from. Larger values give
+    // fewer large casts
+    double castExponent;
+
+    // Exponent of the Zipf law actors are cast by. Larger values concentrate
+    // more roles on the most popular actors
+    double popularityExponent;
+
+    // Range of years movies are released in
+    int firstYear;
+    int lastYear;
+
+    // Seed of the generator, the same seed always gives the same file
+    uint64_t seed;
+
+    GraphShape(int actors, int movies)
+        : actors(actors),
+          movies(movies),
+          minCast(2),
+          maxCast(150),
+          castExponent(2.2),
+          popularityExponent(0.9),
+          firstYear(1950),
+          lastYear(2019),
+          seed(1) {}
+};
+
+/**
+ * Writes a tab-delimited actor/movie file with the given shape, in the format
+ * loadFromFile reads. Rows are grouped by actor, like the IMDB files the tools
+ * are run on. Returns false if the file cannot be written
+ *
+ * shape: size and shape of the graph
+ * out_filename: filename of the generated file
+ */
+bool generateGraph(const GraphShape& shape, const char* out_filename);
+
+/**
+ * Returns the name generateGraph gives an actor
+ *
+ * actor: number of the actor, from 0 to shape.actors - 1
+ */
+string generatedActorName(int actor);
+
+#endif  // GRAPHGENERATOR_HPP
@@ -0,0 +1,192 @@
+/*
+ * GraphReport.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that computes the shape and memory report of a graph
+ */
+
+#include "GraphReport.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+using namespace std;
+
+/**
+ * Adds one to the power of two bucket of a count, growing the histogram as
+ * needed
+ *
+ * histogram: histogram to be added to
+ * count: count whose bucket is added to
+ */
+static void addToBucket(vector<long>& histogram, long count) {
+    size_t bucket = 0;
+    while (count > 1) {
+        count >>= 1;
+        bucket++;
+    }
+    if (histogram.size() <= bucket) {
+        histogram.resize(bucket + 1, 0);
+    }
+    histogram[bucket]++;
+}
+
+/**
+ * Returns the bytes a string holds outside of itself, which is none when the
+ * string is short enough to be kept inside the object
+ *
+ * str: string to be measured
+ */
+static size_t heapBytes(const string& str) {
+    const char* data = str.data();
+    const char* object = reinterpret_cast<const char*>(&str);
+    if (data >= object && data < object + sizeof(string)) {
+        return 0;
+    }
+    return str.capacity() + 1;
+}
+
+/**
+ * Returns the root of an actor's component, halving the path on the way
+ *
+ * parents: parent of each actor, indexed by actor index
+ * index: index of the actor
+ */
+static uint32_t findRoot(vector<uint32_t>& parents, uint32_t index) {
+    while (parents[index] != index) {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+    return index;
+}
+
+/**
+ * Fills in the shape and memory report of a graph in one pass over its movies
+ * followed by one over its actors. Components are found with a union-find over
+ * the casts as the movies stream by, so no search is run
+ *
+ * actorGraph: graph of actor and movie nodes
+ * top: number of largest casts and components listed
+ * report: report to be filled in
+ */
+void graphReport(const ActorGraph& actorGraph, int top, GraphReport& report) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    MovieRange movies = actorGraph.getMovies(actorGraph);
+    size_t listed = max(top, 0);
+
+    report.actors = actors.size();
+    report.movies = movies.size();
+    report.links = 0;
+    report.heavyMovies = actorGraph.getHeavyCount(actorGraph);
+    report.duplicateRows = actorGraph.getDuplicateCount(actorGraph);
+    report.malformedRows = actorGraph.getMalformedCount(actorGraph);
+    report.actorDegrees.clear();
+    report.movieDegrees.clear();
+    report.maxActorDegree = 0;
+    report.maxMovieDegree = 0;
+    report.largestCasts.clear();
+    report.components = 0;
+    report.componentSizes.clear();
+    report.largestComponents.clear();
+    report.structures.clear();
+    actorGraph.getStructureBytes(actorGraph, report.structures);
+
+    // Each actor starts in a component of its own
+    vector<uint32_t> parents(actors.size());
+    for (size_t i = 0; i < parents.size(); i++) {
+        parents[i] = i;
+    }
+
+    // Largest casts so far, the smallest of them on top
+    auto largerCast = [](const MovieNode* lhs, const MovieNode* rhs) {
+        if (lhs->actorVect.size() != rhs->actorVect.size()) {
+            return lhs->actorVect.size() > rhs->actorVect.size();
+        }
+        return lhs->movieName < rhs->movieName;
+    };
+    priority_queue<MovieNode*, vector<MovieNode*>, decltype(largerCast)>
+        largest(largerCast);
+
+    size_t movieNameBytes = 0;
+    size_t castBytes = 0;
+    for (MovieNode* movieNode : movies) {
+        long degree = movieNode->actorVect.size();
+        report.links += degree;
+        report.maxMovieDegree = max(report.maxMovieDegree, degree);
+        addToBucket(report.movieDegrees, degree);
+
+        movieNameBytes += heapBytes(movieNode->movieName);
+        castBytes += movieNode->actorVect.capacity() * sizeof(ActorNode*);
+
+        // Keep the movie if it is among the largest casts
+        largest.push(movieNode);
+        if (largest.size() > listed) {
+            largest.pop();
+        }
+
+        // Join the whole cast to its first actor's component
+        if (degree > 1) {
+            uint32_t root = findRoot(parents, movieNode->actorVect[0]->index);
+            for (ActorNode* actorNode : movieNode->actorVect) {
+                uint32_t other = findRoot(parents, actorNode->index);
+                if (other != root) {
+                    parents[other] = root;
+                }
+            }
+        }
+    }
+
+    while (!largest.empty()) {
+        report.largestCasts.push_back(largest.top());
+        largest.pop();
+    }
+    reverse(report.largestCasts.begin(), report.largestCasts.end());
+
+    // Number of actors of each component, kept at its root
+    vector<long> sizes(actors.size(), 0);
+
+    size_t actorNameBytes = 0;
+    size_t movieVectBytes = 0;
+    size_t byYearBytes = 0;
+    size_t positionBytes = 0;
+    for (ActorNode* actorNode : actors) {
+        long degree = actorNode->movieVect.size();
+        report.maxActorDegree = max(report.maxActorDegree, degree);
+        addToBucket(report.actorDegrees, degree);
+
+        actorNameBytes += heapBytes(actorNode->actorName);
+        movieVectBytes += actorNode->movieVect.capacity() * sizeof(MovieNode*);
+        byYearBytes += actorNode->moviesByYear.capacity() * sizeof(MovieNode*);
+        positionBytes += actorNode->yearPositions.capacity() * sizeof(uint32_t);
+
+        sizes[findRoot(parents, actorNode->index)]++;
+    }
+
+    // Only roots have a size
+    for (long size : sizes) {
+        if (size > 0) {
+            report.components++;
+            addToBucket(report.componentSizes, size);
+            report.largestComponents.push_back(size);
+        }
+    }
+    size_t kept = min(listed, report.largestComponents.size());
+    partial_sort(report.largestComponents.begin(),
+                 report.largestComponents.begin() + kept,
+                 report.largestComponents.end(), greater<long>());
+    report.largestComponents.resize(kept);
+
+    report.structures.push_back(
+        StructureBytes{"ActorNode::actorName", actorNameBytes, false});
+    report.structures.push_back(
+        StructureBytes{"ActorNode::movieVect", movieVectBytes, false});
+    report.structures.push_back(
+        StructureBytes{"ActorNode::moviesByYear", byYearBytes, false});
+    report.structures.push_back(
+        StructureBytes{"ActorNode::yearPositions", positionBytes, false});
+    report.structures.push_back(
+        StructureBytes{"MovieNode::movieName", movieNameBytes, false});
+    report.structures.push_back(
+        StructureBytes{"MovieNode::actorVect", castBytes, false});
+}
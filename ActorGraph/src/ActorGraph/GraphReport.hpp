@@ -0,0 +1,97 @@
+/*
+ * GraphReport.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the shape and memory report computed by the
+ * graphreport tool
+ */
+
+#ifndef GRAPHREPORT_HPP
+#define GRAPHREPORT_HPP
+
+#include <vector>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+// Default number of largest casts and components listed
+#define REPORT_TOP 10
+
+// Defines the shape of a graph and the memory each of its structures uses
+struct GraphReport {
+    // Number of actors, movies, and links between them
+    long actors;
+    long movies;
+    long links;
+
+    // Number of movies whose cast is heavy
+    long heavyMovies;
+
+    // Number of rows dropped at load because they repeated a link
+    long duplicateRows;
+
+    // Number of rows dropped at load because their year was not a number
+    long malformedRows;
+
+    // Number of actors by their number of movies, and movies by their number
+    // of actors. Bucket b counts the degrees from 2^b to 2^(b + 1) - 1, with
+    // degree 0 counted in bucket 0
+    vector<long> actorDegrees;
+    vector<long> movieDegrees;
+
+    // Most movies of an actor and most actors of a movie
+    long maxActorDegree;
+    long maxMovieDegree;
+
+    // Movies with the largest casts, largest first with ties broken by name
+    vector<MovieNode*> largestCasts;
+
+    // Number of connected components, counting an actor with no costar as
+    // one
+    long components;
+
+    // Number of components by their number of actors, bucketed as the
+    // degrees are
+    vector<long> componentSizes;
+
+    // Number of actors of the largest components, largest first
+    vector<long> largestComponents;
+
+    // Bytes used by the graph's structures and the vectors and names of its
+    // nodes
+    vector<StructureBytes> structures;
+
+    // Average number of movies of an actor
+    double averageActorDegree() const {
+        return actors > 0 ? (double)links / actors : 0;
+    }
+
+    // Average number of actors of a movie
+    double averageMovieDegree() const {
+        return movies > 0 ? (double)links / movies : 0;
+    }
+
+    // Bytes of every structure the graph holds
+    size_t heldBytes() const {
+        size_t bytes = 0;
+        for (const StructureBytes& structure : structures) {
+            bytes += structure.onDemand ? 0 : structure.bytes;
+        }
+        return bytes;
+    }
+};
+
+/**
+ * Fills in the shape and memory report of a graph in one pass over its movies
+ * followed by one over its actors. Components are found with a union-find
+ * over the casts as the movies stream by, so no search is run
+ *
+ * actorGraph: graph of actor and movie nodes
+ * top: number of largest casts and components listed
+ * report: report to be filled in
+ */
+void graphReport(const ActorGraph& actorGraph, int top, GraphReport& report);
+
+#endif  // GRAPHREPORT_HPP
@@ -0,0 +1,178 @@
+/*
+ * HugePages.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the huge page allocations that ActorGraph can keep its
+ * nodes and sorted index runs in
+ */
+
+#ifndef HUGEPAGES_HPP
+#define HUGEPAGES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+// Size of a huge page
+#define HUGE_PAGE_BYTES (2 * 1024 * 1024)
+
+/**
+ * Returns a number of bytes rounded up to a whole number of huge pages
+ *
+ * bytes: number of bytes to be rounded
+ */
+inline size_t hugePageRound(size_t bytes) {
+    return (bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+}
+
+/**
+ * Allocates storage backed by huge pages. Pages reserved in hugetlbfs are
+ * used when there are enough of them, otherwise the storage is aligned to a
+ * huge page and advised for transparent huge pages. Without mmap, the storage
+ * comes from operator new. Throws bad_alloc if no storage is left
+ *
+ * bytes: number of bytes allocated, rounded up to whole huge pages
+ */
+inline void* hugePageAlloc(size_t bytes) {
+#ifdef __linux__
+    size_t rounded = hugePageRound(bytes);
+    void* memory = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory != MAP_FAILED) {
+        return memory;
+    }
+
+    // Map a huge page more than needed and trim both ends, so the storage
+    // starts on a huge page boundary
+    size_t mapped = rounded + HUGE_PAGE_BYTES;
+    memory = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        throw bad_alloc();
+    }
+
+    uintptr_t start = (uintptr_t)memory;
+    uintptr_t aligned =
+        (start + HUGE_PAGE_BYTES - 1) & ~(uintptr_t)(HUGE_PAGE_BYTES - 1);
+    if (aligned > start) {
+        munmap(memory, aligned - start);
+    }
+    if (start + mapped > aligned + rounded) {
+        munmap((void*)(aligned + rounded), start + mapped - aligned - rounded);
+    }
+
+    // Transparent huge pages may be turned off, so the advice can fail
+    madvise((void*)aligned, rounded, MADV_HUGEPAGE);
+    return (void*)aligned;
+#else
+    return ::operator new(bytes);
+#endif
+}
+
+/**
+ * Frees storage allocated by hugePageAlloc
+ *
+ * memory: storage to be freed
+ * bytes: number of bytes it was allocated with
+ */
+inline void hugePageFree(void* memory, size_t bytes) {
+#ifdef __linux__
+    munmap(memory, hugePageRound(bytes));
+#else
+    ::operator delete(memory);
+#endif
+}
+
+/**
+ * Allocator that keeps the storage of a vector in huge pages when it is
+ * turned on and the vector is at least a huge page in size. Smaller vectors
+ * come from operator new so they do not waste most of a page
+ */
+template <typename T>
+class HugePageAllocator {
+  private:
+    // Whether large vectors are kept in huge pages
+    bool huge;
+
+    /**
+     * Returns whether an allocation of n elements is kept in huge pages
+     *
+     * n: number of elements
+     */
+    bool inHugePages(size_t n) const {
+        return huge && n * sizeof(T) >= HUGE_PAGE_BYTES;
+    }
+
+    template <typename U>
+    friend class HugePageAllocator;
+
+  public:
+    typedef T value_type;
+
+    // The allocator moves with the vector, so a vector assigned from another
+    // keeps that vector's choice of pages
+    typedef true_type propagate_on_container_copy_assignment;
+    typedef true_type propagate_on_container_move_assignment;
+    typedef true_type propagate_on_container_swap;
+
+    /**
+     * Constructor of the allocator
+     *
+     * huge: if true, keep large vectors in huge pages
+     */
+    explicit HugePageAllocator(bool huge = false) : huge(huge) {}
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) : huge(other.huge) {}
+
+    /**
+     * Returns storage for n elements
+     *
+     * n: number of elements
+     */
+    T* allocate(size_t n) {
+        if (inHugePages(n)) {
+            return static_cast<T*>(hugePageAlloc(n * sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    /**
+     * Frees storage for n elements returned by allocate
+     *
+     * memory: storage to be freed
+     * n: number of elements it was allocated with
+     */
+    void deallocate(T* memory, size_t n) {
+        if (inHugePages(n)) {
+            hugePageFree(memory, n * sizeof(T));
+        } else {
+            ::operator delete(memory);
+        }
+    }
+
+    /**
+     * Returns whether large vectors are kept in huge pages
+     */
+    bool usesHugePages() const { return huge; }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>& other) const {
+        return huge == other.huge;
+    }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>& other) const {
+        return huge != other.huge;
+    }
+};
+
+#endif  // HUGEPAGES_HPP
@@ -0,0 +1,137 @@
+/*
+ * Intersection.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that counts the indices shared by two sorted runs
+ */
+
+#include "Intersection.hpp"
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Size ratio above which the shorter run is galloped through the longer one
+#define GALLOP_RATIO 32
+
+// Number of indices compared at a time by the SIMD merge
+#define BLOCK 4
+
+using namespace std;
+
+/**
+ * Counts the indices shared by two runs by merging them
+ *
+ * lhs: first sorted run
+ * lhsEnd: end of the first run
+ * rhs: second sorted run
+ * rhsEnd: end of the second run
+ */
+static size_t mergeCount(const uint32_t* lhs, const uint32_t* lhsEnd,
+                         const uint32_t* rhs, const uint32_t* rhsEnd) {
+    size_t count = 0;
+
+#ifdef __SSE2__
+    // Compare each block of four with every rotation of the other block.
+    // Neither run repeats an index, so each lane matches at most once
+    while (lhsEnd - lhs >= BLOCK && rhsEnd - rhs >= BLOCK) {
+        __m128i lhsBlock = _mm_loadu_si128((const __m128i*)lhs);
+        __m128i rhsBlock = _mm_loadu_si128((const __m128i*)rhs);
+
+        __m128i matches = _mm_cmpeq_epi32(lhsBlock, rhsBlock);
+        rhsBlock = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(0, 3, 2, 1));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(lhsBlock, rhsBlock));
+        rhsBlock = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(0, 3, 2, 1));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(lhsBlock, rhsBlock));
+        rhsBlock = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(0, 3, 2, 1));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(lhsBlock, rhsBlock));
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(matches)));
+
+        // Move past the block that ends first, or both if they end together
+        uint32_t lhsLast = lhs[BLOCK - 1];
+        uint32_t rhsLast = rhs[BLOCK - 1];
+        if (lhsLast <= rhsLast) {
+            lhs += BLOCK;
+        }
+        if (rhsLast <= lhsLast) {
+            rhs += BLOCK;
+        }
+    }
+#endif
+
+    // Merge whatever is left one index at a time
+    while (lhs != lhsEnd && rhs != rhsEnd) {
+        if (*lhs < *rhs) {
+            lhs++;
+        } else if (*rhs < *lhs) {
+            rhs++;
+        } else {
+            count++;
+            lhs++;
+            rhs++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Counts the indices of a short run found in a long one, galloping ahead in
+ * the long run for each index of the short one
+ *
+ * shortRun: shorter sorted run
+ * shortEnd: end of the shorter run
+ * longRun: longer sorted run
+ * longEnd: end of the longer run
+ */
+static size_t gallopCount(const uint32_t* shortRun, const uint32_t* shortEnd,
+                          const uint32_t* longRun, const uint32_t* longEnd) {
+    size_t count = 0;
+
+    for (; shortRun != shortEnd && longRun != longEnd; shortRun++) {
+        uint32_t target = *shortRun;
+
+        // Double the step until it passes the target, then search the last
+        // step for it
+        size_t step = 1;
+        const uint32_t* low = longRun;
+        while (step < (size_t)(longEnd - low) && low[step] < target) {
+            low += step;
+            step *= 2;
+        }
+        const uint32_t* high = low + min(step + 1, (size_t)(longEnd - low));
+        longRun = lower_bound(low, high, target);
+
+        if (longRun != longEnd && *longRun == target) {
+            count++;
+            longRun++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Returns the number of indices found in both of two sorted runs without
+ * repeats. Runs of similar size are merged four indices at a time with SIMD
+ * compares, and a run much shorter than the other is searched for in it by
+ * galloping, so the cost follows the shorter run
+ *
+ * lhs: first sorted run
+ * rhs: second sorted run
+ */
+size_t intersectCount(IdRange lhs, IdRange rhs) {
+    if (lhs.size() > rhs.size()) {
+        swap(lhs, rhs);
+    }
+    if (lhs.empty()) {
+        return 0;
+    }
+
+    if (rhs.size() / lhs.size() >= GALLOP_RATIO) {
+        return gallopCount(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    return mergeCount(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
@@ -0,0 +1,44 @@
+/*
+ * Intersection.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the sorted index intersections used to count the
+ * movies two actors share
+ */
+
+#ifndef INTERSECTION_HPP
+#define INTERSECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+/**
+ * Returns the number of indices found in both of two sorted runs without
+ * repeats. Runs of similar size are merged four indices at a time with SIMD
+ * compares, and a run much shorter than the other is searched for in it by
+ * galloping, so the cost follows the shorter run
+ *
+ * lhs: first sorted run
+ * rhs: second sorted run
+ */
+size_t intersectCount(IdRange lhs, IdRange rhs);
+
+/**
+ * Returns the number of movies two actors share
+ *
+ * actorGraph: graph of actor and movie nodes
+ * lhs: first actor
+ * rhs: second actor
+ */
+inline size_t sharedMovieCount(const ActorGraph& actorGraph,
+                               const ActorNode* lhs, const ActorNode* rhs) {
+    return intersectCount(actorGraph.getMovieIds(actorGraph, lhs),
+                          actorGraph.getMovieIds(actorGraph, rhs));
+}
+
+#endif  // INTERSECTION_HPP
@@ -0,0 +1,407 @@
+/*
+ * KShortestPaths.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that finds the k shortest loopless paths between two
+ * actors
+ */
+
+#include "KShortestPaths.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+#define LEFT_BRACKET "("
+#define RIGHT_BRACKET ")"
+#define LEFT_ARROW "--["
+#define MOVIE_DELIM "#@"
+#define RIGHT_ARROW "]-->"
+#define UNREACHED numeric_limits<int>::max()
+
+using namespace std;
+
+// Defines an actor waiting in the search queue
+struct SearchEntry {
+    // Distance from the source plus the estimate to the target
+    int estimate;
+
+    // Estimate to the target alone
+    int remaining;
+
+    // Actor waiting to be settled
+    ActorNode* actorNode;
+};
+
+// Comparator that sorts by lowest estimate, then by the actor closest to the
+// target, then by actor index
+struct SearchComparator {
+    bool operator()(const SearchEntry& lhs, const SearchEntry& rhs) const {
+        if (lhs.estimate != rhs.estimate) {
+            return lhs.estimate > rhs.estimate;
+        }
+        if (lhs.remaining != rhs.remaining) {
+            return lhs.remaining > rhs.remaining;
+        }
+        return lhs.actorNode->index > rhs.actorNode->index;
+    }
+};
+
+/**
+ * Returns whether two paths share the same actors and movies up to an actor
+ *
+ * lhs: first path
+ * rhs: second path
+ * last: index of the last actor compared
+ */
+static bool sameRoot(const ActorPath& lhs, const ActorPath& rhs, int last) {
+    return equal(lhs.actors.begin(), lhs.actors.begin() + last + 1,
+                 rhs.actors.begin()) &&
+           equal(lhs.movies.begin(), lhs.movies.begin() + last,
+                 rhs.movies.begin());
+}
+
+/**
+ * Constructor of a KShortestPaths over a graph
+ *
+ * actorGraph: graph to traverse
+ */
+KShortestPaths::KShortestPaths(ActorGraph& actorGraph)
+    : actorGraph(actorGraph),
+      pathFinder(actorGraph),
+      weighted(false),
+      weightShift(0) {}
+
+/**
+ * Makes room for actors and movies added since the last query and forgets the
+ * distances to the last final actor
+ */
+void KShortestPaths::reset() {
+    for (ActorNode* node : treeVect) {
+        toFinal[node->index] = UNREACHED;
+    }
+    treeVect.clear();
+
+    // Size the state to the graph, which may have grown
+    size_t actorCount = actorGraph.getNodeCount(actorGraph);
+    if (dist.size() < actorCount) {
+        toFinal.resize(actorCount, UNREACHED);
+        dist.resize(actorCount, UNREACHED);
+        prevMovie.resize(actorCount, nullptr);
+        prevActor.resize(actorCount, nullptr);
+        done.resize(actorCount, false);
+        blocked.resize(actorCount, false);
+    }
+
+    settled = 0;
+    relaxed = 0;
+    pushes = 0;
+    stalePops = 0;
+    touched = 0;
+}
+
+/**
+ * Resets the search fields of every actor touched by the last search
+ */
+void KShortestPaths::clearSearch() {
+    touched += resetVect.size();
+    for (ActorNode* node : resetVect) {
+        dist[node->index] = UNREACHED;
+        prevMovie[node->index] = nullptr;
+        prevActor[node->index] = nullptr;
+        done[node->index] = false;
+    }
+    resetVect.clear();
+}
+
+/**
+ * Returns the weight of a movie in the current query
+ *
+ * movieNode: movie to be weighed
+ */
+int KShortestPaths::weightOf(const MovieNode* movieNode) const {
+    return weighted ? movieNode->edgeWeight + weightShift : 1;
+}
+
+/**
+ * Searches from a source actor. Without a target, the search settles every
+ * reachable actor. With one, it is an A* search toward the target guided by
+ * toFinal that skips blocked actors, and the blocked edges leaving the source.
+ * Returns whether the target was reached
+ *
+ * source: actor to begin searching
+ * target: actor to find, or nullptr to settle every actor
+ * blockedEdges: movies and the actors they lead to that may not be taken from
+ * the source
+ */
+bool KShortestPaths::search(
+    ActorNode* source, ActorNode* target,
+    const vector<pair<MovieNode*, ActorNode*>>& blockedEdges) {
+    priority_queue<SearchEntry, vector<SearchEntry>, SearchComparator>
+        actorQueue;
+
+    // Without a target every estimate is zero, which makes this Dijkstra
+    int sourceRemaining = target != nullptr ? toFinal[source->index] : 0;
+    dist[source->index] = 0;
+    actorQueue.push({sourceRemaining, sourceRemaining, source});
+    resetVect.push_back(source);
+    pushes++;
+
+    while (!actorQueue.empty()) {
+        ActorNode* node = actorQueue.top().actorNode;
+        actorQueue.pop();
+
+        // Skip if node has already been settled
+        if (done[node->index]) {
+            stalePops++;
+            continue;
+        }
+        done[node->index] = true;
+        settled++;
+
+        // The estimates are exact lower bounds, so the target is settled at
+        // its shortest distance
+        if (node == target) {
+            return true;
+        }
+
+        int nodeDist = dist[node->index];
+
+        for (MovieNode* movieNode : moviesInWindow(node, searchWindow)) {
+            int newDist = nodeDist + weightOf(movieNode);
+            relaxed += movieNode->actorVect.size();
+
+            for (ActorNode* actorNode : movieNode->actorVect) {
+                int index = actorNode->index;
+                if (newDist >= dist[index] || blocked[index]) {
+                    continue;
+                }
+
+                // Actors that cannot reach the target are never queued
+                int remaining = 0;
+                if (target != nullptr) {
+                    remaining = toFinal[index];
+                    if (remaining == UNREACHED) {
+                        continue;
+                    }
+                }
+
+                // Edges of earlier paths that share this spur's root
+                if (node == source &&
+                    find(blockedEdges.begin(), blockedEdges.end(),
+                         make_pair(movieNode, actorNode)) !=
+                        blockedEdges.end()) {
+                    continue;
+                }
+
+                if (dist[index] == UNREACHED) {
+                    resetVect.push_back(actorNode);
+                }
+                dist[index] = newDist;
+                prevMovie[index] = movieNode;
+                prevActor[index] = node;
+                actorQueue.push({newDist + remaining, remaining, actorNode});
+                pushes++;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Finds up to k loopless paths from a given starting actor to a given ending
+ * actor, shortest first. Paths through different movies between the same
+ * actors are different paths
+ *
+ * firstActor: actor to begin searching
+ * finalActor: actor to find
+ * k: largest number of paths to find
+ * weighted: if true, weight each movie by its age, otherwise weights are 1
+ * window: years of the movies the paths may go through, with the same meaning
+ * as in PathFinder::shortestPath
+ * paths: filled in with the paths found
+ * stats: filled in with the work done by every search, or nullptr
+ */
+void KShortestPaths::kShortestPaths(ActorNode* firstActor,
+                                    ActorNode* finalActor, int k,
+                                    bool weighted, const YearWindow& window,
+                                    vector<ActorPath>& paths,
+                                    SearchStats* stats) {
+    if (stats != nullptr) {
+        stats->clear();
+    }
+    StatsTimer timer(stats);
+
+    paths.clear();
+    reset();
+
+    // Weigh movies the same way as PathFinder::shortestPath
+    this->weighted = weighted;
+    searchWindow = window;
+    if (weighted && window.refYear != CURR_YEAR &&
+        searchWindow.maxYear > window.refYear) {
+        searchWindow.maxYear = window.refYear;
+    }
+    weightShift = window.refYear - CURR_YEAR;
+
+    vector<pair<MovieNode*, ActorNode*>> blockedEdges;
+
+    if (firstActor != nullptr && finalActor != nullptr && k > 0) {
+        // Distance of every actor to the final actor. The graph is
+        // undirected, so this is a search from the final actor
+        search(finalActor, nullptr, blockedEdges);
+        for (ActorNode* node : resetVect) {
+            toFinal[node->index] = dist[node->index];
+        }
+        treeVect = resetVect;
+
+        clearSearch();
+
+        // The tree gives a shortest path too, but among paths of equal cost
+        // the first path must be the one pathfinder prints for k = 1
+        if (toFinal[firstActor->index] != UNREACHED) {
+            SearchStats firstStats;
+            pathFinder.shortestPath(firstActor, finalActor, weighted, window,
+                                    stats != nullptr ? &firstStats : nullptr);
+            settled += firstStats.settled;
+            relaxed += firstStats.relaxed;
+            pushes += firstStats.pushes;
+            stalePops += firstStats.stalePops;
+            touched += firstStats.touched;
+
+            ActorPath shortest;
+            shortest.cost = toFinal[firstActor->index];
+            shortest.deviation = 0;
+            pathFinder.pathTo(finalActor, firstActor, shortest.actors,
+                              shortest.movies);
+            paths.push_back(move(shortest));
+        }
+    }
+
+    // Paths found but not yet taken, in the order they were found
+    vector<ActorPath> candidates;
+
+    while (!paths.empty() && paths.size() < (size_t)k) {
+        size_t lastIndex = paths.size() - 1;
+
+        // Only the actors from where the last path deviated can spur paths
+        // that were not already found from the path before it
+        int rootCost = 0;
+        for (int j = 0; j < paths[lastIndex].deviation; j++) {
+            rootCost += weightOf(paths[lastIndex].movies[j]);
+        }
+
+        for (int j = paths[lastIndex].deviation;
+             j + 1 < (int)paths[lastIndex].actors.size(); j++) {
+            const ActorPath& last = paths[lastIndex];
+            ActorNode* spur = last.actors[j];
+
+            // Take out the next movie of every path with the same root
+            blockedEdges.clear();
+            for (const ActorPath& path : paths) {
+                if ((int)path.actors.size() > j + 1 &&
+                    sameRoot(path, last, j)) {
+                    blockedEdges.push_back(
+                        make_pair(path.movies[j], path.actors[j + 1]));
+                }
+            }
+
+            // Paths stay loopless by never going back through the root
+            for (int i = 0; i < j; i++) {
+                blocked[last.actors[i]->index] = true;
+            }
+
+            if (search(spur, finalActor, blockedEdges)) {
+                ActorPath candidate;
+                candidate.cost = rootCost + dist[finalActor->index];
+                candidate.deviation = j;
+
+                // Root of the last path, then the spur path walked back from
+                // the final actor
+                candidate.actors.assign(last.actors.begin(),
+                                        last.actors.begin() + j);
+                candidate.movies.assign(last.movies.begin(),
+                                        last.movies.begin() + j);
+                size_t spurStart = candidate.actors.size();
+                for (ActorNode* node = finalActor; node != spur;
+                     node = prevActor[node->index]) {
+                    candidate.actors.push_back(node);
+                    candidate.movies.push_back(prevMovie[node->index]);
+                }
+                candidate.actors.push_back(spur);
+                reverse(candidate.actors.begin() + spurStart,
+                        candidate.actors.end());
+                reverse(candidate.movies.begin() + spurStart,
+                        candidate.movies.end());
+
+                // Different spurs may find the same path
+                bool duplicate = false;
+                for (const ActorPath& other : candidates) {
+                    if (other.cost == candidate.cost &&
+                        other.actors == candidate.actors &&
+                        other.movies == candidate.movies) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+                if (!duplicate) {
+                    candidates.push_back(move(candidate));
+                }
+            }
+
+            for (int i = 0; i < j; i++) {
+                blocked[last.actors[i]->index] = false;
+            }
+            clearSearch();
+
+            rootCost += weightOf(last.movies[j]);
+        }
+
+        if (candidates.empty()) {
+            break;
+        }
+
+        // Take the cheapest candidate, the earliest found among equals
+        vector<ActorPath>::iterator best = min_element(
+            candidates.begin(), candidates.end(),
+            [](const ActorPath& lhs, const ActorPath& rhs) {
+                return lhs.cost < rhs.cost;
+            });
+        paths.push_back(move(*best));
+        candidates.erase(best);
+    }
+
+    if (stats != nullptr) {
+        stats->settled = settled;
+        stats->relaxed = relaxed;
+        stats->pushes = pushes;
+        stats->stalePops = stalePops;
+        stats->touched = touched;
+    }
+}
+
+/**
+ * Appends a path in the format (actor)--[movie#@year]-->(actor)--...
+ *
+ * out: string to append to
+ * path: path to be appended
+ */
+void KShortestPaths::appendPath(string& out, const ActorPath& path) {
+    for (size_t i = 0; i < path.actors.size(); i++) {
+        // Append the movie leading to this actor with its required format
+        if (i > 0) {
+            MovieNode* movieNode = path.movies[i - 1];
+            out += LEFT_ARROW;
+            out += movieNode->movieName;
+            out += MOVIE_DELIM;
+            out += to_string(movieNode->year);
+            out += RIGHT_ARROW;
+        }
+
+        // Append the actor's name with its required format
+        out += LEFT_BRACKET;
+        out += path.actors[i]->actorName;
+        out += RIGHT_BRACKET;
+    }
+}
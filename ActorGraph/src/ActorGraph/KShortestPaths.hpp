@@ -0,0 +1,165 @@
+/*
+ * KShortestPaths.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the k shortest loopless paths search used by
+ * pathfinder
+ */
+
+#ifndef KSHORTESTPATHS_HPP
+#define KSHORTESTPATHS_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "PathFinder.hpp"
+#include "SearchStats.hpp"
+
+using namespace std;
+
+// Defines a loopless path between two actors
+struct ActorPath {
+    // Actors on the path, from the first to the last
+    vector<ActorNode*> actors;
+
+    // Movie linking each actor to the next, one fewer than actors
+    vector<MovieNode*> movies;
+
+    // Total weight of the movies
+    int cost;
+
+    // Index of the actor where the path leaves the path it was found from
+    int deviation;
+};
+
+/**
+ * Class that finds the k shortest loopless paths between two actors with
+ * Yen's algorithm. A search from the final actor first gives every actor its
+ * exact distance to the final actor. Each spur path is then an A* search
+ * guided by those distances, so it follows the shortest-path tree and only
+ * expands the actors near the movies that were taken out, which makes each
+ * extra path much cheaper than a fresh search.
+ */
+class KShortestPaths {
+  private:
+    // Graph to be searched
+    ActorGraph& actorGraph;
+
+    // Search for the first path, so that among paths of equal cost it is the
+    // one PathFinder::shortestPath finds
+    PathFinder pathFinder;
+
+    // Distance of each actor to the final actor, indexed by actor index
+    vector<int> toFinal;
+
+    // Actors given a distance to the final actor by the current query
+    vector<ActorNode*> treeVect;
+
+    // Distance of each actor from the search source, indexed by actor index
+    vector<int> dist;
+
+    // Movie each actor was reached through, indexed by actor index
+    vector<MovieNode*> prevMovie;
+
+    // Actor each actor was reached from, indexed by actor index
+    vector<ActorNode*> prevActor;
+
+    // Whether each actor has been settled, indexed by actor index
+    vector<char> done;
+
+    // Whether each actor is on the root of the current spur, indexed by actor
+    // index
+    vector<char> blocked;
+
+    // Vector to reset the search fields of the actors a search touched
+    vector<ActorNode*> resetVect;
+
+    // Whether the current query weights movies by their age
+    bool weighted;
+
+    // Years the current query's movies are restricted to
+    YearWindow searchWindow;
+
+    // Shift of the weighted edges to the current query's reference year
+    int weightShift;
+
+    // Work done by the current query, kept in members so each search adds
+    // to them without testing for stats
+    long settled;
+    long relaxed;
+    long pushes;
+    long stalePops;
+    long touched;
+
+    /**
+     * Makes room for actors and movies added since the last query and
+     * forgets the distances to the last final actor
+     */
+    void reset();
+
+    /**
+     * Resets the search fields of every actor touched by the last search
+     */
+    void clearSearch();
+
+    /**
+     * Returns the weight of a movie in the current query
+     *
+     * movieNode: movie to be weighed
+     */
+    int weightOf(const MovieNode* movieNode) const;
+
+    /**
+     * Searches from a source actor. Without a target, the search settles
+     * every reachable actor. With one, it is an A* search toward the target
+     * guided by toFinal that skips blocked actors, and the blocked edges
+     * leaving the source. Returns whether the target was reached
+     *
+     * source: actor to begin searching
+     * target: actor to find, or nullptr to settle every actor
+     * blockedEdges: movies and the actors they lead to that may not be taken
+     * from the source
+     */
+    bool search(ActorNode* source, ActorNode* target,
+                const vector<pair<MovieNode*, ActorNode*>>& blockedEdges);
+
+  public:
+    /**
+     * Constructor of a KShortestPaths over a graph
+     *
+     * actorGraph: graph to traverse
+     */
+    KShortestPaths(ActorGraph& actorGraph);
+
+    /**
+     * Finds up to k loopless paths from a given starting actor to a given
+     * ending actor, shortest first. Paths through different movies between
+     * the same actors are different paths
+     *
+     * firstActor: actor to begin searching
+     * finalActor: actor to find
+     * k: largest number of paths to find
+     * weighted: if true, weight each movie by its age, otherwise weights are 1
+     * window: years of the movies the paths may go through, with the same
+     * meaning as in PathFinder::shortestPath
+     * paths: filled in with the paths found
+     * stats: filled in with the work done by every search, or nullptr
+     */
+    void kShortestPaths(ActorNode* firstActor, ActorNode* finalActor, int k,
+                        bool weighted, const YearWindow& window,
+                        vector<ActorPath>& paths,
+                        SearchStats* stats = nullptr);
+
+    /**
+     * Appends a path in the format (actor)--[movie#@year]-->(actor)--...
+     *
+     * out: string to append to
+     * path: path to be appended
+     */
+    static void appendPath(string& out, const ActorPath& path);
+};
+
+#endif  // KSHORTESTPATHS_HPP
@@ -0,0 +1,386 @@
+/*
+ * LinkPredictor.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that finds actors that have already collaborated with a
+ * given actor and actors that are likely to collaborate with this actor
+ */
+
+#include "LinkPredictor.hpp"
+#include <algorithm>
+#include <utility>
+
+#include "Intersection.hpp"
+
+#define TAB_CHAR '\t'
+#define FIRST_NEIGHBOR 1
+#define SECOND_NEIGHBOR 2
+
+using namespace std;
+
+/**
+ * Constructor of a LinkPredictor over a graph
+ *
+ * actorGraph: graph to search
+ */
+LinkPredictor::LinkPredictor(ActorGraph& actorGraph)
+    : actorGraph(actorGraph), skipHeavy(false) {}
+
+/**
+ * Resets the state of every actor touched by the last query and makes room for
+ * actors added since
+ */
+void LinkPredictor::reset() {
+    for (ActorNode* node : touchedVect) {
+        sharedCounts[node->index] = -1;
+        queryMovieCounts[node->index] = 0;
+        roles[node->index] = 0;
+    }
+    touchedVect.clear();
+
+    // Size the state to the graph, which may have grown
+    size_t actorCount = actorGraph.getNodeCount(actorGraph);
+    if (roles.size() < actorCount) {
+        sharedCounts.resize(actorCount, -1);
+        queryMovieCounts.resize(actorCount, 0);
+        roles.resize(actorCount, 0);
+    }
+}
+
+/**
+ * Returns the sorted indices of an actor's movies that count toward the
+ * scores: those in the window, and not heavy when heavy movies are skipped
+ *
+ * node: actor whose movies are returned
+ * window: years of the movies counted
+ */
+IdRange LinkPredictor::scoredMovieIds(const ActorNode* node,
+                                      const YearWindow& window) {
+    IdRange ids = actorGraph.getMovieIds(actorGraph, node);
+    if (window.isUnbounded() && !skipHeavy) {
+        return ids;
+    }
+
+    // Filtering the sorted run keeps it sorted
+    MovieRange movies = actorGraph.getMovies(actorGraph);
+    scoredIds.clear();
+    for (uint32_t id : ids) {
+        const MovieNode* movieNode = movies[id];
+        if (movieNode->year >= window.minYear &&
+            movieNode->year <= window.maxYear && !isSkipped(movieNode)) {
+            scoredIds.push_back(id);
+        }
+    }
+    return IdRange{scoredIds.data(), scoredIds.data() + scoredIds.size()};
+}
+
+/**
+ * Returns the number of movies an actor shares with the query's scored
+ * movies, counting each actor only once per query
+ *
+ * node: actor to be counted
+ * queryIds: scored movies of the query
+ */
+int LinkPredictor::sharedWithQuery(ActorNode* node, IdRange queryIds) {
+    int& shared = sharedCounts[node->index];
+    if (shared < 0) {
+        shared =
+            intersectCount(actorGraph.getMovieIds(actorGraph, node), queryIds);
+        touchedVect.push_back(node);
+    }
+    return shared;
+}
+
+/**
+ * Pops the highest priority distinct candidates into predictions. Returns the
+ * number of repeated candidates skipped
+ *
+ * bestPredictions: priority queue containing the candidates
+ * predictions: vector the candidates are added to
+ */
+long LinkPredictor::bestCandidates(
+    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
+                   PriorityComparator>& bestPredictions,
+    vector<ActorNode*>& predictions) {
+    long skipped = 0;
+
+    // Take 4 highest priority candidates or until queue empty
+    while (!bestPredictions.empty() && predictions.size() < MAX_CANDIDATES) {
+        ActorNode* node = bestPredictions.top().first;
+        bestPredictions.pop();
+
+        // Skip if node taken already
+        if (find(predictions.begin(), predictions.end(), node) !=
+            predictions.end()) {
+            skipped++;
+            continue;
+        }
+
+        predictions.push_back(node);
+    }
+
+    return skipped;
+}
+
+/**
+ * Finds the actors that have collaborated with a given actor, highest priority
+ * first. A candidate's priority sums, over each of its scored movies and each
+ * other actor in it, the number of scored movies that actor shares with the
+ * query
+ *
+ * query: actor to find collaborated actors
+ * predictions: vector the actors are added to
+ * window: years of the movies collaborations are counted in
+ * stats: filled in with the work done by the query, or nullptr
+ */
+void LinkPredictor::collaboratedActors(ActorNode* query,
+                                       vector<ActorNode*>& predictions,
+                                       const YearWindow& window,
+                                       SearchStats* stats) {
+    if (stats != nullptr) {
+        stats->clear();
+    }
+    StatsTimer timer(stats);
+
+    reset();
+
+    // Counters kept in locals so that the loops do not test for stats
+    long relaxed = 0;
+
+    // Declare queue for query neighbors
+    queue<ActorNode*> q;
+
+    // For every movie the actor is in, look at all of its actors
+    for (MovieNode* movieNode : moviesInWindow(query, window)) {
+        relaxed += movieNode->actorVect.size();
+        for (ActorNode* neighbor : movieNode->actorVect) {
+            // Skip if neighbor found is the query
+            if (neighbor == query) {
+                continue;
+            }
+
+            // Add valid nodes to queue
+            q.push(neighbor);
+        }
+    }
+
+    // Every neighbor is a candidate
+    long candidates = q.size();
+
+    // Movies of the query that count toward the scores
+    IdRange queryIds = scoredMovieIds(query, window);
+
+    // Priority queue for neighbors of query
+    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
+                   PriorityComparator>
+        bestPredictions;
+
+    // Loop until queue is empty
+    while (!q.empty()) {
+        ActorNode* candidate = q.front();
+        q.pop();
+
+        // Priority of candidate
+        int priority = 0;
+
+        // For each movie candidate actor is in, add the movies each of its
+        // other actors shares with the query
+        for (MovieNode* edgeOne : moviesInWindow(candidate, window)) {
+            if (isSkipped(edgeOne)) {
+                continue;
+            }
+            relaxed += edgeOne->actorVect.size();
+            for (ActorNode* commonNeighbor : edgeOne->actorVect) {
+                // Skip if the common neighbor is the candidate or the query
+                if (commonNeighbor == candidate || commonNeighbor == query) {
+                    continue;
+                }
+
+                priority += sharedWithQuery(commonNeighbor, queryIds);
+            }
+        }
+
+        // Push candidate to priority queue
+        bestPredictions.push(make_pair(candidate, priority));
+    }
+
+    // Every common neighbor was intersected once
+    long intersected = touchedVect.size();
+
+    long skipped = bestCandidates(bestPredictions, predictions);
+
+    if (stats != nullptr) {
+        stats->settled = candidates;
+        stats->relaxed = relaxed + intersected;
+
+        // Each candidate is pushed onto both queues
+        stats->pushes = 2 * candidates;
+        stats->stalePops = skipped;
+        stats->touched = candidates + intersected;
+    }
+}
+
+/**
+ * Finds the actors that have not yet collaborated with a given actor but are
+ * the most likely to, highest priority first. A candidate's priority sums,
+ * over each of the query's scored movies and each other actor in it, the
+ * number of scored movies that actor shares with the candidate
+ *
+ * query: actor to find uncollaborated actors
+ * predictions: vector the actors are added to
+ * window: years of the movies collaborations are counted in
+ * stats: filled in with the work done by the query, or nullptr
+ */
+void LinkPredictor::uncollaboratedActors(ActorNode* query,
+                                         vector<ActorNode*>& predictions,
+                                         const YearWindow& window,
+                                         SearchStats* stats) {
+    if (stats != nullptr) {
+        stats->clear();
+    }
+    StatsTimer timer(stats);
+
+    reset();
+
+    // Counters kept in locals so that the loops do not test for stats
+    long relaxed = 0;
+    long stalePops = 0;
+
+    // Queue for query second neighbors
+    queue<ActorNode*> q;
+
+    // For every movie query actor in, look at each of its actors
+    for (MovieNode* edgeOne : moviesInWindow(query, window)) {
+        relaxed += edgeOne->actorVect.size();
+        for (ActorNode* firstNeighbor : edgeOne->actorVect) {
+            // Skip if actor is the query actor
+            if (firstNeighbor == query) {
+                continue;
+            }
+
+            // A first neighbor stops being a second neighbor if it was one
+            char& role = roles[firstNeighbor->index];
+            if (role == 0) {
+                touchedVect.push_back(firstNeighbor);
+            }
+            role = FIRST_NEIGHBOR;
+
+            // A skipped movie still makes its cast first neighbors, but no
+            // second neighbors are found through it
+            if (isSkipped(edgeOne)) {
+                continue;
+            }
+
+            // For each movie the first neighbor is in, look at all of its
+            // actors
+            for (MovieNode* edgeTwo :
+                 moviesInWindow(firstNeighbor, window)) {
+                // Skip if first edge and second edge are the same
+                if (edgeTwo == edgeOne || isSkipped(edgeTwo)) {
+                    continue;
+                }
+
+                relaxed += edgeTwo->actorVect.size();
+                for (ActorNode* secondNeighbor : edgeTwo->actorVect) {
+                    // Skip if second neighbor is the first neighbor or the
+                    // query actor
+                    if (secondNeighbor == firstNeighbor ||
+                        secondNeighbor == query) {
+                        continue;
+                    }
+
+                    // Skip if already a first or second neighbor
+                    if (roles[secondNeighbor->index] != 0) {
+                        continue;
+                    }
+                    roles[secondNeighbor->index] = SECOND_NEIGHBOR;
+                    touchedVect.push_back(secondNeighbor);
+
+                    // Push to queue as a candidate
+                    q.push(secondNeighbor);
+                }
+            }
+        }
+    }
+
+    // Every second neighbor queued is a candidate
+    long candidates = q.size();
+
+    // Common neighbors in the query's scored movies, each listed once along
+    // with the number of those movies it is in
+    vector<ActorNode*> commonNeighbors;
+    for (MovieNode* edgeOne : moviesInWindow(query, window)) {
+        if (isSkipped(edgeOne)) {
+            continue;
+        }
+        relaxed += edgeOne->actorVect.size();
+        for (ActorNode* commonNeighbor : edgeOne->actorVect) {
+            if (commonNeighbor == query) {
+                continue;
+            }
+            if (queryMovieCounts[commonNeighbor->index]++ == 0) {
+                commonNeighbors.push_back(commonNeighbor);
+            }
+        }
+    }
+
+    // Priority queue for second neighors of query
+    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
+                   PriorityComparator>
+        bestPredictions;
+
+    // Loop until queue empty
+    while (!q.empty()) {
+        ActorNode* candidate = q.front();
+        q.pop();
+
+        // Check if second neighbor is still a second neighbor
+        if (roles[candidate->index] != SECOND_NEIGHBOR) {
+            stalePops++;
+            continue;
+        }
+
+        // Movies of the candidate that count toward the score
+        IdRange candidateIds = scoredMovieIds(candidate, window);
+
+        // Priority of candidate, from the movies each common neighbor shares
+        // with it, once for each of the query's movies the neighbor is in
+        int priority = 0;
+        for (ActorNode* commonNeighbor : commonNeighbors) {
+            priority += queryMovieCounts[commonNeighbor->index] *
+                        intersectCount(
+                            actorGraph.getMovieIds(actorGraph, commonNeighbor),
+                            candidateIds);
+        }
+        relaxed += commonNeighbors.size();
+
+        // Push candidate to priority queue
+        bestPredictions.push(make_pair(candidate, priority));
+    }
+
+    long scored = bestPredictions.size();
+    long skipped = bestCandidates(bestPredictions, predictions);
+
+    if (stats != nullptr) {
+        stats->settled = scored;
+        stats->relaxed = relaxed;
+        stats->pushes = candidates + scored;
+        stats->stalePops = stalePops + skipped;
+        stats->touched = candidates;
+    }
+}
+
+/**
+ * Appends each predicted actor's name followed by a tab
+ *
+ * out: string to append to
+ * predictions: actors to be appended
+ */
+void LinkPredictor::appendCandidates(string& out,
+                                     const vector<ActorNode*>& predictions) {
+    for (ActorNode* node : predictions) {
+        out += node->actorName;
+        out += TAB_CHAR;
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ * LinkPredictor.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the collaboration predictions used by linkpredictor and
+ * the query daemon
+ */
+
+#ifndef LINKPREDICTOR_HPP
+#define LINKPREDICTOR_HPP
+
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "SearchStats.hpp"
+
+using namespace std;
+
+// Number of candidates predicted for each query
+#define MAX_CANDIDATES 4
+
+/**
+ * Class that finds actors that have collaborated with a given actor and actors
+ * that are likely to collaborate with them. Scores count the movies actors
+ * share by intersecting their sorted movie indices. The state of a query is
+ * kept in the LinkPredictor and the graph is only read, so several
+ * LinkPredictors can search the same graph at once.
+ */
+class LinkPredictor {
+  private:
+    // Graph to be searched
+    ActorGraph& actorGraph;
+
+    // Whether heavy movies are left out of the scores
+    bool skipHeavy;
+
+    // Scored movies of the actor being scored against, when they are not
+    // all of its movies
+    vector<uint32_t> scoredIds;
+
+    // Number of scored movies each actor shares with the query, or -1 if not
+    // counted yet, indexed by actor index
+    vector<int> sharedCounts;
+
+    // Number of the query's scored movies each actor is in, indexed by actor
+    // index
+    vector<int> queryMovieCounts;
+
+    // Whether each actor is a first or second neighbor of the query, indexed
+    // by actor index
+    vector<char> roles;
+
+    // Actors whose state the current query set
+    vector<ActorNode*> touchedVect;
+
+    /**
+     * Resets the state of every actor touched by the last query and makes
+     * room for actors added since
+     */
+    void reset();
+
+    /**
+     * Returns the sorted indices of an actor's movies that count toward the
+     * scores: those in the window, and not heavy when heavy movies are
+     * skipped
+     *
+     * node: actor whose movies are returned
+     * window: years of the movies counted
+     */
+    IdRange scoredMovieIds(const ActorNode* node, const YearWindow& window);
+
+    /**
+     * Returns the number of movies an actor shares with the query's scored
+     * movies, counting each actor only once per query
+     *
+     * node: actor to be counted
+     * queryIds: scored movies of the query
+     */
+    int sharedWithQuery(ActorNode* node, IdRange queryIds);
+
+    /**
+     * Returns whether a movie is left out of the scores
+     *
+     * movieNode: movie to be checked
+     */
+    bool isSkipped(const MovieNode* movieNode) const {
+        return skipHeavy && movieNode->heavy;
+    }
+
+    /**
+     * Pops the highest priority distinct candidates into predictions. Returns
+     * the number of repeated candidates skipped
+     *
+     * bestPredictions: priority queue containing the candidates
+     * predictions: vector the candidates are added to
+     */
+    long bestCandidates(
+        priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
+                       PriorityComparator>& bestPredictions,
+        vector<ActorNode*>& predictions);
+
+  public:
+    /**
+     * Constructor of a LinkPredictor over a graph
+     *
+     * actorGraph: graph to search
+     */
+    LinkPredictor(ActorGraph& actorGraph);
+
+    /**
+     * Sets whether heavy movies are left out of the scores. A heavy cast
+     * links nearly everyone in it and says little about who works together,
+     * but scoring it costs the square of its size, so skipping it makes
+     * predictions much faster at the cost of exactness. Actors who shared a
+     * heavy movie with the query are still never predicted as
+     * uncollaborated. Off by default, which gives the exact predictions
+     *
+     * skip: if true, leave heavy movies out of the scores
+     */
+    void skipHeavyMovies(bool skip) { skipHeavy = skip; }
+
+    /**
+     * Finds the actors that have collaborated with a given actor, highest
+     * priority first
+     *
+     * query: actor to find collaborated actors
+     * predictions: vector the actors are added to
+     * window: years of the movies collaborations are counted in
+     * stats: filled in with the work done by the query, or nullptr
+     */
+    void collaboratedActors(ActorNode* query, vector<ActorNode*>& predictions,
+                            const YearWindow& window = YearWindow(),
+                            SearchStats* stats = nullptr);
+
+    /**
+     * Finds the actors that have not yet collaborated with a given actor but
+     * are the most likely to, highest priority first
+     *
+     * query: actor to find uncollaborated actors
+     * predictions: vector the actors are added to
+     * window: years of the movies collaborations are counted in
+     * stats: filled in with the work done by the query, or nullptr
+     */
+    void uncollaboratedActors(ActorNode* query,
+                              vector<ActorNode*>& predictions,
+                              const YearWindow& window = YearWindow(),
+                              SearchStats* stats = nullptr);
+
+    /**
+     * Appends each predicted actor's name followed by a tab
+     *
+     * out: string to append to
+     * predictions: actors to be appended
+     */
+    static void appendCandidates(string& out,
+                                 const vector<ActorNode*>& predictions);
+};
+
+#endif  // LINKPREDICTOR_HPP
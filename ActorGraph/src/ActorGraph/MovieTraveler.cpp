@@ -0,0 +1,592 @@
+/*
+ * MovieTraveler.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that finds each edge connection within the optimal path
+ * to connect all nodes based on their weight
+ */
+
+#include "MovieTraveler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#define LEFT_BRACKET "("
+#define LEFT_ARROW ")<--["
+#define MOVIE_DELIM "#@"
+#define RIGHT_ARROW "]-->("
+#define RIGHT_BRACKET ")"
+#define NODE_CONNECTED "#NODE CONNECTED: "
+#define EDGE_CHOSEN "#EDGE CHOSEN: "
+#define TOTAL_EDGE_WEIGHTS "TOTAL EDGE WEIGHTS: "
+#define ADDED_EDGE '+'
+#define REMOVED_EDGE '-'
+#define TAB_CHAR '\t'
+#define FOREST_HEADER "Actor\tMovie\tYear\tParent"
+#define FOREST_COLUMNS 4
+#define YEAR_COLUMN 2
+#define PARENT_COLUMN 3
+#define READ_FAILURE "Failed to read "
+#define WRITE_FAILURE "Failed to write "
+#define FAILURE_PUNCT "!\n"
+
+using namespace std;
+
+/**
+ * Constructor that initializes a disjoint set with every actor alone
+ *
+ * actorGraph: graph of actor and movie nodes
+ */
+DisjointSets::DisjointSets(const ActorGraph& actorGraph) {
+    int nodeCount = actorGraph.getNodeCount(actorGraph);
+
+    // Every actor starts as its own sentinel
+    parents.assign(nodeCount, -1);
+
+    // Initialize ranks vector to be same size as parents, filled with zeros
+    ranks.assign(nodeCount, 0);
+}
+
+/**
+ * Uses path compression to find the sentinel node's index of a given index
+ *
+ * a: index of node whose parent to be found
+ */
+int DisjointSets::find(int a) {
+    int sentinel = a;
+
+    // Traverse to parent
+    while (parents[sentinel] != -1) {
+        sentinel = parents[sentinel];
+    }
+
+    // Compress path
+    path_compression(a, sentinel);
+
+    // Return sentinel index
+    return sentinel;
+}
+
+/**
+ * Optimization that attaches each node along the path to the sentinel
+ *
+ * a: index of node that find was called on
+ * sentinel: parent node of the path
+ */
+void DisjointSets::path_compression(int a, int sentinel) {
+    // For each node on the path, attach to sentinel, walking the path a second
+    // time rather than recording it
+    while (a != sentinel) {
+        int parent = parents[a];
+        parents[a] = sentinel;
+        a = parent;
+    }
+}
+
+/**
+ * Attaches node of an index to another node of its index
+ *
+ * a: index of node
+ * b: index of another node
+ */
+void DisjointSets::sentinel_union(int a, int b) {
+    int sentinel_a = find(a);
+    int sentinel_b = find(b);
+
+    // Both sentinels not equal
+    if (sentinel_a != sentinel_b) {
+        // If b's rank higher, attach a to it
+        if (ranks[sentinel_a] < ranks[sentinel_b]) {
+            parents[sentinel_a] = sentinel_b;
+
+            // If a's rank higher, attach b to it
+        } else if (ranks[sentinel_a] > ranks[sentinel_b]) {
+            parents[sentinel_b] = sentinel_a;
+
+            // If both have same rank, attach a to b
+        } else {
+            parents[sentinel_a] = sentinel_b;
+            ranks[sentinel_b] += 1;
+        }
+    }
+}
+
+/**
+ * Creates a minimum spanning tree that connects all nodes in a graph
+ *
+ * actorGraph: graph of actor and movie nodes
+ * tree: spanning tree to be filled in
+ * stats: filled in with the work done, or nullptr. Pushes count the movies
+ * taken off the sorted edge list, and stale pops the actor pairs that were
+ * already connected
+ */
+void movieTraveler(ActorGraph& actorGraph, SpanningTree& tree,
+                   SearchStats* stats) {
+    if (stats != nullptr) {
+        stats->clear();
+    }
+    StatsTimer timer(stats);
+
+    // Disjoint sets of actors, keyed by actor index
+    DisjointSets ds(actorGraph);
+
+    // Number of actor nodes in graph
+    tree.nodesConnected = actorGraph.getNodeCount(actorGraph);
+
+    // Number of edges connected is the number of nodes minus 1
+    int allNodesConnected = tree.nodesConnected - 1;
+
+    tree.totalEdgeWeights = 0;
+    tree.edges.clear();
+
+    // Edges in graph, copied once from the view to be sorted
+    MovieRange movies = actorGraph.getMovies(actorGraph);
+    vector<MovieNode*> edgeVect(movies.begin(), movies.end());
+
+    // Sort edge vector by edgeWeight then by movie name
+    sort(edgeVect.begin(), edgeVect.end(), EdgeWeight());
+
+    int index = 0;
+
+    // Actor pairs examined, counted in a local so the loop does not test for
+    // stats
+    long relaxed = 0;
+
+    // Loop until all nodes are connected or there are no more edges
+    while ((tree.edges.size() != allNodesConnected) &&
+           (index < edgeVect.size())) {
+        // Find movie at index
+        MovieNode* movie = edgeVect[index];
+
+        // Increment
+        index++;
+        relaxed += movie->actorVect.size() * movie->actorVect.size();
+
+        // For both actors being connected by the movie
+        for (ActorNode* actorNodeOne : movie->actorVect) {
+            for (ActorNode* actorNodeTwo : movie->actorVect) {
+                // Find index of sentinel for first actor
+                int sentinel_a = ds.find(actorNodeOne->index);
+
+                // FInd index of sentinel for second actor
+                int sentinel_b = ds.find(actorNodeTwo->index);
+
+                // If they are not the same sentinel, union them
+                if (sentinel_a != sentinel_b) {
+                    // Union them together
+                    ds.sentinel_union(sentinel_a, sentinel_b);
+
+                    // Add to the total edge weight of MST
+                    tree.totalEdgeWeights += movie->edgeWeight;
+
+                    // Record movie and its two actors
+                    tree.edges.push_back({actorNodeOne, movie, actorNodeTwo});
+                }
+            }
+        }
+    }
+
+    if (stats != nullptr) {
+        stats->settled = tree.edges.size();
+        stats->relaxed = relaxed;
+        stats->pushes = index;
+        stats->stalePops = relaxed - tree.edges.size();
+        stats->touched = tree.nodesConnected;
+    }
+}
+
+/**
+ * Constructor of an empty forest over a graph
+ *
+ * actorGraph: graph the forest spans
+ */
+SpanningForest::SpanningForest(const ActorGraph& actorGraph)
+    : actorGraph(actorGraph),
+      sets(actorGraph),
+      mark(0),
+      edgeCount(0),
+      totalEdgeWeights(0),
+      walked(0) {
+    grow();
+}
+
+/**
+ * Leaves every actor of the graph alone in its tree
+ */
+void SpanningForest::clear() {
+    size_t actorCount = actorGraph.getNodeCount(actorGraph);
+    parents.assign(actorCount, -1);
+    parentMovies.assign(actorCount, nullptr);
+    sets.parents.assign(actorCount, -1);
+    sets.ranks.assign(actorCount, 0);
+    marks.assign(actorCount, 0);
+    mark = 0;
+    edgeCount = 0;
+    totalEdgeWeights = 0;
+}
+
+/**
+ * Makes room for actors added to the graph since, each alone in its tree
+ */
+void SpanningForest::grow() {
+    size_t actorCount = actorGraph.getNodeCount(actorGraph);
+    parents.resize(actorCount, -1);
+    parentMovies.resize(actorCount, nullptr);
+    sets.parents.resize(actorCount, -1);
+    sets.ranks.resize(actorCount, 0);
+    marks.resize(actorCount, 0);
+}
+
+/**
+ * Makes an actor the root of its tree by reversing the path to the old root
+ *
+ * a: index of the actor
+ */
+void SpanningForest::makeRoot(int a) {
+    int child = -1;
+    MovieNode* childMovie = nullptr;
+
+    // Point each actor on the path at the one below it
+    while (a != -1) {
+        walked++;
+        int parent = parents[a];
+        MovieNode* parentMovie = parentMovies[a];
+        parents[a] = child;
+        parentMovies[a] = childMovie;
+        child = a;
+        childMovie = parentMovie;
+        a = parent;
+    }
+}
+
+/**
+ * Adds an edge to the forest if it links two trees or is lighter than the
+ * heaviest edge on the path it closes, which is then removed
+ *
+ * actorNodeOne: actor the edge starts from
+ * movie: movie connecting the two actors
+ * actorNodeTwo: actor the edge ends at
+ * changes: vector the edges added and removed are appended to
+ */
+void SpanningForest::addEdge(ActorNode* actorNodeOne, MovieNode* movie,
+                             ActorNode* actorNodeTwo,
+                             vector<TreeChange>& changes) {
+    int one = actorNodeOne->index;
+    int two = actorNodeTwo->index;
+    int sentinel_one = sets.find(one);
+    int sentinel_two = sets.find(two);
+
+    // An edge between two trees always joins the forest
+    if (sentinel_one != sentinel_two) {
+        sets.sentinel_union(sentinel_one, sentinel_two);
+        makeRoot(one);
+        parents[one] = two;
+        parentMovies[one] = movie;
+        edgeCount++;
+        totalEdgeWeights += movie->edgeWeight;
+        changes.push_back({true, {actorNodeOne, movie, actorNodeTwo}});
+        return;
+    }
+
+    // Mark the path from the first actor to its root
+    mark++;
+    for (int a = one; a != -1; a = parents[a]) {
+        marks[a] = mark;
+        walked++;
+    }
+
+    // Find the heaviest edge on each side of the path up to where the two
+    // walks meet. Ties keep the edges already in the forest
+    int heaviest = -1;
+    int heaviestWeight = movie->edgeWeight;
+    bool heaviestOnOne = false;
+    int meet = two;
+    for (; marks[meet] != mark; meet = parents[meet]) {
+        walked++;
+        if (parentMovies[meet]->edgeWeight > heaviestWeight) {
+            heaviest = meet;
+            heaviestWeight = parentMovies[meet]->edgeWeight;
+        }
+    }
+    for (int a = one; a != meet; a = parents[a]) {
+        if (parentMovies[a]->edgeWeight > heaviestWeight) {
+            heaviest = a;
+            heaviestWeight = parentMovies[a]->edgeWeight;
+            heaviestOnOne = true;
+        }
+    }
+
+    // The new edge is the heaviest on the cycle it closes
+    if (heaviest == -1) {
+        return;
+    }
+
+    // Cut the heaviest edge, leaving one of the two actors below the cut
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    changes.push_back({false,
+                       {actors[heaviest], parentMovies[heaviest],
+                        actors[parents[heaviest]]}});
+    totalEdgeWeights -= heaviestWeight;
+    parents[heaviest] = -1;
+    parentMovies[heaviest] = nullptr;
+
+    // Hang the part below the cut from the other actor by the new edge
+    int below = heaviestOnOne ? one : two;
+    int above = heaviestOnOne ? two : one;
+    makeRoot(below);
+    parents[below] = above;
+    parentMovies[below] = movie;
+    totalEdgeWeights += movie->edgeWeight;
+    changes.push_back({true, {actors[below], movie, actors[above]}});
+}
+
+/**
+ * Builds the forest from a spanning tree of the whole graph
+ *
+ * tree: spanning tree found by movieTraveler
+ */
+void SpanningForest::build(const SpanningTree& tree) {
+    clear();
+    size_t actorCount = actorGraph.getNodeCount(actorGraph);
+
+    // Neighbors of each actor in the tree, with the movie linking them
+    vector<vector<pair<int, MovieNode*>>> neighbors(actorCount);
+    for (const TreeEdge& edge : tree.edges) {
+        int one = edge.actorNodeOne->index;
+        int two = edge.actorNodeTwo->index;
+        neighbors[one].push_back(make_pair(two, edge.movie));
+        neighbors[two].push_back(make_pair(one, edge.movie));
+        sets.sentinel_union(one, two);
+    }
+
+    // Point every actor at its parent from the first actor of each tree,
+    // marking actors as they are reached
+    mark++;
+    vector<int> order;
+    for (size_t root = 0; root < actorCount; root++) {
+        if (marks[root] == mark) {
+            continue;
+        }
+        marks[root] = mark;
+        order.assign(1, root);
+        for (size_t head = 0; head < order.size(); head++) {
+            int a = order[head];
+            for (pair<int, MovieNode*>& neighbor : neighbors[a]) {
+                if (marks[neighbor.first] != mark) {
+                    marks[neighbor.first] = mark;
+                    parents[neighbor.first] = a;
+                    parentMovies[neighbor.first] = neighbor.second;
+                    order.push_back(neighbor.first);
+                }
+            }
+        }
+    }
+
+    edgeCount = tree.edges.size();
+    totalEdgeWeights = tree.totalEdgeWeights;
+}
+
+/**
+ * Updates the forest with links added to the graph, such as those of
+ * getAppendedLinks. An actor joining a cast is linked to the first actor of
+ * the cast only, since the cast was already connected by edges of the same
+ * weight
+ *
+ * links: actors and the movies they were added to
+ * changes: filled in with the edges added and removed, in order
+ * stats: filled in with the work done, or nullptr. Settled counts the edges
+ * added, relaxed the links, pushes the edges tried, stale pops those left
+ * out, and touched the actors walked over
+ */
+void SpanningForest::addLinks(
+    const vector<pair<ActorNode*, MovieNode*>>& links,
+    vector<TreeChange>& changes, SearchStats* stats) {
+    if (stats != nullptr) {
+        stats->clear();
+    }
+    StatsTimer timer(stats);
+
+    changes.clear();
+    grow();
+    walked = 0;
+
+    long edges = 0;
+    for (const pair<ActorNode*, MovieNode*>& link : links) {
+        ActorNode* first = castOf(link.second)[0];
+        if (first != link.first) {
+            addEdge(link.first, link.second, first, changes);
+            edges++;
+        }
+    }
+
+    if (stats != nullptr) {
+        long added = 0;
+        for (const TreeChange& change : changes) {
+            added += change.added;
+        }
+        stats->settled = added;
+        stats->relaxed = links.size();
+        stats->pushes = edges;
+        stats->stalePops = edges - added;
+        stats->touched = walked;
+    }
+}
+
+/**
+ * Reads a forest written by save. Returns false if the file cannot be read or
+ * names an actor or movie that is not in the graph
+ *
+ * in_filename: forest filename
+ */
+bool SpanningForest::load(const char* in_filename) {
+    ifstream infile(in_filename);
+    string line;
+    if (!getline(infile, line)) {
+        cerr << READ_FAILURE << in_filename << FAILURE_PUNCT;
+        return false;
+    }
+
+    // Start from every actor alone
+    clear();
+
+    vector<NameKey> fields;
+    while (getline(infile, line)) {
+        // Split the row into views of its fields
+        fields.clear();
+        size_t begin = 0;
+        for (size_t end; (end = line.find(TAB_CHAR, begin)) != string::npos;
+             begin = end + 1) {
+            fields.push_back(NameKey(line.data() + begin, end - begin));
+        }
+        fields.push_back(NameKey(line.data() + begin, line.size() - begin));
+        if (fields.size() != FOREST_COLUMNS) {
+            cerr << READ_FAILURE << in_filename << FAILURE_PUNCT;
+            return false;
+        }
+
+        string year(fields[YEAR_COLUMN].data, fields[YEAR_COLUMN].size);
+        ActorNode* actorNode = actorGraph.get(actorGraph, fields[0]);
+        MovieNode* movie = actorGraph.getMovie(
+            actorGraph, MovieKey(fields[1], atoi(year.c_str())));
+        ActorNode* parent = actorGraph.get(actorGraph, fields[PARENT_COLUMN]);
+        if (actorNode == nullptr || movie == nullptr || parent == nullptr) {
+            cerr << READ_FAILURE << in_filename << FAILURE_PUNCT;
+            return false;
+        }
+
+        parents[actorNode->index] = parent->index;
+        parentMovies[actorNode->index] = movie;
+        sets.sentinel_union(actorNode->index, parent->index);
+        edgeCount++;
+        totalEdgeWeights += movie->edgeWeight;
+    }
+
+    return true;
+}
+
+/**
+ * Writes the forest as a tab-delimited file of each actor with a parent, the
+ * movie linking them, and the parent
+ *
+ * out_filename: forest filename
+ */
+bool SpanningForest::save(const char* out_filename) const {
+    ofstream outfile(out_filename);
+    outfile << FOREST_HEADER << '\n';
+
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    string row;
+    for (size_t a = 0; a < parents.size(); a++) {
+        if (parents[a] == -1) {
+            continue;
+        }
+        row.assign(actors[a]->actorName);
+        row += TAB_CHAR;
+        row += parentMovies[a]->movieName;
+        row += TAB_CHAR;
+        row += to_string(parentMovies[a]->year);
+        row += TAB_CHAR;
+        row += actors[parents[a]]->actorName;
+        row += '\n';
+        outfile.write(row.data(), row.size());
+    }
+
+    outfile.close();
+    if (!outfile) {
+        cerr << WRITE_FAILURE << out_filename << FAILURE_PUNCT;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Appends an edge of the spanning tree in the format
+ * (actor)<--[movie#@year]-->(actor)
+ *
+ * out: string to append to
+ * edge: edge to be appended
+ */
+void appendTreeEdge(string& out, const TreeEdge& edge) {
+    out += LEFT_BRACKET;
+    out += edge.actorNodeOne->actorName;
+    out += LEFT_ARROW;
+    out += edge.movie->movieName;
+    out += MOVIE_DELIM;
+    out += to_string(edge.movie->year);
+    out += RIGHT_ARROW;
+    out += edge.actorNodeTwo->actorName;
+    out += RIGHT_BRACKET;
+}
+
+/**
+ * Appends the number of nodes connected, number of edges chosen, and total
+ * edge weight of a spanning tree, one per line
+ *
+ * out: string to append to
+ * tree: spanning tree to be summarized
+ */
+void appendTreeTotals(string& out, const SpanningTree& tree) {
+    out += NODE_CONNECTED;
+    out += to_string(tree.nodesConnected);
+    out += '\n';
+    out += EDGE_CHOSEN;
+    out += to_string(tree.edges.size());
+    out += '\n';
+    out += TOTAL_EDGE_WEIGHTS;
+    out += to_string(tree.totalEdgeWeights);
+    out += '\n';
+}
+
+/**
+ * Appends a change to a spanning forest, the edge in the format of
+ * appendTreeEdge after a '+' if it was added or a '-' if it was removed
+ *
+ * out: string to append to
+ * change: change to be appended
+ */
+void appendTreeChange(string& out, const TreeChange& change) {
+    out += change.added ? ADDED_EDGE : REMOVED_EDGE;
+    appendTreeEdge(out, change.edge);
+}
+
+/**
+ * Appends the number of nodes connected, number of edges chosen, and total
+ * edge weight of a spanning forest, one per line as appendTreeTotals does
+ *
+ * out: string to append to
+ * actorGraph: graph the forest spans
+ * forest: spanning forest to be summarized
+ */
+void appendForestTotals(string& out, const ActorGraph& actorGraph,
+                        const SpanningForest& forest) {
+    out += NODE_CONNECTED;
+    out += to_string(actorGraph.getNodeCount(actorGraph));
+    out += '\n';
+    out += EDGE_CHOSEN;
+    out += to_string(forest.getEdgeCount());
+    out += '\n';
+    out += TOTAL_EDGE_WEIGHTS;
+    out += to_string(forest.getTotalEdgeWeights());
+    out += '\n';
+}
@@ -0,0 +1,269 @@
+/*
+ * MovieTraveler.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the minimum spanning tree used by movietraveler and the
+ * query daemon
+ */
+
+#ifndef MOVIETRAVELER_HPP
+#define MOVIETRAVELER_HPP
+
+#include <string>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "SearchStats.hpp"
+
+using namespace std;
+
+// Struct defining a disjoint set that utilizes find and union, over actors
+// keyed by their index
+struct DisjointSets {
+    // Union by height
+    vector<int> ranks;
+
+    // Parent index of each actor index, or -1 for a sentinel
+    vector<int> parents;
+
+    /**
+     * Constructor that initializes a disjoint set with every actor alone
+     *
+     * actorGraph: graph of actor and movie nodes
+     */
+    explicit DisjointSets(const ActorGraph& actorGraph);
+
+    /**
+     * Uses path compression to find the sentinel node's index of a given index
+     *
+     * a: index of node whose parent to be found
+     */
+    int find(int a);
+
+    /**
+     * Optimization that attaches each node along the path to the sentinel
+     *
+     * a: index of node that find was called on
+     * sentinel: parent node of the path
+     */
+    void path_compression(int a, int sentinel);
+
+    /**
+     * Attaches node of an index to another node of its index
+     *
+     * a: index of node
+     * b: index of another node
+     */
+    void sentinel_union(int a, int b);
+};
+
+// Defines an edge chosen for the minimum spanning tree
+struct TreeEdge {
+    // Actor the edge starts from
+    ActorNode* actorNodeOne;
+
+    // Movie connecting the two actors
+    MovieNode* movie;
+
+    // Actor the edge ends at
+    ActorNode* actorNodeTwo;
+};
+
+// Defines the minimum spanning tree of a graph
+struct SpanningTree {
+    // Edges chosen, in the order they were chosen
+    vector<TreeEdge> edges;
+
+    // Number of actor nodes connected
+    int nodesConnected;
+
+    // Keeps track of total edge weight of MST
+    int totalEdgeWeights;
+};
+
+// Defines an edge added to or removed from a spanning forest
+struct TreeChange {
+    // Whether the edge was added, otherwise it was removed
+    bool added;
+
+    // Edge that changed
+    TreeEdge edge;
+};
+
+/**
+ * Class that keeps a minimum spanning forest up to date as links are added to
+ * the graph, so a daily refresh costs time in the new links instead of the
+ * whole graph. Each actor points to its parent in its tree through a movie,
+ * and a new edge within a tree replaces the heaviest edge on the path it
+ * closes if it is lighter. Each edge walks the paths to the root, so it costs
+ * time in the depth of its tree. Trees are built breadth first and the actor
+ * graph is a small world, which keeps them shallow.
+ */
+class SpanningForest {
+  private:
+    // Graph the forest spans
+    const ActorGraph& actorGraph;
+
+    // Parent of each actor in its tree, or -1 for a root, indexed by actor
+    // index
+    vector<int> parents;
+
+    // Movie linking each actor to its parent, indexed by actor index
+    vector<MovieNode*> parentMovies;
+
+    // Trees of the forest, so an edge between two trees links them without
+    // walking either
+    DisjointSets sets;
+
+    // Stamp of the last walk that reached each actor, indexed by actor index
+    vector<int> marks;
+    int mark;
+
+    // Number of edges in the forest
+    int edgeCount;
+
+    // Total edge weight of the forest
+    int totalEdgeWeights;
+
+    // Number of actors walked over by the updates, for their stats
+    long walked;
+
+    /**
+     * Leaves every actor of the graph alone in its tree
+     */
+    void clear();
+
+    /**
+     * Makes room for actors added to the graph since, each alone in its tree
+     */
+    void grow();
+
+    /**
+     * Makes an actor the root of its tree by reversing the path to the old
+     * root
+     *
+     * a: index of the actor
+     */
+    void makeRoot(int a);
+
+    /**
+     * Adds an edge to the forest if it links two trees or is lighter than the
+     * heaviest edge on the path it closes, which is then removed
+     *
+     * actorNodeOne: actor the edge starts from
+     * movie: movie connecting the two actors
+     * actorNodeTwo: actor the edge ends at
+     * changes: vector the edges added and removed are appended to
+     */
+    void addEdge(ActorNode* actorNodeOne, MovieNode* movie,
+                 ActorNode* actorNodeTwo, vector<TreeChange>& changes);
+
+  public:
+    /**
+     * Constructor of an empty forest over a graph
+     *
+     * actorGraph: graph the forest spans
+     */
+    explicit SpanningForest(const ActorGraph& actorGraph);
+
+    /**
+     * Builds the forest from a spanning tree of the whole graph
+     *
+     * tree: spanning tree found by movieTraveler
+     */
+    void build(const SpanningTree& tree);
+
+    /**
+     * Updates the forest with links added to the graph, such as those of
+     * getAppendedLinks. An actor joining a cast is linked to the first actor
+     * of the cast only, since the cast was already connected by edges of the
+     * same weight
+     *
+     * links: actors and the movies they were added to
+     * changes: filled in with the edges added and removed, in order
+     * stats: filled in with the work done, or nullptr. Settled counts the
+     * edges added, relaxed the links, pushes the edges tried, stale pops
+     * those left out, and touched the actors walked over
+     */
+    void addLinks(const vector<pair<ActorNode*, MovieNode*>>& links,
+                  vector<TreeChange>& changes, SearchStats* stats = nullptr);
+
+    /**
+     * Reads a forest written by save. Returns false if the file cannot be
+     * read or names an actor or movie that is not in the graph
+     *
+     * in_filename: forest filename
+     */
+    bool load(const char* in_filename);
+
+    /**
+     * Writes the forest as a tab-delimited file of each actor with a parent,
+     * the movie linking them, and the parent
+     *
+     * out_filename: forest filename
+     */
+    bool save(const char* out_filename) const;
+
+    /**
+     * Returns the number of edges in the forest
+     */
+    int getEdgeCount() const { return edgeCount; }
+
+    /**
+     * Returns the total edge weight of the forest
+     */
+    int getTotalEdgeWeights() const { return totalEdgeWeights; }
+};
+
+/**
+ * Creates a minimum spanning tree that connects all nodes in a graph
+ *
+ * actorGraph: graph of actor and movie nodes
+ * tree: spanning tree to be filled in
+ * stats: filled in with the work done, or nullptr. Pushes count the movies
+ * taken off the sorted edge list, and stale pops the actor pairs that were
+ * already connected
+ */
+void movieTraveler(ActorGraph& actorGraph, SpanningTree& tree,
+                   SearchStats* stats = nullptr);
+
+/**
+ * Appends an edge of the spanning tree in the format
+ * (actor)<--[movie#@year]-->(actor)
+ *
+ * out: string to append to
+ * edge: edge to be appended
+ */
+void appendTreeEdge(string& out, const TreeEdge& edge);
+
+/**
+ * Appends the number of nodes connected, number of edges chosen, and total
+ * edge weight of a spanning tree, one per line
+ *
+ * out: string to append to
+ * tree: spanning tree to be summarized
+ */
+void appendTreeTotals(string& out, const SpanningTree& tree);
+
+/**
+ * Appends a change to a spanning forest, the edge in the format of
+ * appendTreeEdge after a '+' if it was added or a '-' if it was removed
+ *
+ * out: string to append to
+ * change: change to be appended
+ */
+void appendTreeChange(string& out, const TreeChange& change);
+
+/**
+ * Appends the number of nodes connected, number of edges chosen, and total
+ * edge weight of a spanning forest, one per line as appendTreeTotals does
+ *
+ * out: string to append to
+ * actorGraph: graph the forest spans
+ * forest: spanning forest to be summarized
+ */
+void appendForestTotals(string& out, const ActorGraph& actorGraph,
+                        const SpanningForest& forest);
+
+#endif  // MOVIETRAVELER_HPP
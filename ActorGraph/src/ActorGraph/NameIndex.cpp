@@ -0,0 +1,267 @@
+/*
+ * NameIndex.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file for the trigram index that resolves misspelled actor
+ * names
+ */
+
+#include "NameIndex.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+
+// Character the names are padded with, so their first and last characters
+// are in three pieces like the others
+#define PAD_CHAR 0
+
+// Number of pad characters at each end of a name
+#define PAD_LENGTH 2
+
+// Bits of the three characters of a piece packed into an integer
+#define GRAM_MASK 0xFFFFFF
+
+// Number of pieces one edit can change
+#define GRAMS_PER_EDIT 3
+
+using namespace std;
+
+/**
+ * Returns a character lowercased, leaving bytes outside ASCII as they are
+ *
+ * c: character to be lowercased
+ */
+static inline char lower(char c) { return (char)tolower((unsigned char)c); }
+
+/**
+ * Constructor that indexes the names of every actor in a graph
+ *
+ * actorGraph: graph whose actors are indexed
+ */
+NameIndex::NameIndex(ActorGraph& actorGraph) : actorGraph(actorGraph) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    vector<uint32_t> grams;
+
+    // Count the actors with each piece, numbering the pieces as they are
+    // first seen
+    vector<uint32_t> counts;
+    for (ActorNode* node : actors) {
+        grams.clear();
+        appendTrigrams(node->actorName, grams);
+        for (uint32_t gram : grams) {
+            auto found = lists.emplace(gram, (uint32_t)counts.size());
+            if (found.second) {
+                counts.push_back(0);
+            }
+            counts[found.first->second]++;
+        }
+    }
+
+    listOffsets.assign(counts.size() + 1, 0);
+    for (size_t i = 0; i < counts.size(); i++) {
+        listOffsets[i + 1] = listOffsets[i] + counts[i];
+    }
+
+    // Fill each list in actor order, which keeps it sorted
+    postings.resize(listOffsets.back());
+    vector<uint32_t> fill(listOffsets.begin(), listOffsets.end() - 1);
+    for (ActorNode* node : actors) {
+        grams.clear();
+        appendTrigrams(node->actorName, grams);
+        for (uint32_t gram : grams) {
+            postings[fill[lists[gram]]++] = node->index;
+        }
+    }
+
+    listCounts.assign(actors.size(), 0);
+}
+
+/**
+ * Appends the distinct pieces of a name, lowercased and padded at both ends,
+ * in increasing order
+ *
+ * name: name to be split
+ * grams: vector the pieces are appended to
+ */
+void NameIndex::appendTrigrams(const string& name, vector<uint32_t>& grams) {
+    size_t first = grams.size();
+
+    // The piece starts out as the front padding, and each character shifted
+    // in ends a piece, the back padding included
+    uint32_t gram = PAD_CHAR;
+    for (size_t i = 0; i < name.size() + PAD_LENGTH; i++) {
+        unsigned char c =
+            i < name.size() ? (unsigned char)lower(name[i]) : PAD_CHAR;
+        gram = ((gram << 8) | c) & GRAM_MASK;
+        grams.push_back(gram);
+    }
+
+    sort(grams.begin() + first, grams.end());
+    grams.erase(unique(grams.begin() + first, grams.end()), grams.end());
+}
+
+/**
+ * Returns the edit distance between two names ignoring case, or maxEdits + 1
+ * if it is more than maxEdits. Only the cells within maxEdits of the diagonal
+ * are filled in
+ *
+ * query: lowercased query name
+ * name: name to be compared
+ * maxEdits: largest distance counted
+ */
+int NameIndex::boundedDistance(const string& query, const string& name,
+                               int maxEdits) {
+    int n = query.size();
+    int m = name.size();
+    int tooFar = maxEdits + 1;
+    if (abs(n - m) > maxEdits) {
+        return tooFar;
+    }
+
+    // Distances of the previous and current rows, with the cells just
+    // outside the band set to tooFar
+    vector<int>& prev = prevRow;
+    vector<int>& cur = curRow;
+    prev.assign(m + 2, tooFar);
+    cur.assign(m + 2, tooFar);
+    for (int j = 0; j <= min(m, maxEdits); j++) {
+        prev[j] = j;
+    }
+
+    for (int i = 1; i <= n; i++) {
+        int lo = max(1, i - maxEdits);
+        int hi = min(m, i + maxEdits);
+        cur[lo - 1] = lo == 1 ? min(i, tooFar) : tooFar;
+        int rowMin = cur[lo - 1];
+
+        for (int j = lo; j <= hi; j++) {
+            int cost = query[i - 1] == lower(name[j - 1]) ? 0 : 1;
+            int best = min(prev[j - 1] + cost, min(prev[j], cur[j - 1]) + 1);
+            cur[j] = min(best, tooFar);
+            rowMin = min(rowMin, cur[j]);
+        }
+        cur[hi + 1] = tooFar;
+
+        // Every later row is at least this far
+        if (rowMin > maxEdits) {
+            return tooFar;
+        }
+        swap(prev, cur);
+    }
+
+    return prev[m];
+}
+
+/**
+ * Finds the actors whose names are within maxEdits edits of a query, closest
+ * first, then those in the most movies, then by name
+ *
+ * name: name to be matched
+ * matches: vector the matches are added to
+ * maxEdits: largest edit distance matched
+ * maxMatches: largest number of matches added
+ */
+void NameIndex::findNames(const string& name, vector<NameMatch>& matches,
+                          int maxEdits, size_t maxMatches) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    maxEdits = max(maxEdits, 0);
+
+    string query(name);
+    transform(query.begin(), query.end(), query.begin(), lower);
+
+    vector<uint32_t> grams;
+    appendTrigrams(query, grams);
+
+    // Matches found, before they are ranked
+    vector<NameMatch> found;
+    auto check = [&](uint32_t id) {
+        ActorNode* node = actors[id];
+        int distance = boundedDistance(query, node->actorName, maxEdits);
+        if (distance <= maxEdits) {
+            found.push_back(NameMatch{node, distance});
+        }
+    };
+
+    // A close name may miss GRAMS_PER_EDIT pieces per edit, so it must be in
+    // all but that many of the lists read
+    size_t missable = (size_t)GRAMS_PER_EDIT * maxEdits;
+    size_t needed = missable + 1;
+    if (grams.size() < needed || needed + FUZZY_EXTRA_LISTS > UINT8_MAX) {
+        // A short query may share no piece with a close name, and the counts
+        // only reach so far, so every name is checked
+        for (size_t id = 0; id < listCounts.size(); id++) {
+            check(id);
+        }
+    } else {
+        // Lengths of the query's lists, with pieces no name has being empty
+        vector<pair<uint32_t, uint32_t>> sizes;
+        for (uint32_t gram : grams) {
+            auto list = lists.find(gram);
+            if (list == lists.end()) {
+                sizes.push_back(make_pair(0, 0));
+            } else {
+                uint32_t l = list->second;
+                sizes.push_back(
+                    make_pair(listOffsets[l + 1] - listOffsets[l], l));
+            }
+        }
+        size_t read = min(grams.size(), needed + FUZZY_EXTRA_LISTS);
+        partial_sort(sizes.begin(), sizes.begin() + read, sizes.end());
+
+        // Count the rarest lists each actor is in
+        for (size_t s = 0; s < read; s++) {
+            if (sizes[s].first == 0) {
+                continue;
+            }
+            uint32_t l = sizes[s].second;
+            for (uint32_t p = listOffsets[l]; p < listOffsets[l + 1]; p++) {
+                uint32_t id = postings[p];
+                if (listCounts[id]++ == 0) {
+                    countedIds.push_back(id);
+                }
+            }
+        }
+
+        // Check the actors in enough of them, resetting every count
+        for (uint32_t id : countedIds) {
+            if (listCounts[id] + missable >= read) {
+                check(id);
+            }
+            listCounts[id] = 0;
+        }
+        countedIds.clear();
+    }
+
+    auto closer = [](const NameMatch& lhs, const NameMatch& rhs) {
+        if (lhs.distance != rhs.distance) {
+            return lhs.distance < rhs.distance;
+        }
+        if (lhs.node->movieVect.size() != rhs.node->movieVect.size()) {
+            return lhs.node->movieVect.size() > rhs.node->movieVect.size();
+        }
+        return lhs.node->actorName < rhs.node->actorName;
+    };
+    size_t kept = min(maxMatches, found.size());
+    partial_sort(found.begin(), found.begin() + kept, found.end(), closer);
+    matches.insert(matches.end(), found.begin(), found.begin() + kept);
+}
+
+/**
+ * Returns the actor with a given name, or the best actor within maxEdits edits
+ * of it if there is none, or nullptr if no name is close enough
+ *
+ * name: name to be resolved
+ * maxEdits: largest edit distance matched
+ */
+ActorNode* NameIndex::resolve(const string& name, int maxEdits) {
+    ActorNode* exact = actorGraph.get(actorGraph, name);
+    if (exact != nullptr || maxEdits <= 0) {
+        return exact;
+    }
+
+    vector<NameMatch> matches;
+    findNames(name, matches, maxEdits, 1);
+    return matches.empty() ? nullptr : matches[0].node;
+}
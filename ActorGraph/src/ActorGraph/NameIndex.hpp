@@ -0,0 +1,129 @@
+/*
+ * NameIndex.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the trigram index that resolves misspelled actor names
+ */
+
+#ifndef NAMEINDEX_HPP
+#define NAMEINDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+// Default number of edits a resolved name may be away from the query
+#define FUZZY_MAX_EDITS 2
+
+// Default number of matches found for a query
+#define FUZZY_MAX_MATCHES 5
+
+// Lists read beyond the fewest that every close name is in, each of which a
+// close name may only miss if it misses one of the others
+#define FUZZY_EXTRA_LISTS 3
+
+// Defines an actor whose name is close to a query
+struct NameMatch {
+    // Actor matched
+    ActorNode* node;
+
+    // Number of single character insertions, deletions, and substitutions
+    // between its name and the query, ignoring case
+    int distance;
+};
+
+/**
+ * Class that finds the actors whose names are within a few edits of a query,
+ * ignoring case. Every name is split into its overlapping three character
+ * pieces, padded at both ends, and the index lists the actors with each
+ * piece. One edit changes at most three pieces, so a name within k edits
+ * shares all but 3k of the query's pieces and is in all but 3k of any of
+ * their lists. Only a few more than 3k of the rarest lists are read, and the
+ * actors in enough of them are checked with an edit distance cut off after
+ * k. The index covers the actors in the graph when it is built.
+ */
+class NameIndex {
+  private:
+    // Graph whose actors are indexed
+    ActorGraph& actorGraph;
+
+    // Position of each piece's list in the postings
+    unordered_map<uint32_t, uint32_t> lists;
+
+    // Start of each list in the postings, with the end of the last at the
+    // back
+    vector<uint32_t> listOffsets;
+
+    // Indices of the actors with each piece, in increasing order within a
+    // list
+    vector<uint32_t> postings;
+
+    // Number of the query's lists each actor is in, indexed by actor index
+    vector<uint8_t> listCounts;
+
+    // Actors counted by the current query
+    vector<uint32_t> countedIds;
+
+    // Rows of the edit distance table, kept between names
+    vector<int> prevRow;
+    vector<int> curRow;
+
+    /**
+     * Appends the distinct pieces of a name, lowercased and padded at both
+     * ends, in increasing order
+     *
+     * name: name to be split
+     * grams: vector the pieces are appended to
+     */
+    static void appendTrigrams(const string& name, vector<uint32_t>& grams);
+
+    /**
+     * Returns the edit distance between two names ignoring case, or
+     * maxEdits + 1 if it is more than maxEdits. Only the cells within
+     * maxEdits of the diagonal are filled in
+     *
+     * query: lowercased query name
+     * name: name to be compared
+     * maxEdits: largest distance counted
+     */
+    int boundedDistance(const string& query, const string& name,
+                        int maxEdits);
+
+  public:
+    /**
+     * Constructor that indexes the names of every actor in a graph
+     *
+     * actorGraph: graph whose actors are indexed
+     */
+    NameIndex(ActorGraph& actorGraph);
+
+    /**
+     * Finds the actors whose names are within maxEdits edits of a query,
+     * closest first, then those in the most movies, then by name
+     *
+     * name: name to be matched
+     * matches: vector the matches are added to
+     * maxEdits: largest edit distance matched
+     * maxMatches: largest number of matches added
+     */
+    void findNames(const string& name, vector<NameMatch>& matches,
+                   int maxEdits = FUZZY_MAX_EDITS,
+                   size_t maxMatches = FUZZY_MAX_MATCHES);
+
+    /**
+     * Returns the actor with a given name, or the best actor within maxEdits
+     * edits of it if there is none, or nullptr if no name is close enough
+     *
+     * name: name to be resolved
+     * maxEdits: largest edit distance matched
+     */
+    ActorNode* resolve(const string& name, int maxEdits = FUZZY_MAX_EDITS);
+};
+
+#endif  // NAMEINDEX_HPP
@@ -0,0 +1,139 @@
+/*
+ * NodeArena.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the bump allocator that ActorGraph uses to store its
+ * actor and movie nodes contiguously
+ */
+
+#ifndef NODEARENA_HPP
+#define NODEARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "HugePages.hpp"
+
+using namespace std;
+
+/**
+ * Bump allocator that constructs nodes of type T inside large blocks. Nodes
+ * are never freed one at a time; release() destroys every node and returns
+ * all blocks at once. Blocks can be kept in huge pages, one huge page each, so
+ * that nodes reached at random share few TLB entries
+ */
+template <typename T>
+class NodeArena {
+  private:
+    // Number of nodes that fit in a single block outside of huge pages
+    static const size_t BLOCK_NODES = 4096;
+
+    // Whether blocks are kept in huge pages
+    bool hugePages;
+
+    // Number of nodes that fit in a single block
+    size_t blockNodes;
+
+    // Blocks of raw node storage
+    vector<T*> blocks;
+
+    // Number of nodes constructed in the last block
+    size_t used;
+
+    // Number of nodes constructed in the arena
+    size_t count;
+
+  public:
+    /**
+     * Constructor of an empty arena
+     */
+    NodeArena()
+        : hugePages(false), blockNodes(BLOCK_NODES), used(BLOCK_NODES),
+          count(0) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    /**
+     * Destructor of the arena, releases every node
+     */
+    ~NodeArena() { release(); }
+
+    /**
+     * Constructs a node in the arena and returns a pointer to it
+     *
+     * args: arguments forwarded to the node's constructor
+     */
+    template <typename... Args>
+    T* create(Args&&... args) {
+        // Start a new block if the last one is full
+        if (used == blockNodes) {
+            void* block = hugePages ? hugePageAlloc(sizeof(T) * blockNodes)
+                                    : ::operator new(sizeof(T) * blockNodes);
+            blocks.push_back(static_cast<T*>(block));
+            used = 0;
+        }
+
+        T* node = new (blocks.back() + used) T(forward<Args>(args)...);
+        used++;
+        count++;
+        return node;
+    }
+
+    /**
+     * Destroys every node and frees every block
+     */
+    void release() {
+        for (size_t b = 0; b < blocks.size(); b++) {
+            // Only the last block may be partially filled
+            size_t filled = (b + 1 == blocks.size()) ? used : blockNodes;
+            for (size_t i = 0; i < filled; i++) {
+                blocks[b][i].~T();
+            }
+            if (hugePages) {
+                hugePageFree(blocks[b], sizeof(T) * blockNodes);
+            } else {
+                ::operator delete(blocks[b]);
+            }
+        }
+
+        blocks.clear();
+        used = blockNodes;
+        count = 0;
+    }
+
+    /**
+     * Sets whether blocks are kept in huge pages, which fills each block with
+     * as many nodes as fit in one huge page. Releases every node first
+     *
+     * enabled: if true, keep blocks in huge pages
+     */
+    void setHugePages(bool enabled) {
+        release();
+        hugePages = enabled;
+        blockNodes = enabled ? HUGE_PAGE_BYTES / sizeof(T) : BLOCK_NODES;
+        used = blockNodes;
+    }
+
+    /**
+     * Returns whether blocks are kept in huge pages
+     */
+    bool usesHugePages() const { return hugePages; }
+
+    /**
+     * Returns the number of nodes in the arena
+     */
+    size_t size() const { return count; }
+
+    /**
+     * Returns the number of bytes reserved by the arena's blocks
+     */
+    size_t bytesReserved() const {
+        return blocks.size() * blockNodes * sizeof(T);
+    }
+};
+
+#endif  // NODEARENA_HPP
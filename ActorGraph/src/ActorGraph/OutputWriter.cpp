@@ -0,0 +1,123 @@
+/*
+ * OutputWriter.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that writes blocks of output on a separate thread
+ */
+
+#include "OutputWriter.hpp"
+#include <iostream>
+#include <utility>
+
+#define MAX_PENDING_BLOCKS 4
+#define WRITE_FAILURE "Failed to write "
+#define FAILURE_PUNCT "!\n"
+
+using namespace std;
+
+/**
+ * Constructor that opens the file and starts the writer thread
+ *
+ * out_filename: file to be written
+ * blockSize: size at which a block is handed to the writer thread
+ */
+OutputWriter::OutputWriter(const char* out_filename, size_t blockSize)
+    : outfile(out_filename, ios::binary),
+      filename(out_filename),
+      blockSize(blockSize),
+      closing(false),
+      failed(!outfile),
+      closed(false) {
+    // Leave room for the line that overflows the block
+    current.reserve(blockSize + blockSize / 8);
+    writer = thread(&OutputWriter::writeLoop, this);
+}
+
+/**
+ * Destructor that writes anything left and closes the file
+ */
+OutputWriter::~OutputWriter() { close(); }
+
+/**
+ * Writes pending blocks until the writer is closed and none are left
+ */
+void OutputWriter::writeLoop() {
+    unique_lock<mutex> guard(lock);
+
+    while (true) {
+        blockReady.wait(guard,
+                        [this]() { return closing || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+
+        string block = move(pending.front());
+        pending.pop_front();
+
+        // Write without holding the lock so the caller can keep appending
+        guard.unlock();
+        outfile.write(block.data(), block.size());
+        bool writeFailed = !outfile;
+        block.clear();
+        guard.lock();
+
+        failed = failed || writeFailed;
+        spare.push_back(move(block));
+        blockWritten.notify_one();
+    }
+}
+
+/**
+ * Hands the current block to the writer thread and starts a new one, waiting
+ * if too many blocks are already pending
+ */
+void OutputWriter::handOff() {
+    {
+        unique_lock<mutex> guard(lock);
+        blockWritten.wait(
+            guard, [this]() { return pending.size() < MAX_PENDING_BLOCKS; });
+        pending.push_back(move(current));
+
+        // Reuse a written block if there is one
+        if (!spare.empty()) {
+            current = move(spare.back());
+            spare.pop_back();
+        } else {
+            current = string();
+            current.reserve(blockSize + blockSize / 8);
+        }
+    }
+    blockReady.notify_one();
+}
+
+/**
+ * Writes anything left, closes the file and stops the writer thread. Returns
+ * false if any write failed
+ */
+bool OutputWriter::close() {
+    if (closed) {
+        return !failed;
+    }
+
+    if (!current.empty()) {
+        handOff();
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        closing = true;
+    }
+    blockReady.notify_one();
+    writer.join();
+
+    outfile.close();
+    failed = failed || !outfile;
+    closed = true;
+
+    if (failed) {
+        cerr << WRITE_FAILURE << filename << FAILURE_PUNCT;
+    }
+
+    return !failed;
+}
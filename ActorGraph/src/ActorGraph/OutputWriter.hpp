@@ -0,0 +1,131 @@
+/*
+ * OutputWriter.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the buffered output file that the tools write their
+ * results through
+ */
+
+#ifndef OUTPUTWRITER_HPP
+#define OUTPUTWRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Output file that results are formatted straight into. Lines are appended to
+ * a large block, and each full block is handed to a writer thread, so the
+ * caller keeps computing while earlier blocks are written. Written blocks are
+ * reused, so their memory is only allocated once.
+ */
+class OutputWriter {
+  private:
+    // File being written
+    ofstream outfile;
+
+    // Name of the file, for error messages
+    string filename;
+
+    // Size at which a block is handed to the writer thread
+    size_t blockSize;
+
+    // Block lines are being appended to
+    string current;
+
+    // Full blocks waiting to be written, oldest first
+    deque<string> pending;
+
+    // Written blocks whose memory is reused
+    vector<string> spare;
+
+    // Guards pending, spare, closing and failed
+    mutex lock;
+
+    // Signaled when a block is pending or the writer is closing
+    condition_variable blockReady;
+
+    // Signaled when a block has been written
+    condition_variable blockWritten;
+
+    // Set once no more blocks will be handed off
+    bool closing;
+
+    // Set if any write failed
+    bool failed;
+
+    // Set once close() has finished
+    bool closed;
+
+    // Thread writing the pending blocks
+    thread writer;
+
+    /**
+     * Writes pending blocks until the writer is closed and none are left
+     */
+    void writeLoop();
+
+    /**
+     * Hands the current block to the writer thread and starts a new one,
+     * waiting if too many blocks are already pending
+     */
+    void handOff();
+
+  public:
+    /**
+     * Constructor that opens the file and starts the writer thread
+     *
+     * out_filename: file to be written
+     * blockSize: size at which a block is handed to the writer thread
+     */
+    explicit OutputWriter(const char* out_filename,
+                          size_t blockSize = 1 << 20);
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    /**
+     * Destructor that writes anything left and closes the file
+     */
+    ~OutputWriter();
+
+    /**
+     * Returns the block that the current line is appended to
+     */
+    string& buffer() { return current; }
+
+    /**
+     * Ends the current line, handing the block off if it is full
+     */
+    void endLine() {
+        current += '\n';
+        if (current.size() >= blockSize) {
+            handOff();
+        }
+    }
+
+    /**
+     * Appends a whole line
+     *
+     * line: line to be appended, without its newline
+     */
+    void writeLine(const string& line) {
+        current += line;
+        endLine();
+    }
+
+    /**
+     * Writes anything left, closes the file and stops the writer thread.
+     * Returns false if any write failed
+     */
+    bool close();
+};
+
+#endif  // OUTPUTWRITER_HPP
@@ -0,0 +1,409 @@
+/*
+ * PathFinder.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that finds the shortest path between two actors
+ */
+
+#include "PathFinder.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#define LEFT_BRACKET "("
+#define RIGHT_BRACKET ")"
+#define LEFT_ARROW "--["
+#define MOVIE_DELIM "#@"
+#define RIGHT_ARROW "]-->"
+
+using namespace std;
+
+/**
+ * Constructor of a PathFinder over a graph
+ *
+ * actorGraph: graph to traverse
+ */
+PathFinder::PathFinder(ActorGraph& actorGraph)
+    : actorGraph(actorGraph),
+      stepRanks(nullptr),
+      stepFinal(nullptr),
+      stepWeighted(false),
+      stepShift(0),
+      stepNode(nullptr),
+      stepDist(0),
+      stepMovie(),
+      stepLast(),
+      stepRelax(false),
+      stepFound(false) {}
+
+/**
+ * Resets the data fields of every actor touched by the last search and makes
+ * room for actors and movies added since
+ */
+void PathFinder::reset() {
+    // For every node, reset all of its data fields
+    for (ActorNode* node : resetVect) {
+        dist[node->index] = numeric_limits<int>::max();
+        prevMovie[node->index] = nullptr;
+        done[node->index] = false;
+    }
+    resetVect.clear();
+
+    for (MovieNode* movieNode : expandedVect) {
+        expanded[movieNode->index] = false;
+    }
+    expandedVect.clear();
+
+    // Size the state to the graph, which may have grown
+    size_t actorCount = actorGraph.getNodeCount(actorGraph);
+    if (dist.size() < actorCount) {
+        dist.resize(actorCount, numeric_limits<int>::max());
+        prevMovie.resize(actorCount, nullptr);
+        done.resize(actorCount, false);
+    }
+
+    size_t movieCount = actorGraph.getMovieCount(actorGraph);
+    if (prevActor.size() < movieCount) {
+        prevActor.resize(movieCount, nullptr);
+        expanded.resize(movieCount, false);
+    }
+}
+
+/**
+ * Finds the shortest path from a given starting actor to a given ending actor.
+ * Returns the ending actor if a path is found, nullptr otherwise
+ *
+ * firstActor: actor to begin searching
+ * finalActor: actor to find
+ * weighted: if true, weight each movie by its age, otherwise weights are 1
+ * window: years of the movies the path may go through. Weighted searches
+ * measure ages from its refYear, and with a refYear other than CURR_YEAR also
+ * skip movies released after it
+ * stats: filled in with the work done by the search, or nullptr
+ */
+ActorNode* PathFinder::shortestPath(ActorNode* firstActor,
+                                    ActorNode* finalActor, bool weighted,
+                                    const YearWindow& window,
+                                    SearchStats* stats) {
+    if (stats != nullptr) {
+        stats->clear();
+    }
+    StatsTimer timer(stats);
+
+    reset();
+
+    // Movies newer than the reference year would have a weight below 1
+    YearWindow searchWindow = window;
+    if (weighted && window.refYear != CURR_YEAR &&
+        searchWindow.maxYear > window.refYear) {
+        searchWindow.maxYear = window.refYear;
+    }
+
+    // Edge weights are 1 + (CURR_YEAR - year), shifted to the reference year
+    int weightShift = window.refYear - CURR_YEAR;
+
+    // Priority queue of two pairs containing an actor node and its distance
+    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
+                   EdgeComparator>
+        actorQueue;
+
+    // Set the first actor's distance to zero
+    dist[firstActor->index] = 0;
+
+    // Push the node and its distance
+    actorQueue.push(make_pair(firstActor, 0));
+
+    // Push node to reset vector
+    resetVect.push_back(firstActor);
+
+    // Checker if path from start to final actor found
+    bool pathFound = false;
+
+    // Counters kept in locals so that the loop does not test for stats
+    long settled = 0;
+    long relaxed = 0;
+    long stalePops = 0;
+
+    // Loop until queue empty
+    while (!actorQueue.empty()) {
+        // Get the highest priority node and its distance
+        ActorNode* node = actorQueue.top().first;
+        actorQueue.pop();
+
+        // Skip if node has already been visited
+        if (done[node->index]) {
+            stalePops++;
+            continue;
+        }
+        done[node->index] = true;
+        settled++;
+
+        int nodeDist = dist[node->index];
+
+        // For each of this actor's neighbors,
+        for (MovieNode* movieNode : moviesInWindow(node, searchWindow)) {
+            // The first of a cast to be settled has the smallest distance of
+            // them, so relaxing the cast again from a later one could never
+            // shorten a distance. Heavy casts are relaxed once per search
+            // instead of once per actor that reaches them
+            if (expanded[movieNode->index]) {
+                continue;
+            }
+            expanded[movieNode->index] = true;
+            expandedVect.push_back(movieNode);
+
+            int edgeWeight = weighted ? movieNode->edgeWeight + weightShift : 1;
+            relaxed += movieNode->actorVect.size();
+
+            for (ActorNode* actorNode : movieNode->actorVect) {
+                // Set dist to the neighbor the node's current distance plus
+                // the movie's edge weight
+                int newDist = nodeDist + edgeWeight;
+
+                // If this new dist is less than the node's distance, continue
+                // the path through this node
+                if (newDist < dist[actorNode->index]) {
+                    // Movie's previous is the node before
+                    prevActor[movieNode->index] = node;
+
+                    // New node's previous is the movie
+                    prevMovie[actorNode->index] = movieNode;
+
+                    // Distance is the new, shorter distance
+                    dist[actorNode->index] = newDist;
+
+                    // Push this node into the priority queue
+                    actorQueue.push(make_pair(actorNode, newDist));
+
+                    // Push into reset vector
+                    resetVect.push_back(actorNode);
+                }
+
+                // If final actor is found, path found
+                if (actorNode == finalActor) {
+                    pathFound = true;
+                }
+            }
+        }
+    }
+
+    if (stats != nullptr) {
+        stats->settled = settled;
+        stats->relaxed = relaxed;
+        stats->stalePops = stalePops;
+
+        // Every push also adds to the reset vector
+        stats->pushes = resetVect.size();
+        stats->touched = resetVect.size();
+    }
+
+    // Return final node if path found, nullptr otherwise
+    return pathFound ? finalActor : nullptr;
+}
+
+/**
+ * Starts a search that stepSearch runs a step at a time, finding the same path
+ * as shortestPath
+ *
+ * firstActor: actor to begin searching
+ * finalActor: actor to find
+ * weighted: if true, weight each movie by its age, otherwise weights are 1
+ * window: years of the movies the path may go through, as in shortestPath
+ * nameRanks: rank of each actor's name, indexed by actor index, as built by
+ * rankNames
+ */
+void PathFinder::startSearch(ActorNode* firstActor, ActorNode* finalActor,
+                             bool weighted, const YearWindow& window,
+                             const vector<uint32_t>& nameRanks) {
+    reset();
+
+    // Movies newer than the reference year would have a weight below 1
+    stepWindow = window;
+    if (weighted && window.refYear != CURR_YEAR &&
+        stepWindow.maxYear > window.refYear) {
+        stepWindow.maxYear = window.refYear;
+    }
+    stepShift = window.refYear - CURR_YEAR;
+    stepWeighted = weighted;
+    stepRanks = nameRanks.data();
+    stepFinal = finalActor;
+    stepFound = false;
+    stepRelax = false;
+    stepMovie = stepLast = WindowRange::iterator();
+
+    stepQueue = decltype(stepQueue)();
+    dist[firstActor->index] = 0;
+    stepQueue.push(StepEntry{0, stepRanks[firstActor->index],
+                             (uint32_t)firstActor->index});
+    resetVect.push_back(firstActor);
+}
+
+/**
+ * Runs the next step of the search started by startSearch: settling an actor,
+ * or expanding or relaxing one of its movies. Each step prefetches what the
+ * next one reads, so another search can run while it loads. Returns false
+ * once the search is over
+ */
+bool PathFinder::stepSearch() {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+
+    // Relax the cast whose state the last step prefetched. Actors are visited
+    // in index order instead of cast order, which changes only the order of
+    // pushes, and the queue breaks ties by name
+    if (stepRelax) {
+        stepRelax = false;
+        MovieNode* movieNode = *stepMovie;
+        ++stepMovie;
+        int newDist =
+            stepDist + (stepWeighted ? movieNode->edgeWeight + stepShift : 1);
+        int finalIndex = stepFinal != nullptr ? stepFinal->index : -1;
+
+        for (uint32_t id : actorGraph.getCastIds(actorGraph, movieNode)) {
+            if (newDist < dist[id]) {
+                prevActor[movieNode->index] = stepNode;
+                prevMovie[id] = movieNode;
+                dist[id] = newDist;
+                stepQueue.push(StepEntry{newDist, stepRanks[id], id});
+                resetVect.push_back(actors[id]);
+            }
+            if ((int)id == finalIndex) {
+                stepFound = true;
+            }
+        }
+        return true;
+    }
+
+    // Expand the next movie of the settled actor whose cast was not relaxed
+    // yet, as in shortestPath
+    while (stepMovie != stepLast) {
+        MovieNode* movieNode = *stepMovie;
+        if (stepMovie.pos + 1 != stepLast.pos) {
+            __builtin_prefetch(stepMovie.pos[1]);
+        }
+        if (expanded[movieNode->index]) {
+            ++stepMovie;
+            continue;
+        }
+        expanded[movieNode->index] = true;
+        expandedVect.push_back(movieNode);
+
+        // Prefetch the state of the cast for the next step
+        for (uint32_t id : actorGraph.getCastIds(actorGraph, movieNode)) {
+            __builtin_prefetch(&dist[id]);
+            __builtin_prefetch(&stepRanks[id]);
+            __builtin_prefetch(actors.begin() + id);
+        }
+        stepRelax = true;
+        return true;
+    }
+
+    // Settle the next actor, skipping those settled already
+    while (!stepQueue.empty()) {
+        uint32_t index = stepQueue.top().index;
+        stepQueue.pop();
+
+        // Prefetch the state of the actor settled after this one
+        if (!stepQueue.empty()) {
+            __builtin_prefetch(&done[stepQueue.top().index]);
+            __builtin_prefetch(actors.begin() + stepQueue.top().index);
+        }
+
+        if (done[index]) {
+            continue;
+        }
+        done[index] = true;
+
+        stepNode = actors[index];
+        stepDist = dist[index];
+        WindowRange movies = moviesInWindow(stepNode, stepWindow);
+        stepMovie = movies.begin();
+        stepLast = movies.end();
+
+        // Prefetch the actor's movies for the next step
+        if (stepMovie != stepLast) {
+            __builtin_prefetch(stepMovie.pos);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Builds the rank of every actor's name in increasing order of names, which
+ * startSearch breaks ties with
+ *
+ * actorGraph: graph of actor and movie nodes
+ * nameRanks: filled in with the rank of each actor, indexed by actor index
+ */
+void PathFinder::rankNames(const ActorGraph& actorGraph,
+                           vector<uint32_t>& nameRanks) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    vector<ActorNode*> byName(actors.begin(), actors.end());
+    sort(byName.begin(), byName.end(),
+         [](const ActorNode* lhs, const ActorNode* rhs) {
+             return lhs->actorName < rhs->actorName;
+         });
+
+    nameRanks.assign(byName.size(), 0);
+    for (size_t rank = 0; rank < byName.size(); rank++) {
+        nameRanks[byName[rank]->index] = rank;
+    }
+}
+
+/**
+ * Appends the path found by the last search from start to node, in the format
+ * (actor)--[movie#@year]-->(actor)--...
+ *
+ * out: string to append to
+ * node: last actor on the path
+ * start: first actor on path
+ */
+void PathFinder::appendPath(string& out, ActorNode* node, ActorNode* start) {
+    // Keep traversing backwards on the path until the start node is found
+    if (node != start) {
+        MovieNode* movieNode = prevMovie[node->index];
+        appendPath(out, prevActor[movieNode->index], start);
+
+        // Append movie name along with its required format
+        out += LEFT_ARROW;
+        out += movieNode->movieName;
+        out += MOVIE_DELIM;
+        out += to_string(movieNode->year);
+        out += RIGHT_ARROW;
+    }
+
+    // Append the actor's name with its required format
+    out += LEFT_BRACKET;
+    out += node->actorName;
+    out += RIGHT_BRACKET;
+}
+
+/**
+ * Fills in the actors and movies of the path found by the last search from
+ * start to node, in order from start
+ *
+ * node: last actor on the path
+ * start: first actor on path
+ * actors: filled in with the actors on the path
+ * movies: filled in with the movie linking each actor to the next
+ */
+void PathFinder::pathTo(ActorNode* node, ActorNode* start,
+                        vector<ActorNode*>& actors,
+                        vector<MovieNode*>& movies) const {
+    actors.clear();
+    movies.clear();
+
+    // Walk back to the start node, then put the path in order
+    actors.push_back(node);
+    while (node != start) {
+        MovieNode* movieNode = prevMovie[node->index];
+        node = prevActor[movieNode->index];
+        movies.push_back(movieNode);
+        actors.push_back(node);
+    }
+    reverse(actors.begin(), actors.end());
+    reverse(movies.begin(), movies.end());
+}
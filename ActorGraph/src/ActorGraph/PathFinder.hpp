@@ -0,0 +1,203 @@
+/*
+ * PathFinder.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the shortest path search used by pathfinder and the
+ * query daemon
+ */
+
+#ifndef PATHFINDER_HPP
+#define PATHFINDER_HPP
+
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "SearchStats.hpp"
+
+using namespace std;
+
+// Defines an entry of the queue of a search run a step at a time. Ties in
+// distance are broken by the rank of the actor's name, the order that
+// EdgeComparator gives, so entries are ordered without reading the actor
+struct StepEntry {
+    // Distance of the actor
+    int dist;
+
+    // Rank of the actor's name among the names of every actor
+    uint32_t rank;
+
+    // Index of the actor
+    uint32_t index;
+};
+
+// Comparator that sorts step entries by lowest distance then by name rank
+struct StepEntryComparator {
+    bool operator()(const StepEntry& lhs, const StepEntry& rhs) const {
+        if (lhs.dist != rhs.dist) {
+            return lhs.dist > rhs.dist;
+        }
+
+        return lhs.rank > rhs.rank;
+    }
+};
+
+/**
+ * Class that finds shortest paths between actors. The distances and previous
+ * nodes of a search are kept in the PathFinder instead of in the nodes, so
+ * several PathFinders can search the same graph at once.
+ */
+class PathFinder {
+  private:
+    // Graph to be searched
+    ActorGraph& actorGraph;
+
+    // Distance of each actor, indexed by actor index
+    vector<int> dist;
+
+    // Movie each actor was reached through, indexed by actor index
+    vector<MovieNode*> prevMovie;
+
+    // Actor each movie was reached from, indexed by movie index
+    vector<ActorNode*> prevActor;
+
+    // Whether each actor has been visited, indexed by actor index
+    vector<char> done;
+
+    // Vector to reset all data fields of the actors a search touched
+    vector<ActorNode*> resetVect;
+
+    // Whether each movie's cast has been relaxed, indexed by movie index
+    vector<char> expanded;
+
+    // Vector to reset the movies a search expanded
+    vector<MovieNode*> expandedVect;
+
+    // Queue of the search run a step at a time
+    priority_queue<StepEntry, vector<StepEntry>, StepEntryComparator>
+        stepQueue;
+
+    // Rank of each actor's name, indexed by actor index
+    const uint32_t* stepRanks;
+
+    // Actor the stepped search looks for, which may be nullptr
+    ActorNode* stepFinal;
+
+    // Weight of every movie, and shift from CURR_YEAR of weighted movies
+    bool stepWeighted;
+    int stepShift;
+
+    // Years of the movies the stepped search may go through
+    YearWindow stepWindow;
+
+    // Actor being settled and its distance
+    ActorNode* stepNode;
+    int stepDist;
+
+    // Movies of the actor being settled that are left to be relaxed
+    WindowRange::iterator stepMovie;
+    WindowRange::iterator stepLast;
+
+    // Whether the movie at stepMovie was prefetched and waits to be relaxed
+    bool stepRelax;
+
+    // Whether the stepped search reached its final actor
+    bool stepFound;
+
+    /**
+     * Resets the data fields of every actor touched by the last search and
+     * makes room for actors and movies added since
+     */
+    void reset();
+
+  public:
+    /**
+     * Constructor of a PathFinder over a graph
+     *
+     * actorGraph: graph to traverse
+     */
+    PathFinder(ActorGraph& actorGraph);
+
+    /**
+     * Finds the shortest path from a given starting actor to a given ending
+     * actor. Returns the ending actor if a path is found, nullptr otherwise
+     *
+     * firstActor: actor to begin searching
+     * finalActor: actor to find
+     * weighted: if true, weight each movie by its age, otherwise weights are 1
+     * window: years of the movies the path may go through. Weighted searches
+     * measure ages from its refYear, and with a refYear other than CURR_YEAR
+     * also skip movies released after it
+     * stats: filled in with the work done by the search, or nullptr
+     */
+    ActorNode* shortestPath(ActorNode* firstActor, ActorNode* finalActor,
+                            bool weighted,
+                            const YearWindow& window = YearWindow(),
+                            SearchStats* stats = nullptr);
+
+    /**
+     * Starts a search that stepSearch runs a step at a time, finding the same
+     * path as shortestPath
+     *
+     * firstActor: actor to begin searching
+     * finalActor: actor to find
+     * weighted: if true, weight each movie by its age, otherwise weights are 1
+     * window: years of the movies the path may go through, as in shortestPath
+     * nameRanks: rank of each actor's name, indexed by actor index, as built
+     * by rankNames
+     */
+    void startSearch(ActorNode* firstActor, ActorNode* finalActor,
+                     bool weighted, const YearWindow& window,
+                     const vector<uint32_t>& nameRanks);
+
+    /**
+     * Runs the next step of the search started by startSearch: settling an
+     * actor, or expanding or relaxing one of its movies. Each step prefetches
+     * what the next one reads, so another search can run while it loads.
+     * Returns false once the search is over
+     */
+    bool stepSearch();
+
+    /**
+     * Returns the final actor of the search run by stepSearch if a path was
+     * found, nullptr otherwise
+     */
+    ActorNode* searchResult() const { return stepFound ? stepFinal : nullptr; }
+
+    /**
+     * Builds the rank of every actor's name in increasing order of names, which
+     * startSearch breaks ties with
+     *
+     * actorGraph: graph of actor and movie nodes
+     * nameRanks: filled in with the rank of each actor, indexed by actor index
+     */
+    static void rankNames(const ActorGraph& actorGraph,
+                          vector<uint32_t>& nameRanks);
+
+    /**
+     * Appends the path found by the last search from start to node, in the
+     * format (actor)--[movie#@year]-->(actor)--...
+     *
+     * out: string to append to
+     * node: last actor on the path
+     * start: first actor on path
+     */
+    void appendPath(string& out, ActorNode* node, ActorNode* start);
+
+    /**
+     * Fills in the actors and movies of the path found by the last search
+     * from start to node, in order from start
+     *
+     * node: last actor on the path
+     * start: first actor on path
+     * actors: filled in with the actors on the path
+     * movies: filled in with the movie linking each actor to the next
+     */
+    void pathTo(ActorNode* node, ActorNode* start, vector<ActorNode*>& actors,
+                vector<MovieNode*>& movies) const;
+};
+
+#endif  // PATHFINDER_HPP
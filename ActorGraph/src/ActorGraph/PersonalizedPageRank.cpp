@@ -0,0 +1,244 @@
+/*
+ * PersonalizedPageRank.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that predicts collaborations by estimating personalized
+ * PageRank with random walks
+ */
+
+#include "PersonalizedPageRank.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include "LinkPredictor.hpp"
+
+using namespace std;
+
+/**
+ * Returns a uniformly distributed index in [0, count), scaling the top 32 bits
+ * of the generator rather than taking a remainder
+ *
+ * rng: random number generator
+ * count: number of indices to choose from, at least 1
+ */
+static size_t drawIndex(mt19937_64& rng, size_t count) {
+    return (size_t)(((rng() >> 32) * (uint64_t)count) >> 32);
+}
+
+/**
+ * Constructor of a PersonalizedPageRank over a graph
+ *
+ * actorGraph: graph to search
+ * walks: number of walks started from each query
+ * threads: number of threads the walks are shared by
+ * seed: seed the walks are drawn with
+ */
+PersonalizedPageRank::PersonalizedPageRank(ActorGraph& actorGraph, int walks,
+                                           int threads, uint64_t seed)
+    : actorGraph(actorGraph),
+      walks(max(walks, 1)),
+      seed(seed),
+      skipHeavy(false),
+      states(max(threads, 1)) {}
+
+/**
+ * Draws every walk whose block comes up, counting its visits
+ *
+ * query: actor the walks start from
+ * window: years of the movies walks may go through
+ * next: number of the next block to draw, shared by the threads
+ * state: visits of the calling thread
+ */
+void PersonalizedPageRank::walkBlocks(ActorNode* query,
+                                      const YearWindow& window,
+                                      atomic<int>& next, WalkState& state) {
+    // Chance of stopping scaled to the generator's range, so each step
+    // compares integers
+    const uint64_t restart =
+        (uint64_t)(PPR_RESTART * (double)numeric_limits<uint64_t>::max());
+
+    int blocks = (walks + PPR_BLOCK - 1) / PPR_BLOCK;
+    long steps = 0;
+
+    for (int block = next++; block < blocks; block = next++) {
+        mt19937_64 rng(seed + (uint64_t)block);
+        int blockWalks = min(PPR_BLOCK, walks - block * PPR_BLOCK);
+
+        for (int w = 0; w < blockWalks; w++) {
+            ActorNode* node = query;
+
+            for (int step = 0; step < PPR_MAX_STEPS; step++) {
+                // Draws are uniform, so the year-ordered run serves as is
+                MovieRange movies = moviesByYearInWindow(node, window);
+                if (movies.empty()) {
+                    break;
+                }
+
+                // Draw again if the movie is heavy, a bounded number of times
+                MovieNode* movieNode = nullptr;
+                for (int draw = 0; draw < PPR_MOVIE_DRAWS; draw++) {
+                    MovieNode* drawn = movies[drawIndex(rng, movies.size())];
+                    if (!skipHeavy || !drawn->heavy) {
+                        movieNode = drawn;
+                        break;
+                    }
+                }
+                if (movieNode == nullptr) {
+                    break;
+                }
+
+                ActorRange cast = castOf(movieNode);
+                node = cast[drawIndex(rng, cast.size())];
+                steps++;
+
+                int& visits = state.visits[node->index];
+                if (visits++ == 0) {
+                    state.visited.push_back(node);
+                }
+
+                if (rng() < restart) {
+                    break;
+                }
+            }
+        }
+    }
+
+    state.steps = steps;
+}
+
+/**
+ * Returns whether two actors share a movie in the window, checking the movies
+ * of the one in fewer against the sorted movies of the other
+ *
+ * first: actor to be checked
+ * second: other actor to be checked
+ * window: years of the movies counted
+ */
+bool PersonalizedPageRank::shareMovie(const ActorNode* first,
+                                      const ActorNode* second,
+                                      const YearWindow& window) const {
+    if (first->movieVect.size() > second->movieVect.size()) {
+        swap(first, second);
+    }
+
+    IdRange ids = actorGraph.getMovieIds(actorGraph, second);
+    for (const MovieNode* movieNode : moviesInWindow(first, window)) {
+        uint32_t id = movieNode->index;
+        if (binary_search(ids.begin(), ids.end(), id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Finds the actors with the highest estimated PageRank from a given actor,
+ * split into those that have collaborated with it and those that have not,
+ * highest first with ties broken by name. Only the actors taken off the
+ * queue are checked for a shared movie, which stops once both lists are full
+ *
+ * query: actor the walks start from
+ * collaborated: vector the collaborated actors are added to
+ * uncollaborated: vector the uncollaborated actors are added to
+ * window: years of the movies walks go through and collaborations are counted
+ * in
+ * stats: filled in with the work done by the query, or nullptr
+ */
+void PersonalizedPageRank::predict(ActorNode* query,
+                                   vector<ActorNode*>& collaborated,
+                                   vector<ActorNode*>& uncollaborated,
+                                   const YearWindow& window,
+                                   SearchStats* stats) {
+    if (stats != nullptr) {
+        stats->clear();
+    }
+    StatsTimer timer(stats);
+
+    // Size the visits to the graph, which may have grown
+    size_t actorCount = actorGraph.getNodeCount(actorGraph);
+    for (WalkState& state : states) {
+        if (state.visits.size() < actorCount) {
+            state.visits.resize(actorCount, 0);
+        }
+    }
+
+    // The calling thread walks too
+    atomic<int> next(0);
+    vector<thread> workers;
+    for (size_t t = 1; t < states.size(); t++) {
+        workers.push_back(thread(&PersonalizedPageRank::walkBlocks, this,
+                                 query, cref(window), ref(next),
+                                 ref(states[t])));
+    }
+    walkBlocks(query, window, next, states[0]);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    // Add the other threads' visits into the first's, leaving theirs reset
+    WalkState& sums = states[0];
+    long steps = sums.steps;
+    for (size_t t = 1; t < states.size(); t++) {
+        WalkState& state = states[t];
+        steps += state.steps;
+        for (ActorNode* node : state.visited) {
+            int& visits = sums.visits[node->index];
+            if (visits == 0) {
+                sums.visited.push_back(node);
+            }
+            visits += state.visits[node->index];
+            state.visits[node->index] = 0;
+        }
+        state.visited.clear();
+    }
+
+    // Every actor landed on other than the query is a candidate
+    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
+                   PriorityComparator>
+        bestPredictions;
+    for (ActorNode* node : sums.visited) {
+        if (node != query) {
+            bestPredictions.push(make_pair(node, sums.visits[node->index]));
+        }
+    }
+    long candidates = bestPredictions.size();
+
+    // Take the best of each kind until both are full or the queue is empty
+    long checked = 0;
+    long skipped = 0;
+    while (!bestPredictions.empty() &&
+           (collaborated.size() < MAX_CANDIDATES ||
+            uncollaborated.size() < MAX_CANDIDATES)) {
+        ActorNode* node = bestPredictions.top().first;
+        bestPredictions.pop();
+        checked++;
+
+        vector<ActorNode*>& predictions = shareMovie(query, node, window)
+                                              ? collaborated
+                                              : uncollaborated;
+        if (predictions.size() < MAX_CANDIDATES) {
+            predictions.push_back(node);
+        } else {
+            skipped++;
+        }
+    }
+
+    // Reset only what this query touched
+    for (ActorNode* node : sums.visited) {
+        sums.visits[node->index] = 0;
+    }
+    sums.visited.clear();
+
+    if (stats != nullptr) {
+        stats->settled = candidates;
+        stats->relaxed = steps + checked;
+        stats->pushes = candidates;
+        stats->stalePops = skipped;
+        stats->touched = candidates;
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ * PersonalizedPageRank.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the collaboration predictions that estimate
+ * personalized PageRank with random walks
+ */
+
+#ifndef PERSONALIZEDPAGERANK_HPP
+#define PERSONALIZEDPAGERANK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "SearchStats.hpp"
+
+using namespace std;
+
+// Default number of random walks started from each query
+#define PPR_WALKS 20000
+
+// Default seed the walks are drawn with
+#define PPR_SEED 1
+
+// Chance that a walk stops after each step and restarts at the query
+#define PPR_RESTART 0.15
+
+// Most steps a walk takes before it is cut off
+#define PPR_MAX_STEPS 64
+
+// Walks drawn from one seeded generator, which is the unit a thread takes
+#define PPR_BLOCK 1024
+
+// Draws of a movie a walk makes before giving up on an actor whose draws all
+// landed on heavy movies
+#define PPR_MOVIE_DRAWS 4
+
+/**
+ * Class that predicts collaborations by personalized PageRank from the query
+ * actor. Each walk starts at the query and repeatedly moves to a random movie
+ * of the current actor and then to a random actor of that movie, stopping
+ * with a fixed chance after each step. The number of times a walk lands on
+ * an actor estimates its PageRank, which ranks the actors that have and have
+ * not collaborated with the query. A step costs the same however many movies
+ * or costars an actor has, so a query's work is bounded by its number of
+ * walks rather than by the size of its neighborhood.
+ *
+ * The walks are drawn in blocks, each from a generator seeded by the seed and
+ * the block's number, so the predictions only depend on the seed and the
+ * number of walks, not on how many threads share the blocks.
+ */
+class PersonalizedPageRank {
+  private:
+    // Visits one thread counted for the current query
+    struct WalkState {
+        // Number of walks that landed on each actor, indexed by actor index
+        vector<int> visits;
+
+        // Actors landed on at least once, in the order first landed on
+        vector<ActorNode*> visited;
+
+        // Steps taken by the walks
+        long steps;
+    };
+
+    // Graph to be searched
+    ActorGraph& actorGraph;
+
+    // Number of walks started from each query
+    int walks;
+
+    // Seed the walks are drawn with
+    uint64_t seed;
+
+    // Whether walks avoid heavy movies
+    bool skipHeavy;
+
+    // Visits counted by each thread the walks are shared by, the first of
+    // which holds the sums
+    vector<WalkState> states;
+
+    /**
+     * Draws every walk whose block comes up, counting its visits
+     *
+     * query: actor the walks start from
+     * window: years of the movies walks may go through
+     * next: number of the next block to draw, shared by the threads
+     * state: visits of the calling thread
+     */
+    void walkBlocks(ActorNode* query, const YearWindow& window,
+                    atomic<int>& next, WalkState& state);
+
+    /**
+     * Returns whether two actors share a movie in the window, checking the
+     * movies of the one in fewer against the sorted movies of the other
+     *
+     * first: actor to be checked
+     * second: other actor to be checked
+     * window: years of the movies counted
+     */
+    bool shareMovie(const ActorNode* first, const ActorNode* second,
+                    const YearWindow& window) const;
+
+  public:
+    /**
+     * Constructor of a PersonalizedPageRank over a graph
+     *
+     * actorGraph: graph to search
+     * walks: number of walks started from each query
+     * threads: number of threads the walks are shared by
+     * seed: seed the walks are drawn with
+     */
+    PersonalizedPageRank(ActorGraph& actorGraph, int walks = PPR_WALKS,
+                         int threads = 1, uint64_t seed = PPR_SEED);
+
+    /**
+     * Sets whether walks avoid heavy movies, which link nearly everyone in
+     * them and say little about who works together. A heavy movie drawn is
+     * drawn again, and a walk stops if every draw lands on one. Actors who
+     * shared a heavy movie with the query are still never predicted as
+     * uncollaborated
+     *
+     * skip: if true, walks do not go through heavy movies
+     */
+    void skipHeavyMovies(bool skip) { skipHeavy = skip; }
+
+    /**
+     * Finds the actors with the highest estimated PageRank from a given
+     * actor, split into those that have collaborated with it and those that
+     * have not, highest first with ties broken by name
+     *
+     * query: actor the walks start from
+     * collaborated: vector the collaborated actors are added to
+     * uncollaborated: vector the uncollaborated actors are added to
+     * window: years of the movies walks go through and collaborations are
+     * counted in
+     * stats: filled in with the work done by the query, or nullptr
+     */
+    void predict(ActorNode* query, vector<ActorNode*>& collaborated,
+                 vector<ActorNode*>& uncollaborated,
+                 const YearWindow& window = YearWindow(),
+                 SearchStats* stats = nullptr);
+};
+
+#endif  // PERSONALIZEDPAGERANK_HPP
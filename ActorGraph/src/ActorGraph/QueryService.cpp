@@ -0,0 +1,194 @@
+/*
+ * QueryService.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that answers requests of the actor graph query daemon
+ */
+
+#include "QueryService.hpp"
+#include "MovieTraveler.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#define TAB_CHAR '\t'
+#define WEIGHTED 'w'
+#define UNWEIGHTED 'u'
+#define PATH_COMMAND "path"
+#define PREDICT_COMMAND "predict"
+#define TREE_COMMAND "mst"
+#define RESPONSE_OK "OK\t"
+#define RESPONSE_ERROR "ERR\t"
+#define PATH_FIELDS 4
+#define PREDICT_FIELDS 2
+#define PREDICT_LINES 2
+#define FROM_OPTION "from="
+#define TO_OPTION "to="
+#define REF_OPTION "ref="
+
+using namespace std;
+
+/**
+ * Constructor of a QueryService over a loaded graph. The graph must be loaded
+ * with weighted edges for weighted paths and the spanning tree.
+ *
+ * actorGraph: graph to be queried
+ */
+QueryService::QueryService(ActorGraph& actorGraph)
+    : actorGraph(actorGraph), treeLineCount(0) {}
+
+/**
+ * Builds the spanning tree response
+ */
+void QueryService::buildTree() {
+    SpanningTree tree;
+    movieTraveler(actorGraph, tree);
+
+    for (const TreeEdge& edge : tree.edges) {
+        appendTreeEdge(treeLines, edge);
+        treeLines += '\n';
+    }
+    appendTreeTotals(treeLines, tree);
+
+    // One line per edge, plus the three totals
+    treeLineCount = tree.edges.size() + 3;
+}
+
+/**
+ * Returns whether a field starts with an option name, and if so parses the
+ * year that follows it
+ *
+ * field: request field to check
+ * option: option name, including its '='
+ * year: set to the option's year if the field matches
+ */
+static bool parseOption(NameKey field, const char* option, int& year) {
+    size_t optionSize = strlen(option);
+    if (field.size <= optionSize || memcmp(field.data, option, optionSize)) {
+        return false;
+    }
+
+    string digits(field.data + optionSize, field.size - optionSize);
+    year = atoi(digits.c_str());
+    return true;
+}
+
+/**
+ * Parses the year window options of a request. Returns false if a field is
+ * not a valid option
+ *
+ * fields: fields of the request
+ * first: index of the first option field
+ * window: window the options are applied to
+ */
+static bool parseWindow(const vector<NameKey>& fields, size_t first,
+                        YearWindow& window) {
+    for (size_t i = first; i < fields.size(); i++) {
+        if (!parseOption(fields[i], FROM_OPTION, window.minYear) &&
+            !parseOption(fields[i], TO_OPTION, window.maxYear) &&
+            !parseOption(fields[i], REF_OPTION, window.refYear)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Answers a single request
+ *
+ * request: request line without its newline
+ * worker: search state of the calling thread
+ * response: string the response is appended to
+ */
+void QueryService::handle(const string& request, Worker& worker,
+                          string& response) {
+    // Split the request into views of its fields
+    vector<NameKey> fields;
+    size_t begin = 0;
+    while (true) {
+        size_t end = request.find(TAB_CHAR, begin);
+        if (end == string::npos) {
+            fields.push_back(NameKey(request.data() + begin,
+                                     request.size() - begin));
+            break;
+        }
+        fields.push_back(NameKey(request.data() + begin, end - begin));
+        begin = end + 1;
+    }
+
+    NameKey command = fields[0];
+
+    if (command == NameKey(PATH_COMMAND, sizeof(PATH_COMMAND) - 1)) {
+        YearWindow window;
+        if (fields.size() < PATH_FIELDS || fields[1].size != 1 ||
+            (fields[1].data[0] != WEIGHTED &&
+             fields[1].data[0] != UNWEIGHTED) ||
+            !parseWindow(fields, PATH_FIELDS, window)) {
+            response += RESPONSE_ERROR
+                "usage: path<TAB>u|w<TAB>actor<TAB>actor[<TAB>option]...\n";
+            return;
+        }
+
+        bool weighted = fields[1].data[0] == WEIGHTED;
+        ActorNode* startActorNode = actorGraph.get(actorGraph, fields[2]);
+        ActorNode* endActorNode = actorGraph.get(actorGraph, fields[3]);
+
+        response += RESPONSE_OK "1\n";
+
+        // An unknown actor or a missing path is an empty line
+        if (startActorNode != nullptr && endActorNode != nullptr &&
+            worker.pathFinder.shortestPath(startActorNode, endActorNode,
+                                           weighted, window) != nullptr) {
+            worker.pathFinder.appendPath(response, endActorNode,
+                                         startActorNode);
+        }
+        response += '\n';
+        return;
+    }
+
+    if (command == NameKey(PREDICT_COMMAND, sizeof(PREDICT_COMMAND) - 1)) {
+        YearWindow window;
+        if (fields.size() < PREDICT_FIELDS ||
+            !parseWindow(fields, PREDICT_FIELDS, window)) {
+            response +=
+                RESPONSE_ERROR "usage: predict<TAB>actor[<TAB>option]...\n";
+            return;
+        }
+
+        ActorNode* query = actorGraph.get(actorGraph, fields[1]);
+
+        response += RESPONSE_OK;
+        response += to_string(PREDICT_LINES);
+        response += '\n';
+
+        // An unknown actor is two empty lines
+        if (query != nullptr) {
+            vector<ActorNode*> predictions;
+            worker.linkPredictor.collaboratedActors(query, predictions, window);
+            LinkPredictor::appendCandidates(response, predictions);
+            response += '\n';
+
+            predictions.clear();
+            worker.linkPredictor.uncollaboratedActors(query, predictions,
+                                                      window);
+            LinkPredictor::appendCandidates(response, predictions);
+            response += '\n';
+        } else {
+            response += "\n\n";
+        }
+        return;
+    }
+
+    if (command == NameKey(TREE_COMMAND, sizeof(TREE_COMMAND) - 1)) {
+        // The graph does not change, so the tree is only built once
+        call_once(treeOnce, [this]() { buildTree(); });
+
+        response += RESPONSE_OK;
+        response += to_string(treeLineCount);
+        response += '\n';
+        response += treeLines;
+        return;
+    }
+
+    response += RESPONSE_ERROR "unknown command\n";
+}
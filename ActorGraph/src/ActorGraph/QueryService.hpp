@@ -0,0 +1,87 @@
+/*
+ * QueryService.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the request handling of the actor graph query daemon
+ */
+
+#ifndef QUERYSERVICE_HPP
+#define QUERYSERVICE_HPP
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "LinkPredictor.hpp"
+#include "PathFinder.hpp"
+
+using namespace std;
+
+/**
+ * Class that answers path, prediction and spanning tree requests against a
+ * graph that is loaded once. Requests are single tab-delimited lines:
+ *
+ *   path<TAB>u|w<TAB>actor1<TAB>actor2[<TAB>option]...
+ *   predict<TAB>actor[<TAB>option]...
+ *   mst
+ *
+ * where each option is one of from=year, to=year or ref=year, restricting the
+ * movies used to a year window and, for weighted paths, measuring their age
+ * from a reference year.
+ *
+ * Each response starts with a line "OK<TAB>n" followed by n lines in the
+ * same format the one-shot tools write, or is a single line "ERR<TAB>reason".
+ * handle() may be called from several threads at once as long as each thread
+ * passes its own Worker.
+ */
+class QueryService {
+  public:
+    // Search state owned by one worker thread
+    struct Worker {
+        PathFinder pathFinder;
+        LinkPredictor linkPredictor;
+
+        Worker(ActorGraph& actorGraph)
+            : pathFinder(actorGraph), linkPredictor(actorGraph) {}
+    };
+
+  private:
+    // Graph to be queried
+    ActorGraph& actorGraph;
+
+    // Lines of the spanning tree response, built on the first mst request
+    string treeLines;
+
+    // Number of lines in treeLines
+    int treeLineCount;
+
+    // Guards the first computation of the spanning tree
+    once_flag treeOnce;
+
+    /**
+     * Builds the spanning tree response
+     */
+    void buildTree();
+
+  public:
+    /**
+     * Constructor of a QueryService over a loaded graph. The graph must be
+     * loaded with weighted edges for weighted paths and the spanning tree.
+     *
+     * actorGraph: graph to be queried
+     */
+    QueryService(ActorGraph& actorGraph);
+
+    /**
+     * Answers a single request
+     *
+     * request: request line without its newline
+     * worker: search state of the calling thread
+     * response: string the response is appended to
+     */
+    void handle(const string& request, Worker& worker, string& response);
+};
+
+#endif  // QUERYSERVICE_HPP
@@ -0,0 +1,114 @@
+/*
+ * SearchStats.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that writes the stats of a query as CSV or JSON lines
+ */
+
+#include "SearchStats.hpp"
+#include <cstdio>
+
+#define CSV_HEADER \
+    "kind,source,target,settled,relaxed,pushes,stale_pops,touched,micros\n"
+#define QUOTE_CHAR '"'
+#define BACKSLASH_CHAR '\\'
+#define COMMA_CHAR ','
+#define SPACE_CHAR ' '
+
+using namespace std;
+
+/**
+ * Appends a field as a quoted CSV value, doubling any quotes
+ *
+ * out: string to append to
+ * field: value to be appended
+ */
+static void appendCsvField(string& out, const string& field) {
+    out += QUOTE_CHAR;
+    for (char c : field) {
+        if (c == QUOTE_CHAR) {
+            out += QUOTE_CHAR;
+        }
+        out += c;
+    }
+    out += QUOTE_CHAR;
+}
+
+/**
+ * Appends a field as a JSON string, escaping quotes, backslashes and control
+ * characters
+ *
+ * out: string to append to
+ * field: value to be appended
+ */
+static void appendJsonField(string& out, const string& field) {
+    out += QUOTE_CHAR;
+    for (char c : field) {
+        if (c == QUOTE_CHAR || c == BACKSLASH_CHAR) {
+            out += BACKSLASH_CHAR;
+            out += c;
+        } else if ((unsigned char)c < SPACE_CHAR) {
+            char escaped[sizeof("\\u0000")];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += QUOTE_CHAR;
+}
+
+/**
+ * Appends the header line of the CSV stats format
+ *
+ * out: string to append to
+ */
+void appendStatsHeader(string& out) { out += CSV_HEADER; }
+
+/**
+ * Appends one line describing a query's stats, as CSV or as a JSON object
+ *
+ * out: string to append to
+ * kind: kind of query, such as path or mst
+ * source: actor the query started from, empty if none
+ * target: actor the query searched for, empty if none
+ * stats: stats of the query
+ * json: if true, write a JSON object, otherwise a CSV row
+ */
+void appendStats(string& out, const char* kind, const string& source,
+                 const string& target, const SearchStats& stats, bool json) {
+    // Names and values of the counters, in column order
+    const char* names[] = {"settled", "relaxed",  "pushes",
+                           "stale_pops", "touched", "micros"};
+    long values[] = {stats.settled,   stats.relaxed, stats.pushes,
+                     stats.stalePops, stats.touched, stats.micros};
+
+    if (json) {
+        out += "{\"kind\":";
+        appendJsonField(out, kind);
+        out += ",\"source\":";
+        appendJsonField(out, source);
+        out += ",\"target\":";
+        appendJsonField(out, target);
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            out += ",\"";
+            out += names[i];
+            out += "\":";
+            out += to_string(values[i]);
+        }
+        out += "}\n";
+        return;
+    }
+
+    out += kind;
+    out += COMMA_CHAR;
+    appendCsvField(out, source);
+    out += COMMA_CHAR;
+    appendCsvField(out, target);
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        out += COMMA_CHAR;
+        out += to_string(values[i]);
+    }
+    out += '\n';
+}
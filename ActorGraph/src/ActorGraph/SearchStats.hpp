@@ -0,0 +1,114 @@
+/*
+ * SearchStats.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the counters and timer that the graph searches fill in
+ * when asked, and their CSV and JSON lines
+ */
+
+#ifndef SEARCHSTATS_HPP
+#define SEARCHSTATS_HPP
+
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+// Defines the work done by a single query
+struct SearchStats {
+    // Actors settled by a path search, candidates scored by a prediction, or
+    // edges chosen by the spanning tree
+    long settled;
+
+    // Edges examined
+    long relaxed;
+
+    // Entries pushed onto a queue
+    long pushes;
+
+    // Entries taken off a queue but skipped: actors already settled,
+    // candidates already predicted, or actors already connected
+    long stalePops;
+
+    // Nodes whose per-query state was set, such as the size of resetVect
+    long touched;
+
+    // Wall time of the query in microseconds
+    long micros;
+
+    SearchStats() { clear(); }
+
+    /**
+     * Sets every counter to zero
+     */
+    void clear() {
+        settled = 0;
+        relaxed = 0;
+        pushes = 0;
+        stalePops = 0;
+        touched = 0;
+        micros = 0;
+    }
+};
+
+/**
+ * Timer that adds the time until it is destroyed to a query's stats. It does
+ * not read the clock when no stats are kept
+ */
+class StatsTimer {
+  private:
+    // Stats the time is added to, or nullptr
+    SearchStats* stats;
+
+    // Time the timer was created
+    chrono::steady_clock::time_point start;
+
+  public:
+    /**
+     * Constructor that starts timing if stats are kept
+     *
+     * stats: stats the time is added to, or nullptr
+     */
+    explicit StatsTimer(SearchStats* stats) : stats(stats) {
+        if (stats != nullptr) {
+            start = chrono::steady_clock::now();
+        }
+    }
+
+    StatsTimer(const StatsTimer&) = delete;
+    StatsTimer& operator=(const StatsTimer&) = delete;
+
+    /**
+     * Destructor that adds the elapsed time to the stats
+     */
+    ~StatsTimer() {
+        if (stats != nullptr) {
+            stats->micros += chrono::duration_cast<chrono::microseconds>(
+                                 chrono::steady_clock::now() - start)
+                                 .count();
+        }
+    }
+};
+
+/**
+ * Appends the header line of the CSV stats format
+ *
+ * out: string to append to
+ */
+void appendStatsHeader(string& out);
+
+/**
+ * Appends one line describing a query's stats, as CSV or as a JSON object
+ *
+ * out: string to append to
+ * kind: kind of query, such as path or mst
+ * source: actor the query started from, empty if none
+ * target: actor the query searched for, empty if none
+ * stats: stats of the query
+ * json: if true, write a JSON object, otherwise a CSV row
+ */
+void appendStats(string& out, const char* kind, const string& source,
+                 const string& target, const SearchStats& stats, bool json);
+
+#endif  // SEARCHSTATS_HPP
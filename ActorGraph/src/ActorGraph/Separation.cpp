@@ -0,0 +1,182 @@
+/*
+ * Separation.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Implementation file that gathers degrees of separation from many source
+ * actors in parallel
+ */
+
+#include "Separation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+/**
+ * Returns the sources to search from, drawn without repeats
+ *
+ * actorGraph: graph of actor and movie nodes
+ * samples: number of sources drawn, or 0 for every actor in index order
+ * seed: seed the sources are drawn with
+ */
+static vector<ActorNode*> drawSources(const ActorGraph& actorGraph,
+                                      int samples, uint64_t seed) {
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    vector<ActorNode*> sources(actors.begin(), actors.end());
+    if (samples <= 0 || (size_t)samples >= sources.size()) {
+        return sources;
+    }
+
+    // Shuffle only the front of the actors
+    mt19937_64 rng(seed);
+    for (int i = 0; i < samples; i++) {
+        size_t j = i + rng() % (sources.size() - i);
+        swap(sources[i], sources[j]);
+    }
+    sources.resize(samples);
+    return sources;
+}
+
+/**
+ * Searches from every source whose turn comes up and adds the hops found to
+ * the report
+ *
+ * actorGraph: graph of actor and movie nodes
+ * window: years of the movies the searches may go through
+ * next: index of the next source to search from, shared by the threads
+ * lock: guards the histogram and unreachable count of the report
+ * report: report whose sources are searched from
+ */
+static void searchSources(const ActorGraph& actorGraph,
+                          const YearWindow& window, atomic<size_t>& next,
+                          mutex& lock, SeparationReport& report) {
+    // Hops of each actor from the current source, or -1, indexed by actor
+    // index
+    vector<int> hops(actorGraph.getNodeCount(actorGraph), -1);
+
+    // Whether each movie's cast was scanned, indexed by movie index
+    vector<char> scanned(actorGraph.getMovieCount(actorGraph), false);
+
+    // Actors in the order they were reached, which is also the queue
+    vector<ActorNode*> order;
+
+    // Movies scanned by the current search
+    vector<MovieNode*> movies;
+
+    // Hops gathered by this thread, added to the report at the end
+    vector<long> histogram;
+    long unreachable = 0;
+
+    size_t actorCount = hops.size();
+
+    for (size_t s = next++; s < report.sources.size(); s = next++) {
+        ActorNode* source = report.sources[s];
+        hops[source->index] = 0;
+        order.push_back(source);
+
+        long hopSum = 0;
+        int eccentricity = 0;
+
+        // Each actor's hops are known when it is queued, so the queue is
+        // read in place
+        for (size_t head = 0; head < order.size(); head++) {
+            ActorNode* node = order[head];
+            int nodeHops = hops[node->index];
+            hopSum += nodeHops;
+            eccentricity = nodeHops;
+
+            for (MovieNode* movieNode : moviesInWindow(node, window)) {
+                // Every actor of a scanned cast was already reached
+                if (scanned[movieNode->index]) {
+                    continue;
+                }
+                scanned[movieNode->index] = true;
+                movies.push_back(movieNode);
+
+                for (ActorNode* actorNode : movieNode->actorVect) {
+                    if (hops[actorNode->index] == -1) {
+                        hops[actorNode->index] = nodeHops + 1;
+                        order.push_back(actorNode);
+                    }
+                }
+            }
+        }
+
+        if (histogram.size() <= (size_t)eccentricity) {
+            histogram.resize(eccentricity + 1, 0);
+        }
+        for (ActorNode* node : order) {
+            histogram[hops[node->index]]++;
+        }
+
+        long reached = order.size() - 1;
+        unreachable += actorCount - order.size();
+
+        // Each source writes only its own slots
+        report.eccentricity[s] = eccentricity;
+        report.closeness[s] =
+            hopSum > 0 && actorCount > 1
+                ? (double)reached / (actorCount - 1) * reached / hopSum
+                : 0;
+
+        // Reset only what this search touched
+        for (ActorNode* node : order) {
+            hops[node->index] = -1;
+        }
+        for (MovieNode* movieNode : movies) {
+            scanned[movieNode->index] = false;
+        }
+        order.clear();
+        movies.clear();
+    }
+
+    lock_guard<mutex> guard(lock);
+    if (report.histogram.size() < histogram.size()) {
+        report.histogram.resize(histogram.size(), 0);
+    }
+    for (size_t h = 0; h < histogram.size(); h++) {
+        report.histogram[h] += histogram[h];
+    }
+    report.unreachable += unreachable;
+}
+
+/**
+ * Runs a breadth first search from each sampled source actor, on several
+ * threads at once, and gathers the hops to every actor into a report. Each
+ * search reads the graph without changing it and scans the cast of each movie
+ * once, so the cost of a source is one pass over its component
+ *
+ * actorGraph: graph of actor and movie nodes
+ * samples: number of sources drawn at random, or 0 to search from every actor
+ * seed: seed the sources are drawn with
+ * threads: number of threads searching at once
+ * window: years of the movies the searches may go through
+ * report: filled in with the statistics of every source
+ */
+void separationStats(const ActorGraph& actorGraph, int samples, uint64_t seed,
+                     int threads, const YearWindow& window,
+                     SeparationReport& report) {
+    report.histogram.clear();
+    report.unreachable = 0;
+    report.sources = drawSources(actorGraph, samples, seed);
+    report.eccentricity.assign(report.sources.size(), 0);
+    report.closeness.assign(report.sources.size(), 0);
+
+    atomic<size_t> next(0);
+    mutex lock;
+
+    // The calling thread searches too
+    vector<thread> workers;
+    for (int i = 1; i < threads; i++) {
+        workers.push_back(thread(searchSources, cref(actorGraph), cref(window),
+                                 ref(next), ref(lock), ref(report)));
+    }
+    searchSources(actorGraph, window, next, lock, report);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
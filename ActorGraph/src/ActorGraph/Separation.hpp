@@ -0,0 +1,75 @@
+/*
+ * Separation.hpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Header File defining the degrees of separation statistics computed by the
+ * separation tool
+ */
+
+#ifndef SEPARATION_HPP
+#define SEPARATION_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+// Defines the degrees of separation found from a set of source actors
+struct SeparationReport {
+    // Number of source and actor pairs at each number of hops, with each
+    // source counted at 0 hops from itself
+    vector<long> histogram;
+
+    // Number of source and actor pairs with no path
+    long unreachable;
+
+    // Actors searched from, in the order they were drawn
+    vector<ActorNode*> sources;
+
+    // Most hops from each source to an actor it reaches
+    vector<int> eccentricity;
+
+    // Closeness of each source: the share of other actors it reaches, times
+    // the actors it reaches over the sum of their hops, so sources in small
+    // components are not rated above those in the main one
+    vector<double> closeness;
+
+    // Average hops between a source and the other actors it reaches
+    double averageSeparation() const {
+        long pairs = 0;
+        long hops = 0;
+        for (size_t h = 1; h < histogram.size(); h++) {
+            pairs += histogram[h];
+            hops += histogram[h] * h;
+        }
+        return pairs > 0 ? (double)hops / pairs : 0;
+    }
+
+    // Most hops found between any source and actor, a lower bound of the
+    // diameter of the graph
+    int diameterEstimate() const {
+        return histogram.empty() ? 0 : histogram.size() - 1;
+    }
+};
+
+/**
+ * Runs a breadth first search from each sampled source actor, on several
+ * threads at once, and gathers the hops to every actor into a report. Each
+ * search reads the graph without changing it and scans the cast of each
+ * movie once, so the cost of a source is one pass over its component
+ *
+ * actorGraph: graph of actor and movie nodes
+ * samples: number of sources drawn at random, or 0 to search from every actor
+ * seed: seed the sources are drawn with
+ * threads: number of threads searching at once
+ * window: years of the movies the searches may go through
+ * report: filled in with the statistics of every source
+ */
+void separationStats(const ActorGraph& actorGraph, int samples, uint64_t seed,
+                     int threads, const YearWindow& window,
+                     SeparationReport& report);
+
+#endif  // SEPARATION_HPP
@@ -0,0 +1,394 @@
+/*
+ * actorgraphd.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Program that loads the actor graph once and answers path, prediction and
+ * spanning tree requests over a Unix-domain socket, or over stdin and stdout
+ * when no socket path is given. Requests are described in QueryService.hpp;
+ * clients may send many requests before reading, and responses on each
+ * connection are written in request order.
+ */
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ActorGraph.cpp"
+#include "ActorGraph.hpp"
+#include "QueryService.hpp"
+
+#define ARG_TWO 2
+#define THREADS_FLAG "--threads"
+#define QUIT_COMMAND "quit"
+#define DEFAULT_THREADS 4
+#define MAX_IN_FLIGHT 1024
+#define READ_BUFFER_SIZE 65536
+#define LISTEN_BACKLOG 64
+#define USAGE \
+    "Usage: ./actorgraphd <movie_cast.tsv> [socket_path] [--threads n]\n"
+
+using namespace std;
+
+// Defines a client connection and the responses waiting to be written to it
+struct Connection {
+    // File descriptors requests are read from and responses written to
+    int inFd;
+    int outFd;
+
+    // Guards every field below
+    mutex lock;
+
+    // Signaled when a response has been written
+    condition_variable written;
+
+    // Signaled when a response is ready or the connection is closing
+    condition_variable readyToWrite;
+
+    // Responses that finished out of order, keyed on request number
+    map<long, string> ready;
+
+    // Number of requests read from the connection
+    long received;
+
+    // Number of the next response to be written
+    long nextToWrite;
+
+    // Set once every response has been written and the writer should exit
+    bool closing;
+
+    Connection(int inFd, int outFd)
+        : inFd(inFd), outFd(outFd), received(0), nextToWrite(0),
+          closing(false) {}
+};
+
+// Defines a request waiting for a worker
+struct Task {
+    shared_ptr<Connection> connection;
+    long number;
+    string request;
+};
+
+// Queue of requests shared by all workers
+deque<Task> taskQueue;
+mutex taskLock;
+condition_variable taskReady;
+
+// Set once no more requests will be queued, after which workers exit
+bool stopping = false;
+
+/**
+ * Writes every byte of a buffer to a file descriptor. Returns false on error
+ *
+ * fd: file descriptor to write to
+ * data: bytes to be written
+ */
+bool writeAll(int fd, const string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t n = write(fd, data.data() + offset, data.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        offset += n;
+    }
+    return true;
+}
+
+/**
+ * Hands a finished response to its connection. The connection's writer
+ * writes it, so a client that stops reading never blocks a worker
+ *
+ * connection: connection the request came from
+ * number: request number of the response
+ * response: response to be written
+ */
+void deliver(Connection& connection, long number, string& response) {
+    {
+        lock_guard<mutex> guard(connection.lock);
+        connection.ready[number].swap(response);
+    }
+    connection.readyToWrite.notify_one();
+}
+
+/**
+ * Writes the responses of a connection in request order as they become
+ * ready, until the connection is closing. Writes are made without holding
+ * the connection's lock, so only this thread waits on a slow client
+ *
+ * connection: connection to write responses to
+ */
+void writeResponses(shared_ptr<Connection> connection) {
+    string response;
+
+    // Set once a write fails, after which responses are dropped
+    bool broken = false;
+
+    while (true) {
+        {
+            // Wait for the next response in order
+            unique_lock<mutex> guard(connection->lock);
+            map<long, string>::iterator next;
+            connection->readyToWrite.wait(guard, [&]() {
+                next = connection->ready.find(connection->nextToWrite);
+                return next != connection->ready.end() || connection->closing;
+            });
+            if (next == connection->ready.end()) return;
+            response.swap(next->second);
+            connection->ready.erase(next);
+        }
+
+        if (!broken && !writeAll(connection->outFd, response)) {
+            broken = true;
+        }
+
+        {
+            lock_guard<mutex> guard(connection->lock);
+            connection->nextToWrite++;
+        }
+        connection->written.notify_all();
+    }
+}
+
+/**
+ * Takes requests off the shared queue and answers them until the queue is
+ * stopped and empty
+ *
+ * service: service answering the requests
+ * actorGraph: graph the worker's search state is built for
+ */
+void workerLoop(QueryService& service, ActorGraph& actorGraph) {
+    // Search state owned by this thread
+    QueryService::Worker worker(actorGraph);
+    string response;
+
+    while (true) {
+        Task task;
+        {
+            unique_lock<mutex> guard(taskLock);
+            taskReady.wait(guard,
+                           []() { return stopping || !taskQueue.empty(); });
+            if (taskQueue.empty()) return;
+            task = move(taskQueue.front());
+            taskQueue.pop_front();
+        }
+
+        response.clear();
+        service.handle(task.request, worker, response);
+        deliver(*task.connection, task.number, response);
+    }
+}
+
+/**
+ * Lets the workers finish the queued requests and waits for them to exit, so
+ * that the graph outlives every search
+ *
+ * workers: worker threads to be stopped
+ */
+void stopWorkers(vector<thread>& workers) {
+    {
+        lock_guard<mutex> guard(taskLock);
+        stopping = true;
+    }
+    taskReady.notify_all();
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Queues one request line of a connection for the workers, first waiting
+ * while too many of its responses are outstanding
+ *
+ * connection: connection the request was read from
+ * line: request line, without its line ending
+ */
+void queueRequest(const shared_ptr<Connection>& connection,
+                  const string& line) {
+    long number;
+    {
+        // Stop reading while too many responses are outstanding
+        unique_lock<mutex> guard(connection->lock);
+        connection->written.wait(guard, [&]() {
+            return connection->received - connection->nextToWrite <
+                   MAX_IN_FLIGHT;
+        });
+        number = connection->received++;
+    }
+
+    {
+        lock_guard<mutex> guard(taskLock);
+        taskQueue.push_back(Task{connection, number, line});
+    }
+    taskReady.notify_one();
+}
+
+/**
+ * Reads request lines from a connection and queues them until the client
+ * closes it or sends quit, then waits for every response to be written
+ *
+ * connection: connection to be served
+ */
+void serveConnection(shared_ptr<Connection> connection) {
+    thread writer(writeResponses, connection);
+    vector<char> buffer(READ_BUFFER_SIZE);
+    string line;
+    bool open = true;
+
+    while (open) {
+        ssize_t n = read(connection->inFd, buffer.data(), buffer.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+
+        for (ssize_t i = 0; i < n && open; i++) {
+            if (buffer[i] != '\n') {
+                line += buffer[i];
+                continue;
+            }
+
+            // Accept CRLF line endings
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+
+            if (line == QUIT_COMMAND) {
+                open = false;
+                break;
+            }
+
+            queueRequest(connection, line);
+            line.clear();
+        }
+    }
+
+    // The last request may end at the end of input instead of a newline
+    if (open) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && line != QUIT_COMMAND) {
+            queueRequest(connection, line);
+        }
+    }
+
+    // Wait until every queued request has been answered, then stop the
+    // writer
+    {
+        unique_lock<mutex> guard(connection->lock);
+        connection->written.wait(guard, [&]() {
+            return connection->nextToWrite == connection->received;
+        });
+        connection->closing = true;
+    }
+    connection->readyToWrite.notify_one();
+    writer.join();
+
+    close(connection->inFd);
+    if (connection->outFd != connection->inFd) close(connection->outFd);
+}
+
+/**
+ * Main function that loads the graph, starts the workers and serves requests
+ *
+ * argc: number of command line args
+ * argv: array containing command line args
+ */
+int main(int argc, char* argv[]) {
+    const char* socketPath = nullptr;
+    int threadCount = DEFAULT_THREADS;
+
+    if (argc < ARG_TWO) {
+        cerr << USAGE;
+        return 1;
+    }
+
+    // Parse the optional socket path and thread count
+    for (int i = ARG_TWO; i < argc; i++) {
+        if (strcmp(argv[i], THREADS_FLAG) == 0 && i + 1 < argc) {
+            threadCount = max(1, atoi(argv[++i]));
+        } else if (socketPath == nullptr) {
+            socketPath = argv[i];
+        } else {
+            cerr << USAGE;
+            return 1;
+        }
+    }
+
+    // Load weighted edges so both path kinds and the spanning tree are served
+    ActorGraph actorGraph;
+    if (!actorGraph.loadFromFile(actorGraph, argv[1], true)) {
+        return 1;
+    }
+
+    // A client that disconnects early must not end the program
+    signal(SIGPIPE, SIG_IGN);
+
+    QueryService service(actorGraph);
+    vector<thread> workers;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(workerLoop, ref(service), ref(actorGraph));
+    }
+
+    // Serve a single session over stdin and stdout
+    if (socketPath == nullptr) {
+        serveConnection(make_shared<Connection>(STDIN_FILENO, STDOUT_FILENO));
+
+        stopWorkers(workers);
+        return 0;
+    }
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+
+    // Replace a socket left behind by an earlier run, but nothing else
+    struct stat existing;
+    if (lstat(socketPath, &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            cerr << "Failed to listen on " << socketPath
+                 << ": file exists and is not a socket" << endl;
+            stopWorkers(workers);
+            return 1;
+        }
+        unlink(socketPath);
+    }
+
+    if (listenFd < 0 ||
+        ::bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 ||
+        listen(listenFd, LISTEN_BACKLOG) < 0) {
+        cerr << "Failed to listen on " << socketPath << ": " << strerror(errno)
+             << endl;
+        stopWorkers(workers);
+        return 1;
+    }
+
+    cerr << "Serving " << argv[1] << " on " << socketPath << endl;
+
+    // Serve each client on its own reader thread
+    while (true) {
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Failed to accept: " << strerror(errno) << endl;
+            break;
+        }
+
+        thread(serveConnection, make_shared<Connection>(clientFd, clientFd))
+            .detach();
+    }
+
+    stopWorkers(workers);
+    return 1;
+}
@@ -0,0 +1,63 @@
+/*
+ * graphgen.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Program that writes a synthetic actor/movie file of a given size, for
+ * benchmarking the other tools at IMDB scale
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "GraphGenerator.hpp"
+
+#define ARG_TWO 2
+#define ARG_THREE 3
+#define ARG_FOUR 4
+#define SEED_FLAG "--seed"
+#define MAX_CAST_FLAG "--max-cast"
+#define USAGE \
+    "Usage: ./graphgen <out.tsv> <actors> <movies> [--seed n] " \
+    "[--max-cast n]\n"
+
+using namespace std;
+
+/**
+ * Main function that parses command line args and writes the file
+ *
+ * argc: number of command line args
+ * argv: array containing command line args
+ */
+int main(int argc, char* argv[]) {
+    if (argc < ARG_FOUR) {
+        cerr << USAGE;
+        return 1;
+    }
+
+    GraphShape shape(atoi(argv[ARG_TWO]), atoi(argv[ARG_THREE]));
+    if (shape.actors <= 0 || shape.movies <= 0) {
+        cerr << USAGE;
+        return 1;
+    }
+
+    // Parse the optional flags that follow the sizes
+    for (int i = ARG_FOUR; i < argc; i += ARG_TWO) {
+        if (i + 1 == argc) {
+            cerr << USAGE;
+            return 1;
+        }
+
+        if (strcmp(argv[i], SEED_FLAG) == 0) {
+            shape.seed = strtoull(argv[i + 1], nullptr, 10);
+        } else if (strcmp(argv[i], MAX_CAST_FLAG) == 0) {
+            shape.maxCast = max(shape.minCast, atoi(argv[i + 1]));
+        } else {
+            cerr << USAGE;
+            return 1;
+        }
+    }
+
+    return generateGraph(shape, argv[1]) ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/*
+ * graphreport.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Program that reports the shape of a graph and the memory it uses: node and
+ * link counts, the degrees of actors and movies, the largest casts, the sizes
+ * of the components, and the bytes of each structure
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "ActorGraph.cpp"
+#include "ActorGraph.hpp"
+#include "GraphReport.hpp"
+#include "OutputWriter.hpp"
+
+#define ARG_TWO 2
+#define ARG_THREE 3
+#define TOP_FLAG "--top"
+#define HEAVY_CAST_FLAG "--heavy-cast"
+#define USAGE \
+    "Usage: ./graphreport <movie_cast.tsv> <out.tsv> [--top n] " \
+    "[--heavy-cast actors]\n"
+#define ACTORS "#ACTORS: "
+#define MOVIES "#MOVIES: "
+#define LINKS "#LINKS: "
+#define HEAVY_MOVIES "#HEAVY MOVIES: "
+#define DUPLICATE_ROWS "#DUPLICATE ROWS: "
+#define MALFORMED_ROWS "#MALFORMED ROWS: "
+#define AVERAGE_ACTOR_DEGREE "#AVERAGE ACTOR DEGREE: "
+#define AVERAGE_MOVIE_DEGREE "#AVERAGE MOVIE DEGREE: "
+#define MAX_ACTOR_DEGREE "#MAX ACTOR DEGREE: "
+#define MAX_MOVIE_DEGREE "#MAX MOVIE DEGREE: "
+#define COMPONENTS "#COMPONENTS: "
+#define HELD_BYTES "#HELD BYTES: "
+#define DEGREE_HEADER "degrees\tactors\tmovies"
+#define CAST_HEADER "movie\tyear\tcast"
+#define COMPONENT_SIZE_HEADER "actors\tcomponents"
+#define LARGEST_COMPONENT_HEADER "component\tactors"
+#define STRUCTURE_HEADER "structure\tbytes\ton_demand"
+#define TAB_CHAR '\t'
+#define RANGE_CHAR '-'
+
+using namespace std;
+
+/**
+ * Appends a number with six decimals
+ *
+ * out: string to append to
+ * value: number to be appended
+ */
+static void appendDecimal(string& out, double value) {
+    char digits[32];
+    snprintf(digits, sizeof(digits), "%.6f", value);
+    out += digits;
+}
+
+/**
+ * Appends the range of counts in a power of two bucket, such as 4-7
+ *
+ * out: string to append to
+ * bucket: bucket whose range is appended
+ */
+static void appendBucket(string& out, size_t bucket) {
+    long low = bucket == 0 ? 0 : 1L << bucket;
+    out += to_string(low);
+    out += RANGE_CHAR;
+    out += to_string((1L << (bucket + 1)) - 1);
+}
+
+/**
+ * Returns the count of a bucket, or 0 past the end of the histogram
+ *
+ * histogram: histogram to be read
+ * bucket: bucket whose count is returned
+ */
+static long bucketCount(const vector<long>& histogram, size_t bucket) {
+    return bucket < histogram.size() ? histogram[bucket] : 0;
+}
+
+/**
+ * Main function that parses command line args, builds the graph, and writes
+ * the report
+ *
+ * argc: number of command line args
+ * argv: array containing command line args
+ */
+int main(int argc, char* argv[]) {
+    if (argc < ARG_THREE) {
+        cerr << USAGE;
+        return 1;
+    }
+
+    // Number of largest casts and components listed
+    int top = REPORT_TOP;
+
+    // Casts above this size are counted as heavy, if set
+    int heavyCast = 0;
+
+    // Parse the optional flags that follow the output file
+    for (int i = ARG_THREE; i < argc; i += ARG_TWO) {
+        if (i + 1 == argc) {
+            cerr << USAGE;
+            return 1;
+        }
+
+        if (strcmp(argv[i], TOP_FLAG) == 0) {
+            top = max(0, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], HEAVY_CAST_FLAG) == 0 &&
+                   atoi(argv[i + 1]) > 0) {
+            heavyCast = atoi(argv[i + 1]);
+        } else {
+            cerr << USAGE;
+            return 1;
+        }
+    }
+
+    ActorGraph actorGraph;
+    if (!actorGraph.loadFromFile(actorGraph, argv[1], false)) {
+        return 1;
+    }
+    if (heavyCast > 0) {
+        actorGraph.setHeavyCast(actorGraph, heavyCast);
+    }
+
+    GraphReport report;
+    graphReport(actorGraph, top, report);
+
+    OutputWriter outFile(argv[ARG_TWO]);
+
+    // Counts of nodes and links
+    outFile.writeLine(ACTORS + to_string(report.actors));
+    outFile.writeLine(MOVIES + to_string(report.movies));
+    outFile.writeLine(LINKS + to_string(report.links));
+    outFile.writeLine(HEAVY_MOVIES + to_string(report.heavyMovies));
+    outFile.writeLine(DUPLICATE_ROWS + to_string(report.duplicateRows));
+    outFile.writeLine(MALFORMED_ROWS + to_string(report.malformedRows));
+    outFile.buffer() += AVERAGE_ACTOR_DEGREE;
+    appendDecimal(outFile.buffer(), report.averageActorDegree());
+    outFile.endLine();
+    outFile.buffer() += AVERAGE_MOVIE_DEGREE;
+    appendDecimal(outFile.buffer(), report.averageMovieDegree());
+    outFile.endLine();
+    outFile.writeLine(MAX_ACTOR_DEGREE + to_string(report.maxActorDegree));
+    outFile.writeLine(MAX_MOVIE_DEGREE + to_string(report.maxMovieDegree));
+
+    // Number of actors and movies in each range of degrees
+    outFile.writeLine(DEGREE_HEADER);
+    size_t buckets =
+        max(report.actorDegrees.size(), report.movieDegrees.size());
+    for (size_t b = 0; b < buckets; b++) {
+        string& line = outFile.buffer();
+        appendBucket(line, b);
+        line += TAB_CHAR;
+        line += to_string(bucketCount(report.actorDegrees, b));
+        line += TAB_CHAR;
+        line += to_string(bucketCount(report.movieDegrees, b));
+        outFile.endLine();
+    }
+
+    // Movies with the largest casts
+    outFile.writeLine(CAST_HEADER);
+    for (MovieNode* movieNode : report.largestCasts) {
+        string& line = outFile.buffer();
+        line += movieNode->movieName;
+        line += TAB_CHAR;
+        line += to_string(movieNode->year);
+        line += TAB_CHAR;
+        line += to_string(movieNode->actorVect.size());
+        outFile.endLine();
+    }
+
+    // Number of components in each range of sizes, then the largest
+    outFile.writeLine(COMPONENTS + to_string(report.components));
+    outFile.writeLine(COMPONENT_SIZE_HEADER);
+    for (size_t b = 0; b < report.componentSizes.size(); b++) {
+        string& line = outFile.buffer();
+        appendBucket(line, b);
+        line += TAB_CHAR;
+        line += to_string(report.componentSizes[b]);
+        outFile.endLine();
+    }
+    outFile.writeLine(LARGEST_COMPONENT_HEADER);
+    for (size_t c = 0; c < report.largestComponents.size(); c++) {
+        string& line = outFile.buffer();
+        line += to_string(c + 1);
+        line += TAB_CHAR;
+        line += to_string(report.largestComponents[c]);
+        outFile.endLine();
+    }
+
+    // Bytes of each structure, those built on demand marked
+    outFile.writeLine(STRUCTURE_HEADER);
+    for (const StructureBytes& structure : report.structures) {
+        string& line = outFile.buffer();
+        line += structure.name;
+        line += TAB_CHAR;
+        line += to_string(structure.bytes);
+        line += TAB_CHAR;
+        line += structure.onDemand ? "yes" : "no";
+        outFile.endLine();
+    }
+    outFile.writeLine(HELD_BYTES + to_string(report.heldBytes()));
+
+    return outFile.close() ? 0 : 1;
+}
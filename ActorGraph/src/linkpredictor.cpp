@@ -9,410 +9,181 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <queue>
 #include <sstream>
 
 #include "ActorGraph.cpp"
 #include "ActorGraph.hpp"
+#include "LinkPredictor.hpp"
+#include "NameIndex.hpp"
+#include "OutputWriter.hpp"
+#include "PersonalizedPageRank.hpp"
+#include "SearchStats.hpp"
 
-#define MAX_CANDIDATES 4
 #define TAB_CHAR '\t'
-#define INDEX_TWO 2
 #define ARG_TWO 2
 #define ARG_THREE 3
 #define ARG_FOUR 4
+#define ARG_FIVE 5
+#define FROM_FLAG "--from"
+#define TO_FLAG "--to"
+#define HEAVY_CAST_FLAG "--heavy-cast"
+#define STATS_FLAG "--stats"
+#define STATS_FORMAT_FLAG "--stats-format"
+#define FUZZY_FLAG "--fuzzy"
+#define SCORER_FLAG "--scorer"
+#define WALKS_FLAG "--walks"
+#define SEED_FLAG "--seed"
+#define THREADS_FLAG "--threads"
+#define COMMON_SCORER "common"
+#define PPR_SCORER "ppr"
+#define CSV_FORMAT "csv"
+#define JSON_FORMAT "json"
+#define COLLABORATED_KIND "collaborated"
+#define UNCOLLABORATED_KIND "uncollaborated"
+#define PPR_KIND "ppr"
+#define USAGE \
+    "Usage: ./linkpredictor <movie_cast.tsv> <actors.tsv> <collab.tsv> " \
+    "<uncollab.tsv> [--from year] [--to year] [--heavy-cast actors] " \
+    "[--stats file] [--stats-format csv|json] [--scorer common|ppr] " \
+    "[--walks count] [--seed seed] [--threads count] [--fuzzy edits]\n"
 #define HEADER "Actor1,Actor2,Actor3,Actor4"
 
 using namespace std;
 
 /**
- * Prints the 4 highest priority actor names to a file
+ * Main function of the program that parses command line input, builds
+ * graph, and finds actors that have collaborated with and are likely to
+ * collaborate with a given actor
  *
- * actorGraph: graph with actor and movie nodes
- * bestPredictions: priority queue containing the candidates to be printed
- * outFile: file to be printed to
+ * argc: number of command line arguments argv: vector
+ * containing command line arguments
  */
-void printCandidates(
-    ActorGraph& actorGraph,
-    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
-                   PriorityComparator>
-        bestPredictions,
-    ofstream& outFile) {
-    int count = 0;
-
-    vector<ActorNode*> checkSameNode;
-
-    bool sameNodes = false;
-
-    // Print 4 highest priority candidates or until queue empty
-    while (!bestPredictions.empty() && count < MAX_CANDIDATES) {
-        pair<ActorNode*, int> nodePair = bestPredictions.top();
-        ActorNode* node = nodePair.first;
-        bestPredictions.pop();
-
-        // Check if node printed already
-        for (int i = 0; i < checkSameNode.size(); i++) {
-            if (checkSameNode[i] == node) {
-                sameNodes = true;
-            }
+int main(int argc, char* argv[]) {
+    // Years collaborations are counted in, all of them by default
+    YearWindow window;
+
+    // Casts above this size are left out of the scores, if set
+    int heavyCast = 0;
+
+    // File the stats of each query are written to, if any
+    const char* statsFilename = nullptr;
+    bool statsJson = false;
+
+    // Edits a name may be away from an actor's and still resolve to it, 0 to
+    // only take exact names
+    int fuzzyEdits = 0;
+
+    // Whether personalized PageRank ranks the actors instead of common
+    // neighbors, and the walks it takes for each query
+    bool usePpr = false;
+    int walks = PPR_WALKS;
+    uint64_t seed = PPR_SEED;
+    int threads = 1;
+
+    // Parse the optional flags that follow the output files
+    for (int i = ARG_FIVE; i < argc; i += ARG_TWO) {
+        if (i + 1 == argc) {
+            cerr << USAGE;
+            return 1;
         }
 
-        if (sameNodes) {
-            sameNodes = false;
-            continue;
+        if (strcmp(argv[i], FROM_FLAG) == 0) {
+            window.minYear = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], TO_FLAG) == 0) {
+            window.maxYear = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], HEAVY_CAST_FLAG) == 0 &&
+                   atoi(argv[i + 1]) > 0) {
+            heavyCast = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], STATS_FLAG) == 0) {
+            statsFilename = argv[i + 1];
+        } else if (strcmp(argv[i], STATS_FORMAT_FLAG) == 0 &&
+                   (strcmp(argv[i + 1], CSV_FORMAT) == 0 ||
+                    strcmp(argv[i + 1], JSON_FORMAT) == 0)) {
+            statsJson = strcmp(argv[i + 1], JSON_FORMAT) == 0;
+        } else if (strcmp(argv[i], FUZZY_FLAG) == 0 &&
+                   atoi(argv[i + 1]) >= 0) {
+            fuzzyEdits = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], SCORER_FLAG) == 0 &&
+                   (strcmp(argv[i + 1], COMMON_SCORER) == 0 ||
+                    strcmp(argv[i + 1], PPR_SCORER) == 0)) {
+            usePpr = strcmp(argv[i + 1], PPR_SCORER) == 0;
+        } else if (strcmp(argv[i], WALKS_FLAG) == 0 &&
+                   atoi(argv[i + 1]) > 0) {
+            walks = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], SEED_FLAG) == 0) {
+            seed = strtoull(argv[i + 1], nullptr, 10);
+        } else if (strcmp(argv[i], THREADS_FLAG) == 0 &&
+                   atoi(argv[i + 1]) > 0) {
+            threads = atoi(argv[i + 1]);
+        } else {
+            cerr << USAGE;
+            return 1;
         }
-
-        checkSameNode.push_back(node);
-
-        count++;
-
-        // Print actor name
-        outFile << node->actorName + TAB_CHAR;
     }
 
-    outFile << endl;
-
-    // Empty rest of priority queue
-    while (!bestPredictions.empty()) {
-        bestPredictions.pop();
-    }
-}
+    ActorGraph actorGraph;
 
-/**
- * Function that finds actors that have collaborated with a given actor and
- * directs output to outFile
- *
- * actorGraph: graph to search
- * query: actor to find collaborated actors
- * outFile: file to direct output to
- */
-void collaboratedActors(ActorGraph& actorGraph, ActorNode* query,
-                        ofstream& outFile) {
-    // Declare queue for query neighbors
-    queue<ActorNode*> q;
-
-    // Vector to check if string has already been added to queue
-    vector<ActorNode*> checkNodes;
-
-    // For every movie the actor is in, look at all of its actors
-    for (MovieNode* movieNode : query->movieVect) {
-        for (ActorNode* neighbor : movieNode->actorVect) {
-            // Skip if neighbor found is the query
-            if (neighbor == query) {
-                continue;
-            }
+    // Create actor graph with actor and movie nodes
+    actorGraph.loadFromFile(actorGraph, argv[1], false);
 
-            // Add valid nodes to queue
-            q.push(neighbor);
-        }
+    // Names are only indexed when misspelled names are resolved
+    unique_ptr<NameIndex> nameIndex;
+    if (fuzzyEdits > 0) {
+        nameIndex = make_unique<NameIndex>(actorGraph);
     }
-
-    // Priority queue for neighbors of query
-    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
-                   PriorityComparator>
-        bestPredictions;
-
-    // Loop until queue is empty
-    while (!q.empty()) {
-        // Number of edges between query and common neighbor
-        int queryToCommonNeighbor = 0;
-
-        // Number of edges between candidate and common neighbor
-        int candidateToCommonNeighbor = 0;
-
-        // Counter for queryToCommonNeighbor
-        int edgeCounterOne = 0;
-
-        // Counter for candidateToCommonNeighbor
-        int edgeCounterTwo = 0;
-
-        // Priority of candidate
-        int priority = 0;
-
-        // Candidate is the highest priority node
-        ActorNode* candidate = q.front();
-        q.pop();
-
-        // Vector of common nodes between query and candidate
-        vector<tuple<ActorNode*, int, int>> commonNeighbors;
-
-        // Checks if a triangle can be made between query, candidate, and common
-        // neighbor
-        bool foundQuery = false;
-
-        // For each movie candidate actor is in, look at each of the movie's
-        // actors
-        for (MovieNode* edgeOne : candidate->movieVect) {
-            for (ActorNode* commonNeighbor : edgeOne->actorVect) {
-                // Skip if the common neighbor is the candidate or the query
-                if (commonNeighbor == candidate || commonNeighbor == query) {
-                    continue;
-                }
-
-                // Increment number of edges between candidate and common
-                // neighbor
-                edgeCounterOne++;
-
-                // For each movie common neighbor is in, look at each actor in
-                // that movie
-                for (MovieNode* edgeTwo : commonNeighbor->movieVect) {
-                    for (ActorNode* potentialQuery : edgeTwo->actorVect) {
-                        // If edge between common neighbor and query exists,
-                        // common neighbor is found
-                        if (potentialQuery == query) {
-                            // Increment number of edges between query and
-                            // common neighbor
-                            edgeCounterTwo++;
-                            foundQuery = true;
-                        }
-                    }
-                }
-
-                // If triangle made, push common neighbor to vector to calculate
-                // priority
-                if (foundQuery) {
-                    foundQuery = false;
-                    commonNeighbors.push_back(make_tuple(
-                        commonNeighbor, edgeCounterOne, edgeCounterTwo));
-                }
-
-                // Reset counters
-                edgeCounterOne = 0;
-                edgeCounterTwo = 0;
-            }
-        }
-
-        // Calculate priority for candidate
-        for (int i = 0; i < commonNeighbors.size(); i++) {
-            candidateToCommonNeighbor = get<1>(commonNeighbors[i]);
-            queryToCommonNeighbor = get<INDEX_TWO>(commonNeighbors[i]);
-
-            // Priority is sum of each common neighbor's product of edges from
-            // candidate to common neighbor and query to common neighbor
-            priority += candidateToCommonNeighbor * queryToCommonNeighbor;
-        }
-
-        // Push candidate to priority queue
-        bestPredictions.push(make_pair(candidate, priority));
+    auto findActor = [&](const string& name) {
+        return nameIndex ? nameIndex->resolve(name, fuzzyEdits)
+                         : actorGraph.get(actorGraph, name);
+    };
+
+    LinkPredictor linkPredictor(actorGraph);
+    PersonalizedPageRank pageRank(actorGraph, walks, threads, seed);
+
+    // Trade exactness for speed on graphs with giant casts if asked for
+    if (heavyCast > 0) {
+        actorGraph.setHeavyCast(actorGraph, heavyCast);
+        linkPredictor.skipHeavyMovies(true);
+        pageRank.skipHeavyMovies(true);
     }
 
-    printCandidates(actorGraph, bestPredictions, outFile);
-}
-
-/**
- * Function that finds actors that have not yet collaborated with a given actor
- * but are the most likely to be collaborated with
- *
- * actorGraph: graph to search
- * query: actor to find uncollaborated actors
- * outFile: file to direct output to
- */
-void uncollaboratedActors(ActorGraph& actorGraph, ActorNode* query,
-                          ofstream& outFile) {
-    // Queue for query second neighbors
-    queue<ActorNode*> q;
-
-    // Checks if first neighbor already searched
-    vector<ActorNode*> checkFirstNeighbors;
-
-    // CHecks if seoncd neighbor already searched
-    vector<ActorNode*> checkSecondNeighbors;
-
-    // Node already checked
-    bool nodeExists = false;
-
-    // For every movie query actor in, look at each of its actors
-    for (MovieNode* edgeOne : query->movieVect) {
-        for (ActorNode* firstNeighbor : edgeOne->actorVect) {
-            // Skip if actor is the query actor
-            if (firstNeighbor == query) {
-                continue;
-            }
-
-            // If first neighbor has been added as a second neighbor, delete it
-            // from the second neighbor vector
-            for (int i = 0; i < checkSecondNeighbors.size(); i++) {
-                if (checkSecondNeighbors[i] == firstNeighbor) {
-                    checkSecondNeighbors.erase(checkSecondNeighbors.begin() +
-                                               i);
-                }
-            }
-
-            // Add to first neighbor vector
-            checkFirstNeighbors.push_back(firstNeighbor);
-
-            // For each movie the first neighbor is in, look at all of its
-            // actors
-            for (MovieNode* edgeTwo : firstNeighbor->movieVect) {
-                // Skip if first edge and second edge are the same
-                if (edgeTwo == edgeOne) {
-                    continue;
-                }
+    // Predictions reused for every actor
+    vector<ActorNode*> predictions;
+    vector<ActorNode*> uncollaborated;
 
-                for (ActorNode* secondNeighbor : edgeTwo->actorVect) {
-                    // Skip if second neighbor is the first neighbor or the
-                    // query actor
-                    if (secondNeighbor == firstNeighbor ||
-                        secondNeighbor == query) {
-                        continue;
-                    }
-
-                    // Skip if second neighbor is already a first neighbor
-                    for (int i = 0; i < checkFirstNeighbors.size(); i++) {
-                        if (checkFirstNeighbors[i] == secondNeighbor) {
-                            nodeExists = true;
-                        }
-                    }
-
-                    // Skip if second neighbor is already a second neighbor
-                    for (int i = 0; i < checkSecondNeighbors.size(); i++) {
-                        if (checkSecondNeighbors[i] == secondNeighbor) {
-                            nodeExists = true;
-                        }
-                    }
-
-                    if (nodeExists) {
-                        nodeExists = false;
-                        continue;
-                    }
-
-                    // Add to second neighbor vector
-                    checkSecondNeighbors.push_back(secondNeighbor);
-
-                    // Push to queue as a candidate
-                    q.push(secondNeighbor);
-                }
-            }
-        }
-    }
-
-    // Priority queue for second neighors of query
-    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
-                   PriorityComparator>
-        bestPredictions;
-
-    // Loop until queue empty
-    while (!q.empty()) {
-        // Number of edges between query and common neighbor
-        int queryToCN = 0;
-
-        // Number of edges between candidate and common neighbor
-        int CNtoCandidate = 0;
-
-        // Counter for queryToCommonNeighbor
-        int edgeCounterOne = 0;
-
-        // Counter for candidateToCommonNeighbor
-        int edgeCounterTwo = 0;
-
-        // Priority of candidate
-        int priority = 0;
-
-        // Candidate is the highest priority node
-        ActorNode* candidate = q.front();
-        q.pop();
-
-        // Check if second neighbor is still a second neighbor
-        if (find(checkSecondNeighbors.begin(), checkSecondNeighbors.end(),
-                 candidate) == checkSecondNeighbors.end()) {
-            continue;
-        }
-
-        // Vector of common nodes between query and candidate
-        vector<tuple<ActorNode*, int, int>> commonNeighbors;
-
-        // Checks if there is a link between a query, commonNeighbor, and the
-        // candidate
-        bool foundCandidate = false;
-
-        // For each movie query actor in, look at each of its actors
-        for (MovieNode* edgeOne : query->movieVect) {
-            for (ActorNode* commonNeighbor : edgeOne->actorVect) {
-                // Increment number of edges between query and common neighbor
-                edgeCounterOne++;
-
-                // Skip if common neighbor is the query or the candidate
-                if (commonNeighbor == query || commonNeighbor == candidate) {
-                    edgeCounterOne = 0;
-                    continue;
-                }
-
-                // For each movie common neighbor is in, look at each of its
-                // actors
-                for (MovieNode* edgeTwo : commonNeighbor->movieVect) {
-                    for (ActorNode* potentialCandidate : edgeTwo->actorVect) {
-                        // Candidate found
-                        if (potentialCandidate == candidate) {
-                            // If candidate already found and is valid,
-                            // increment number of edges between common neighbor
-                            // and candidate
-                            for (int i = 0; i < commonNeighbors.size(); i++) {
-                                if (get<0>(commonNeighbors[i]) == candidate) {
-                                    get<INDEX_TWO>(commonNeighbors[i])++;
-                                }
-                            }
-                            edgeCounterTwo++;
-                            foundCandidate = true;
-                        }
-                    }
-                }
-
-                // If valid link between query and candidate, push to
-                // commonNeighbors to calculate priority
-                if (foundCandidate) {
-                    foundCandidate = false;
-                    commonNeighbors.push_back(make_tuple(
-                        commonNeighbor, edgeCounterOne, edgeCounterTwo));
-                }
-
-                edgeCounterOne = 0;
-                edgeCounterTwo = 0;
-            }
-        }
+    // Open input file
+    ifstream inFile(argv[ARG_TWO]);
 
-        // Calculate priority for candidate
-        for (int i = 0; i < commonNeighbors.size(); i++) {
-            queryToCN = get<1>(commonNeighbors[i]);
-            CNtoCandidate = get<INDEX_TWO>(commonNeighbors[i]);
-            priority += queryToCN * CNtoCandidate;
+    // Open stats file if asked for, starting with the CSV header
+    ofstream statsFile;
+    SearchStats stats;
+    string statsLine;
+    if (statsFilename != nullptr) {
+        statsFile.open(statsFilename);
+        if (!statsJson) {
+            appendStatsHeader(statsLine);
+            statsFile << statsLine;
         }
-
-        // Push candidate to priority queue
-        bestPredictions.push(make_pair(candidate, priority));
     }
 
-    printCandidates(actorGraph, bestPredictions, outFile);
-}
-
-/**
- * Main function of the program that parses command line input, builds
- * graph, and finds actors that have collaborated with and are likely to
- * collaborate with a given actor
- *
- * argc: number of command line arguments argv: vector
- * containing command line arguments
- */
-int main(int argc, char* argv[]) {
-    ActorGraph actorGraph;
-
-    // Create actor graph with actor and movie nodes
-    actorGraph.loadFromFile(actorGraph, argv[1], false);
-
-    // Open input file
-    ifstream inFile(argv[ARG_TWO]);
+    // Stats are only gathered when they are written
+    SearchStats* statsPtr = statsFilename != nullptr ? &stats : nullptr;
 
     bool haveHeader = false;
 
     // Open two output files
-    ofstream collaborateOutFile(argv[ARG_THREE]);
-    ofstream uncollaborateOutFile(argv[ARG_FOUR]);
+    OutputWriter collaborateOutFile(argv[ARG_THREE]);
+    OutputWriter uncollaborateOutFile(argv[ARG_FOUR]);
 
     // Print header into each file
-    collaborateOutFile << HEADER << endl;
-    uncollaborateOutFile << HEADER << endl;
+    collaborateOutFile.writeLine(HEADER);
+    uncollaborateOutFile.writeLine(HEADER);
 
     // Loop until end of input file reached
     while (inFile) {
@@ -442,24 +213,86 @@ int main(int argc, char* argv[]) {
         }
 
         // Find actorNode corresponding to actor name
-        ActorNode* startActorNode = actorGraph.get(actorGraph, actor);
+        ActorNode* startActorNode = findActor(actor);
 
-        // Print blank line if actor node not found
+        // Print blank line if actor node not found, with zeroed stats rows
         if (startActorNode == nullptr) {
-            collaborateOutFile << endl;
-            uncollaborateOutFile << endl;
+            collaborateOutFile.endLine();
+            uncollaborateOutFile.endLine();
+
+            if (statsPtr != nullptr) {
+                stats.clear();
+                statsLine.clear();
+                if (usePpr) {
+                    appendStats(statsLine, PPR_KIND, actor, "", stats,
+                                statsJson);
+                } else {
+                    appendStats(statsLine, COLLABORATED_KIND, actor, "", stats,
+                                statsJson);
+                    appendStats(statsLine, UNCOLLABORATED_KIND, actor, "",
+                                stats, statsJson);
+                }
+                statsFile << statsLine;
+            }
+            continue;
+        }
+
+        // Rank both kinds of actors from the same walks
+        if (usePpr) {
+            predictions.clear();
+            uncollaborated.clear();
+            pageRank.predict(startActorNode, predictions, uncollaborated,
+                             window, statsPtr);
+            LinkPredictor::appendCandidates(collaborateOutFile.buffer(),
+                                            predictions);
+            collaborateOutFile.endLine();
+            LinkPredictor::appendCandidates(uncollaborateOutFile.buffer(),
+                                            uncollaborated);
+            uncollaborateOutFile.endLine();
+
+            if (statsPtr != nullptr) {
+                statsLine.clear();
+                appendStats(statsLine, PPR_KIND, actor, "", stats, statsJson);
+                statsFile << statsLine;
+            }
             continue;
         }
 
         // Find collaborated actors
-        collaboratedActors(actorGraph, startActorNode, collaborateOutFile);
+        predictions.clear();
+        linkPredictor.collaboratedActors(startActorNode, predictions, window,
+                                         statsPtr);
+        LinkPredictor::appendCandidates(collaborateOutFile.buffer(),
+                                        predictions);
+        collaborateOutFile.endLine();
+
+        if (statsPtr != nullptr) {
+            statsLine.clear();
+            appendStats(statsLine, COLLABORATED_KIND, actor, "", stats,
+                        statsJson);
+            statsFile << statsLine;
+        }
 
         // Find actors most likely to collaborate
-        uncollaboratedActors(actorGraph, startActorNode, uncollaborateOutFile);
+        predictions.clear();
+        linkPredictor.uncollaboratedActors(startActorNode, predictions,
+                                           window, statsPtr);
+        LinkPredictor::appendCandidates(uncollaborateOutFile.buffer(),
+                                        predictions);
+        uncollaborateOutFile.endLine();
+
+        if (statsPtr != nullptr) {
+            statsLine.clear();
+            appendStats(statsLine, UNCOLLABORATED_KIND, actor, "", stats,
+                        statsJson);
+            statsFile << statsLine;
+        }
     }
 
     // Close all files
     inFile.close();
-    collaborateOutFile.close();
-    uncollaborateOutFile.close();
+    statsFile.close();
+    bool collaborateWritten = collaborateOutFile.close();
+    bool uncollaborateWritten = uncollaborateOutFile.close();
+    return collaborateWritten && uncollaborateWritten ? 0 : 1;
 }
@@ -4,229 +4,174 @@
  * Date: 11/27/19
  *
  * Program that outputs each edge connection within a the optimal path to
- * connect all nodes based on their weight
+ * connect all nodes based on their weight. With a delta, it instead updates a
+ * saved spanning forest with the delta's links and outputs the edges that
+ * changed. The graph is saved along with the forest, so the next delta needs
+ * only the saved state
  */
 
 #include <bits/stdc++.h>
 
 #include "ActorGraph.cpp"
 #include "ActorGraph.hpp"
+#include "MovieTraveler.hpp"
+#include "OutputWriter.hpp"
+#include "SearchStats.hpp"
 
-#define LEFT_BRACKET "("
-#define LEFT_ARROW ")<--["
-#define MOVIE_DELIM "#@"
-#define RIGHT_ARROW "]-->("
-#define RIGHT_BRACKET ")"
-#define NODE_CONNECTED "#NODE CONNECTED: "
-#define EDGE_CHOSEN "#EDGE CHOSEN: "
-#define TOTAL_EDGE_WEIGHTS "TOTAL EDGE WEIGHTS: "
 #define ARG_TWO 2
+#define ARG_THREE 3
+#define STATS_FLAG "--stats"
+#define STATS_FORMAT_FLAG "--stats-format"
+#define STATE_FLAG "--state"
+#define DELTA_FLAG "--delta"
+#define GRAPH_SUFFIX ".graph"
+#define CSV_FORMAT "csv"
+#define JSON_FORMAT "json"
+#define MST_KIND "mst"
+#define USAGE \
+    "Usage: ./movietraveler <movie_cast.tsv> <out.tsv> [--state file] " \
+    "[--delta delta.tsv] [--stats file] [--stats-format csv|json]\n"
 #define HEADER "(actor)<--[movie#@year]-->(actor)"
+#define CHANGE_HEADER "+|-(actor)<--[movie#@year]-->(actor)"
 
 using namespace std;
 
-// Struct defining a disjoint set that utilizes find and union
-struct DisjointSets {
-    // Union by height
-    vector<int> ranks;
-
-    // Mapping of an index and actor node and its parents index
-    unordered_map<int, pair<int, ActorNode*>> data;
-
-    /**
-     * Constructor that initializes a disjoint set
-     *
-     * actorGraph: graph of actor and movie nodes
-     * dataMap: mapping of an index and actor nodes and its parents index
-     */
-    DisjointSets(ActorGraph& actorGraph,
-                 unordered_map<int, pair<int, ActorNode*>> dataMap) {
-        data = dataMap;
-
-        // Initialize ranks vector to be same size as data, filled with zeros
-        for (auto node : data) {
-            ranks.push_back(0);
-        }
-    }
-
-    /**
-     * Uses path compression to find the sentinel node's index of a given index
-     *
-     * a: index of node whose parent to be found
-     */
-    int find(int a) {
-        vector<int> path;
-
-        // Traverse to parent
-        while (data[a].first != -1) {
-            path.push_back(a);
-            a = data[a].first;
+/**
+ * Main function that parses command line args and runs program
+ *
+ * argc: number of command line args
+ * argv: array containing command line args
+ */
+int main(int argc, char* argv[]) {
+    // File the stats of the spanning tree are written to, if any
+    const char* statsFilename = nullptr;
+    bool statsJson = false;
+
+    // File the spanning forest is kept in between runs, and the delta it is
+    // updated with, if any
+    const char* stateFilename = nullptr;
+    const char* deltaFilename = nullptr;
+
+    // Parse the optional flags that follow the output file
+    for (int i = ARG_THREE; i < argc; i += ARG_TWO) {
+        if (i + 1 == argc) {
+            cerr << USAGE;
+            return 1;
         }
 
-        // Compress path
-        path_compression(path, a);
-
-        // Return sentinel index
-        return a;
-    }
-
-    /**
-     * Optimization that attaches each node along the path to the sentinel
-     *
-     * path: path of node that find was called on
-     * sentinel: parent node of the path
-     */
-    void path_compression(vector<int> path, int sentinel) {
-        // For each node on the path, attach to sentinel
-        for (int node : path) {
-            data[node].first = sentinel;
+        if (strcmp(argv[i], STATS_FLAG) == 0) {
+            statsFilename = argv[i + 1];
+        } else if (strcmp(argv[i], STATE_FLAG) == 0) {
+            stateFilename = argv[i + 1];
+        } else if (strcmp(argv[i], DELTA_FLAG) == 0) {
+            deltaFilename = argv[i + 1];
+        } else if (strcmp(argv[i], STATS_FORMAT_FLAG) == 0 &&
+                   (strcmp(argv[i + 1], CSV_FORMAT) == 0 ||
+                    strcmp(argv[i + 1], JSON_FORMAT) == 0)) {
+            statsJson = strcmp(argv[i + 1], JSON_FORMAT) == 0;
+        } else {
+            cerr << USAGE;
+            return 1;
         }
     }
 
-    /**
-     * Attaches node of an index to another node of its index
-     *
-     * a: index of node
-     * b: index of another node
-     */
-    void sentinel_union(int a, int b) {
-        int sentinel_a = find(a);
-        int sentinel_b = find(b);
-
-        // Both sentinels not equal
-        if (sentinel_a != sentinel_b) {
-            // If b's rank higher, attach a to it
-            if (ranks[sentinel_a] < ranks[sentinel_b]) {
-                data[sentinel_a].first = sentinel_b;
-
-                // If a's rank higher, attach b to it
-            } else if (ranks[sentinel_a] > ranks[sentinel_b]) {
-                data[sentinel_b].first = sentinel_a;
-
-                // If both have same rank, attach a to b
-            } else {
-                data[sentinel_a].first = sentinel_b;
-                ranks[sentinel_b] += 1;
-            }
-        }
+    // The graph the saved forest spans is kept next to it, including every
+    // delta added so far
+    string graphFilename;
+    bool haveForest = false;
+    bool haveGraph = false;
+    if (stateFilename != nullptr) {
+        graphFilename = string(stateFilename) + GRAPH_SUFFIX;
+        haveForest = deltaFilename != nullptr && ifstream(stateFilename).good();
+        haveGraph = haveForest && ifstream(graphFilename).good();
     }
-};
-
-/**
- * Creates a minimum spanning tree that prints the optimal path to connect all
- * nodes in a graph
- *
- * actorGraph: graph of actor and movie nodes
- * ds: disjoint set to use find and union
- * data: map of an index and an actor node and its disjoint set value
- * indexMap: mapping of actor node and its index
- * outFile: file to be printed to
- */
-void movieTraveler(ActorGraph& actorGraph, DisjointSets& ds,
-                   unordered_map<int, pair<int, ActorNode*>> data,
-                   unordered_map<ActorNode*, int> indexMap, ofstream& outFile) {
-    // Number of actor nodes in graph
-    int nodeCount = actorGraph.getNodeCount(actorGraph);
-
-    // Number of edges connected is the number of nodes minus 1
-    int allNodesConnected = nodeCount - 1;
 
-    // Keeps track of total edge weight of MST
-    int totalEdgeWeights = 0;
-
-    // Increments number of edges
-    int edgeCount = 0;
-
-    // Vector of edges in graph
-    vector<MovieNode*> edgeVect = actorGraph.getEdgeVect(actorGraph);
-
-    // Sort edge vector by edgeWeight then by movie name
-    sort(edgeVect.begin(), edgeVect.end(), EdgeWeight());
-
-    int index = 0;
+    ActorGraph actorGraph;
 
-    // Loop until all nodes are connected or there are no more edges
-    while ((edgeCount != allNodesConnected) && (index < edgeVect.size())) {
-        // Find movie at index
-        MovieNode* movie = edgeVect[index];
+    // Create actor graph with actor and movie nodes, from the saved graph if
+    // a delta is added to a saved forest
+    actorGraph.loadFromFile(actorGraph,
+                            haveGraph ? graphFilename.c_str() : argv[1], true);
 
-        // Increment
-        index++;
+    // Open output file
+    OutputWriter outFile(argv[ARG_TWO]);
 
-        // For both actors being connected by the movie
-        for (ActorNode* actorNodeOne : movie->actorVect) {
-            for (ActorNode* actorNodeTwo : movie->actorVect) {
-                // Find index of sentinel for first actor
-                int sentinel_a = ds.find(indexMap.at(actorNodeOne));
+    SearchStats stats;
+    SearchStats* statsPtr = statsFilename != nullptr ? &stats : nullptr;
+    SpanningForest forest(actorGraph);
 
-                // FInd index of sentinel for second actor
-                int sentinel_b = ds.find(indexMap.at(actorNodeTwo));
+    if (deltaFilename == nullptr) {
+        // Print header to output file
+        outFile.writeLine(HEADER);
 
-                // If they are not the same sentinel, union them
-                if (sentinel_a != sentinel_b) {
-                    // Union them together
-                    ds.sentinel_union(sentinel_a, sentinel_b);
+        // Calculate optimal path to connect all nodes in graph
+        SpanningTree tree;
+        movieTraveler(actorGraph, tree, statsPtr);
 
-                    // Increment number of edges taken
-                    edgeCount++;
+        // Print each movie and its two actors
+        for (const TreeEdge& edge : tree.edges) {
+            appendTreeEdge(outFile.buffer(), edge);
+            outFile.endLine();
+        }
 
-                    // Add to the total edge weight of MST
-                    totalEdgeWeights += movie->edgeWeight;
+        // Print number of nodes connected, number of edges chosen, and total
+        // edge weight of MST, whose lines already end with newlines
+        appendTreeTotals(outFile.buffer(), tree);
 
-                    // Print movie and its two actors
-                    outFile << LEFT_BRACKET + actorNodeOne->actorName +
-                                   LEFT_ARROW + movie->movieName + MOVIE_DELIM;
-                    outFile << movie->year;
-                    outFile
-                        << RIGHT_ARROW + actorNodeTwo->actorName + RIGHT_BRACKET
-                        << endl;
-                }
+        if (stateFilename != nullptr) {
+            forest.build(tree);
+        }
+    } else {
+        // Start from the saved forest, or from the tree of the graph without
+        // the delta if none was saved yet
+        if (haveForest) {
+            if (!forest.load(stateFilename)) {
+                return 1;
             }
+        } else {
+            SpanningTree tree;
+            movieTraveler(actorGraph, tree);
+            forest.build(tree);
         }
-    }
-
-    // Print number of nodes connected, number of edges chosen, and total edge
-    // weight of MST
-    outFile << NODE_CONNECTED;
-    outFile << allNodesConnected + 1 << endl;
-    outFile << EDGE_CHOSEN;
-    outFile << edgeCount << endl;
-    outFile << TOTAL_EDGE_WEIGHTS;
-    outFile << totalEdgeWeights << endl;
-}
-
-/**
- * Main function that parses command line args and runs program
- *
- * argc: number of command line args
- * argv: array containing command line args
- */
-int main(int argc, char* argv[]) {
-    ActorGraph actorGraph;
 
-    // Create actor graph with actor and movie nodes
-    actorGraph.loadFromFile(actorGraph, argv[1], true);
-
-    // Open output file
-    ofstream outFile(argv[ARG_TWO]);
-
-    // Print header to output file
-    outFile << HEADER << endl;
+        if (!actorGraph.appendFromFile(actorGraph, deltaFilename)) {
+            return 1;
+        }
 
-    // Get map of index and its actor node and disjoint set value
-    unordered_map<int, pair<int, ActorNode*>> data =
-        actorGraph.getDSM(actorGraph);
+        // Only the delta's links are looked at
+        vector<TreeChange> changes;
+        forest.addLinks(actorGraph.getAppendedLinks(actorGraph), changes,
+                        statsPtr);
 
-    // Get index map
-    unordered_map<ActorNode*, int> indexMap =
-        actorGraph.getIndexMap(actorGraph);
+        // Print each edge added or removed, then the new totals
+        outFile.writeLine(CHANGE_HEADER);
+        for (const TreeChange& change : changes) {
+            appendTreeChange(outFile.buffer(), change);
+            outFile.endLine();
+        }
+        appendForestTotals(outFile.buffer(), actorGraph, forest);
+    }
 
-    // Create disjoint set object
-    DisjointSets ds(actorGraph, data);
+    // Close output file
+    if (!outFile.close()) {
+        return 1;
+    }
 
-    // Calculate optimal path to connect all nodes in graph
-    movieTraveler(actorGraph, ds, data, indexMap, outFile);
+    // Keep the forest and the graph with the delta for the next delta
+    if (stateFilename != nullptr &&
+        (!forest.save(stateFilename) ||
+         !actorGraph.saveToFile(actorGraph, graphFilename.c_str()))) {
+        return 1;
+    }
 
-    // Close output file
-    outFile.close();
+    // Write the stats of the spanning tree if asked for
+    if (statsFilename != nullptr) {
+        ofstream statsFile(statsFilename);
+        string line;
+        if (!statsJson) {
+            appendStatsHeader(line);
+        }
+        appendStats(line, MST_KIND, "", "", stats, statsJson);
+        statsFile << line;
+    }
 }
\ No newline at end of file
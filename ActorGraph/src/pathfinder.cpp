@@ -10,161 +10,66 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <queue>
 #include <sstream>
 
 #include "ActorGraph.cpp"
 #include "ActorGraph.hpp"
+#include "BatchPathFinder.hpp"
+#include "KShortestPaths.hpp"
+#include "NameIndex.hpp"
+#include "OutputWriter.hpp"
+#include "PathFinder.hpp"
+#include "SearchStats.hpp"
 
-#define LEFT_BRACKET "("
-#define RIGHT_BRACKET ")"
-#define LEFT_ARROW "--["
-#define MOVIE_DELIM "#@"
-#define RIGHT_ARROW "]-->"
 #define WEIGHTED 'w'
 #define UNWEIGHTED 'u'
 #define ARG_TWO 2
 #define ARG_THREE 3
 #define ARG_FOUR 4
+#define ARG_FIVE 5
+#define FROM_FLAG "--from"
+#define TO_FLAG "--to"
+#define REF_YEAR_FLAG "--ref-year"
+#define K_FLAG "--k"
+#define BATCH_FLAG "--batch"
+#define STATS_FLAG "--stats"
+#define STATS_FORMAT_FLAG "--stats-format"
+#define FUZZY_FLAG "--fuzzy"
+#define CSV_FORMAT "csv"
+#define JSON_FORMAT "json"
+#define PATH_KIND "path"
+#define USAGE \
+    "Usage: ./pathfinder <movie_cast.tsv> <u|w> <pairs.tsv> <out.tsv> " \
+    "[--from year] [--to year] [--ref-year year] [--k paths] " \
+    "[--batch searches] [--stats file] [--stats-format csv|json] " \
+    "[--fuzzy edits]\n"
 #define HEADER "(actor)--[movie#@year]-->(actor)--..."
 #define TAB_CHAR '\t'
 #define SIZE_OF_PAIR 2
+#define BATCH_QUERIES 4096
 
 using namespace std;
 
-// Vector to reset all data fields within an actor node
-vector<ActorNode*> resetVect;
-
 /**
- * Finds the shortest path from a given starting actor to a given ending actor
- * and prints the path taken
+ * Searches a batch of queries with their searches interleaved and writes
+ * their paths in order
  *
- * actorGraph: graph to traverse
- * startActor: actor to begin searching
- * endActor: actor to find
+ * batchPathFinder: engine that searches the batch
+ * queries: queries to be searched, cleared afterwards
+ * weighted: if true, use weighted paths
+ * window: years of the movies the paths may go through
+ * outFile: file the paths are written to
  */
-ActorNode* shortestPath(ActorGraph& actorGraph, string startActor,
-                        string endActor) {
-    // Priority queue of two pairs containing an actor node and its distance
-    priority_queue<pair<ActorNode*, int>, vector<pair<ActorNode*, int>>,
-                   EdgeComparator>
-        actorQueue;
-
-    // Get the node corresponding the the first actor name
-    ActorNode* firstActor = actorGraph.get(actorGraph, startActor);
-
-    // Get the node corresponding the the final actor name
-    ActorNode* finalActor = actorGraph.get(actorGraph, endActor);
-
-    // Set the first actor's distance to zero
-    firstActor->dist = 0;
-
-    // Push the node and its distance
-    actorQueue.push(make_pair(firstActor, firstActor->dist));
-
-    // Push node to reset vector
-    resetVect.push_back(firstActor);
-
-    // Checker if path from start to final actor found
-    bool pathFound = false;
-
-    // Loop until queue empty
-    while (!actorQueue.empty()) {
-        // Get the highest priority node and its distance
-        pair<ActorNode*, int> nodePair = actorQueue.top();
-        ActorNode* node = nodePair.first;
-        actorQueue.pop();
-
-        // If node has not been visited
-        if (node->done == false) {
-            // Set it to true
-            node->done = true;
-
-            // For each of this actor's neighbors,
-            for (MovieNode* movieNode : node->movieVect) {
-                for (ActorNode* actorNode : movieNode->actorVect) {
-                    // Set dist to the neighbor the node's current distance plus
-                    // the movie's edge weight
-                    int dist = node->dist + movieNode->edgeWeight;
-
-                    // If this new dist is less than the node's
-                    // distance, continue the path through this node
-                    if (dist < actorNode->dist) {
-                        // New node's previous is the movie
-                        movieNode->prev = node;
-
-                        // Movie's previous is the node before
-                        actorNode->prev = movieNode;
-
-                        // Distance is the new, shorter distance
-                        actorNode->dist = dist;
-
-                        // Push this node into the priority queue
-                        actorQueue.push(make_pair(actorNode, actorNode->dist));
-
-                        // Push into reset vector
-                        resetVect.push_back(actorNode);
-                    }
-
-                    // If final actor is found, path found
-                    if (actorNode == finalActor) {
-                        pathFound = true;
-                    }
-                }
-            }
-        }
-    }
-
-    // Return final node if path found
-    if (pathFound) {
-        pathFound = false;
-        return finalActor;
+static void writeBatch(BatchPathFinder& batchPathFinder,
+                       vector<PathQuery>& queries, bool weighted,
+                       const YearWindow& window, OutputWriter& outFile) {
+    batchPathFinder.shortestPaths(queries, weighted, window);
+    for (PathQuery& query : queries) {
+        outFile.writeLine(query.path);
     }
-
-    // If no path found, return nullptr
-    return nullptr;
-}
-
-// Forward Declarations printActor, printMovie
-void printActor(ofstream& outFile, ActorNode* node, ActorNode* start);
-void printMovie(ofstream& outFile, MovieNode* node, ActorNode* start);
-
-/**
- * Recursively prints an actor node and calls printMovie to print the next movie
- *
- * outFile: file to be written to
- * node: actorNode to be printed
- * start: first actor on path
- */
-void printActor(ofstream& outFile, ActorNode* node, ActorNode* start) {
-    // Keep traversing backwards on the path until the start node is found
-    if (node != start) {
-        printMovie(outFile, node->prev, start);
-    }
-
-    // Print the actor's name with its required format
-    outFile << LEFT_BRACKET;
-    outFile << node->actorName;
-    outFile << RIGHT_BRACKET;
-}
-
-/**
- * Recursively prints a movie node and calls printActor to print the next actor
- *
- * outFile: file to be written to
- * node: movieNode to be printed
- * start: first actor on path
- */
-void printMovie(ofstream& outFile, MovieNode* node, ActorNode* start) {
-    // Traverse to the movie node's previous actor
-    printActor(outFile, node->prev, start);
-
-    // Print movie name along with its required format
-    outFile << LEFT_ARROW;
-    outFile << node->movieName;
-    outFile << MOVIE_DELIM;
-    outFile << node->year;
-    outFile << RIGHT_ARROW;
+    queries.clear();
 }
 
 /**
@@ -175,6 +80,57 @@ void printMovie(ofstream& outFile, MovieNode* node, ActorNode* start) {
  * argv: vector containing command line arguments
  */
 int main(int argc, char* argv[]) {
+    // Years the paths are restricted to, all of them by default
+    YearWindow window;
+
+    // Number of paths printed for each pair, tab separated
+    int k = 1;
+
+    // Number of searches interleaved on the thread, 1 to search each pair on
+    // its own
+    int batch = 1;
+
+    // File the stats of each query are written to, if any
+    const char* statsFilename = nullptr;
+    bool statsJson = false;
+
+    // Edits a name may be away from an actor's and still resolve to it, 0 to
+    // only take exact names
+    int fuzzyEdits = 0;
+
+    // Parse the optional flags that follow the output file
+    for (int i = ARG_FIVE; i < argc; i += ARG_TWO) {
+        if (i + 1 == argc) {
+            cerr << USAGE;
+            return 1;
+        }
+
+        if (strcmp(argv[i], FROM_FLAG) == 0) {
+            window.minYear = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], TO_FLAG) == 0) {
+            window.maxYear = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], REF_YEAR_FLAG) == 0) {
+            window.refYear = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], K_FLAG) == 0 && atoi(argv[i + 1]) > 0) {
+            k = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], BATCH_FLAG) == 0 &&
+                   atoi(argv[i + 1]) > 0) {
+            batch = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], STATS_FLAG) == 0) {
+            statsFilename = argv[i + 1];
+        } else if (strcmp(argv[i], STATS_FORMAT_FLAG) == 0 &&
+                   (strcmp(argv[i + 1], CSV_FORMAT) == 0 ||
+                    strcmp(argv[i + 1], JSON_FORMAT) == 0)) {
+            statsJson = strcmp(argv[i + 1], JSON_FORMAT) == 0;
+        } else if (strcmp(argv[i], FUZZY_FLAG) == 0 &&
+                   atoi(argv[i + 1]) >= 0) {
+            fuzzyEdits = atoi(argv[i + 1]);
+        } else {
+            cerr << USAGE;
+            return 1;
+        }
+    }
+
     ActorGraph actorGraph;
 
     // If u flag, build unweighted graph
@@ -187,16 +143,54 @@ int main(int argc, char* argv[]) {
         actorGraph.loadFromFile(actorGraph, argv[1], true);
     }
 
+    bool weighted = *argv[ARG_TWO] == WEIGHTED;
+
+    // Names are only indexed when misspelled names are resolved
+    unique_ptr<NameIndex> nameIndex;
+    if (fuzzyEdits > 0) {
+        nameIndex = make_unique<NameIndex>(actorGraph);
+    }
+    auto findActor = [&](const string& name) {
+        return nameIndex ? nameIndex->resolve(name, fuzzyEdits)
+                         : actorGraph.get(actorGraph, name);
+    };
+
+    // Search state reused for every pair
+    PathFinder pathFinder(actorGraph);
+    KShortestPaths kShortestPaths(actorGraph);
+    vector<ActorPath> paths;
+
+    // Batches find one path per pair and time no single search, so they are
+    // only used without k paths or stats
+    bool batched = batch > 1 && k == 1 && statsFilename == nullptr;
+    BatchPathFinder batchPathFinder(actorGraph, batched ? batch : 1);
+    vector<PathQuery> queries;
+
     // Open input file
     ifstream inFile(argv[ARG_THREE]);
 
+    // Open stats file if asked for, starting with the CSV header
+    ofstream statsFile;
+    SearchStats stats;
+    string statsLine;
+    if (statsFilename != nullptr) {
+        statsFile.open(statsFilename);
+        if (!statsJson) {
+            appendStatsHeader(statsLine);
+            statsFile << statsLine;
+        }
+    }
+
+    // Stats are only gathered when they are written
+    SearchStats* statsPtr = statsFilename != nullptr ? &stats : nullptr;
+
     bool haveHeader = false;
 
     // Open output file
-    ofstream outFile(argv[ARG_FOUR]);
+    OutputWriter outFile(argv[ARG_FOUR]);
 
     // Print header to output file
-    outFile << HEADER << endl;
+    outFile.writeLine(HEADER);
 
     // Loop until end of input file
     while (inFile) {
@@ -234,36 +228,65 @@ int main(int argc, char* argv[]) {
         string endActor(actorPair[1]);
 
         // Get node in graph corresponding to start actor's name
-        ActorNode* startActorNode = actorGraph.get(actorGraph, startActor);
+        ActorNode* startActorNode = findActor(startActor);
+
+        if (batched) {
+            // Queue the pair, a start actor not in graph giving an empty line
+            queries.push_back(
+                PathQuery{startActorNode, findActor(endActor), ""});
+            if (queries.size() == BATCH_QUERIES) {
+                writeBatch(batchPathFinder, queries, weighted, window,
+                           outFile);
+            }
+        } else if (startActorNode == nullptr) {
+            // If start actor not in graph, print empty line
+            outFile.endLine();
+            stats.clear();
+        } else if (k > 1) {
+            // Find the k shortest paths, printed on one line
+            kShortestPaths.kShortestPaths(startActorNode, findActor(endActor),
+                                          k, weighted, window, paths,
+                                          statsPtr);
+            for (size_t i = 0; i < paths.size(); i++) {
+                if (i > 0) {
+                    outFile.buffer() += TAB_CHAR;
+                }
+                KShortestPaths::appendPath(outFile.buffer(), paths[i]);
+            }
+            outFile.endLine();
+        } else {
+            // Find the shortest path from the start node to the end node
+            ActorNode* endActorNode =
+                pathFinder.shortestPath(startActorNode, findActor(endActor),
+                                        weighted, window, statsPtr);
+
+            // Print path if end node is found, formatted straight into the
+            // output block
+            if (endActorNode != nullptr) {
+                pathFinder.appendPath(outFile.buffer(), endActorNode,
+                                      startActorNode);
+            }
 
-        // If start actor not in graph, print empty line
-        if (startActorNode == nullptr) {
-            outFile << endl;
-            continue;
+            // Path followed by a newline
+            outFile.endLine();
         }
 
-        // Find the shortest path from the start node to the end node
-        ActorNode* endActorNode =
-            shortestPath(actorGraph, startActor, endActor);
-
-        // Print path if end node is found
-        if (endActorNode != nullptr) {
-            printActor(outFile, endActorNode, startActorNode);
+        // Write the stats of the search, with zeros if there was none
+        if (statsPtr != nullptr) {
+            statsLine.clear();
+            appendStats(statsLine, PATH_KIND, startActor, endActor, stats,
+                        statsJson);
+            statsFile << statsLine;
         }
+    }
 
-        // Empty line
-        outFile << endl;
-
-        // FOr every node, reset all of its data fields
-        for (int i = 0; i < resetVect.size(); i++) {
-            ActorNode* node = resetVect[i];
-            node->dist = numeric_limits<double>::infinity();
-            node->prev = nullptr;
-            node->done = false;
-        }
+    // Search the pairs left in the last batch
+    if (!queries.empty()) {
+        writeBatch(batchPathFinder, queries, weighted, window, outFile);
     }
 
     // Close all files
     inFile.close();
-    outFile.close();
+    statsFile.close();
+    return outFile.close() ? 0 : 1;
 }
@@ -0,0 +1,138 @@
+/*
+ * separation.cpp
+ * Author: James Chong
+ * Date: 11/27/19
+ *
+ * Program that reports the degrees of separation of a graph: a histogram of
+ * the hops between sampled source actors and every other actor, along with
+ * the eccentricity and closeness of each source
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "ActorGraph.cpp"
+#include "ActorGraph.hpp"
+#include "OutputWriter.hpp"
+#include "Separation.hpp"
+
+#define ARG_TWO 2
+#define ARG_THREE 3
+#define SAMPLES_FLAG "--samples"
+#define SEED_FLAG "--seed"
+#define THREADS_FLAG "--threads"
+#define FROM_FLAG "--from"
+#define TO_FLAG "--to"
+#define USAGE \
+    "Usage: ./separation <movie_cast.tsv> <out.tsv> [--samples n] " \
+    "[--seed n] [--threads n] [--from year] [--to year]\n"
+#define HISTOGRAM_HEADER "hops\tpairs"
+#define SOURCE_HEADER "actor\teccentricity\tcloseness"
+#define SOURCES "#SOURCES: "
+#define UNREACHABLE_PAIRS "#UNREACHABLE PAIRS: "
+#define AVERAGE_SEPARATION "#AVERAGE SEPARATION: "
+#define DIAMETER_ESTIMATE "#DIAMETER ESTIMATE: "
+#define TAB_CHAR '\t'
+
+using namespace std;
+
+/**
+ * Appends a number with six decimals
+ *
+ * out: string to append to
+ * value: number to be appended
+ */
+static void appendDecimal(string& out, double value) {
+    char digits[32];
+    snprintf(digits, sizeof(digits), "%.6f", value);
+    out += digits;
+}
+
+/**
+ * Main function that parses command line args, builds the graph, and writes
+ * the report
+ *
+ * argc: number of command line args
+ * argv: array containing command line args
+ */
+int main(int argc, char* argv[]) {
+    if (argc < ARG_THREE) {
+        cerr << USAGE;
+        return 1;
+    }
+
+    // Every actor is a source unless a sample is asked for
+    int samples = 0;
+    uint64_t seed = 1;
+    int threads = max(1u, thread::hardware_concurrency());
+    YearWindow window;
+
+    // Parse the optional flags that follow the output file
+    for (int i = ARG_THREE; i < argc; i += ARG_TWO) {
+        if (i + 1 == argc) {
+            cerr << USAGE;
+            return 1;
+        }
+
+        if (strcmp(argv[i], SAMPLES_FLAG) == 0) {
+            samples = max(0, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], SEED_FLAG) == 0) {
+            seed = strtoull(argv[i + 1], nullptr, 10);
+        } else if (strcmp(argv[i], THREADS_FLAG) == 0) {
+            threads = max(1, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], FROM_FLAG) == 0) {
+            window.minYear = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], TO_FLAG) == 0) {
+            window.maxYear = atoi(argv[i + 1]);
+        } else {
+            cerr << USAGE;
+            return 1;
+        }
+    }
+
+    ActorGraph actorGraph;
+    if (!actorGraph.loadFromFile(actorGraph, argv[1], false)) {
+        return 1;
+    }
+
+    SeparationReport report;
+    separationStats(actorGraph, samples, seed, threads, window, report);
+
+    OutputWriter outFile(argv[ARG_TWO]);
+
+    // Number of pairs at each number of hops
+    outFile.writeLine(HISTOGRAM_HEADER);
+    for (size_t h = 0; h < report.histogram.size(); h++) {
+        string& line = outFile.buffer();
+        line += to_string(h);
+        line += TAB_CHAR;
+        line += to_string(report.histogram[h]);
+        outFile.endLine();
+    }
+
+    // Eccentricity and closeness of each source
+    outFile.writeLine(SOURCE_HEADER);
+    for (size_t s = 0; s < report.sources.size(); s++) {
+        string& line = outFile.buffer();
+        line += report.sources[s]->actorName;
+        line += TAB_CHAR;
+        line += to_string(report.eccentricity[s]);
+        line += TAB_CHAR;
+        appendDecimal(line, report.closeness[s]);
+        outFile.endLine();
+    }
+
+    // Totals over every source
+    outFile.writeLine(SOURCES + to_string(report.sources.size()));
+    outFile.writeLine(UNREACHABLE_PAIRS + to_string(report.unreachable));
+    outFile.buffer() += AVERAGE_SEPARATION;
+    appendDecimal(outFile.buffer(), report.averageSeparation());
+    outFile.endLine();
+    outFile.writeLine(DIAMETER_ESTIMATE +
+                      to_string(report.diameterEstimate()));
+
+    return outFile.close() ? 0 : 1;
+}
@@ -1,6 +1,20 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <set>
 #include "ActorGraph.cpp"
 #include "ActorGraph.hpp"
+#include "BatchPathFinder.hpp"
+#include "GraphGenerator.hpp"
+#include "GraphReport.hpp"
+#include "Intersection.hpp"
+#include "KShortestPaths.hpp"
+#include "MovieTraveler.hpp"
+#include "NameIndex.hpp"
+#include "OutputWriter.hpp"
+#include "PersonalizedPageRank.hpp"
+#include "QueryService.hpp"
+#include "SearchStats.hpp"
+#include "Separation.hpp"
 
 using namespace std;
 using namespace testing;
@@ -23,3 +37,1061 @@ TEST(ActorGraphTests, TEST_LOADGRAPH) {
                   actorGraph, "test/test_files/imdb_small_sample.tsv", false),
               true);
 }
+
+TEST(ActorGraphTests, TEST_LOADGRAPH_NODES) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+
+    // Every distinct actor becomes one node
+    ASSERT_EQ(actorGraph.getNodeCount(actorGraph), 14);
+
+    // Footloose (1984) and Footloose (2011) are different movies
+    ASSERT_EQ(actorGraph.getEdgeVect(actorGraph).size(), 12);
+
+    ActorNode* bacon = actorGraph.get(actorGraph, "Kevin Bacon");
+    ASSERT_NE(bacon, nullptr);
+    ASSERT_EQ(bacon->actorName, "Kevin Bacon");
+    ASSERT_EQ(bacon->movieVect.size(), 3);
+    ASSERT_EQ(bacon->movieVect[1]->movieName, "Apollo 13");
+    ASSERT_EQ(bacon->movieVect[1]->actorVect.size(), 4);
+
+    ActorNode* singer = actorGraph.get(actorGraph, "Lori Singer");
+    ASSERT_NE(singer->movieVect[0], singer->movieVect[1]);
+
+    ASSERT_EQ(actorGraph.get(actorGraph, "Kevin"), nullptr);
+}
+
+TEST(ActorGraphTests, TEST_LOOKUP_BY_VIEW) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+
+    // Look up an actor through a view into a larger buffer
+    string line = "Tom Hanks\tCast Away";
+    ActorNode* hanks = actorGraph.get(actorGraph, NameKey(line.data(), 9));
+    ASSERT_NE(hanks, nullptr);
+    ASSERT_EQ(hanks->actorName, "Tom Hanks");
+    ASSERT_EQ(actorGraph.get(actorGraph, NameKey(line.data(), 8)), nullptr);
+
+    // Movies are found by both title and year
+    MovieNode* remake =
+        actorGraph.getMovie(actorGraph, MovieKey(NameKey("Footloose", 9), 2011));
+    ASSERT_NE(remake, nullptr);
+    ASSERT_EQ(remake->year, 2011);
+    ASSERT_EQ(remake->actorVect.size(), 2);
+    ASSERT_EQ(
+        actorGraph.getMovie(actorGraph, MovieKey(NameKey("Footloose", 9), 1999)),
+        nullptr);
+}
+
+TEST(ActorGraphTests, TEST_GRAPH_VIEWS) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    const ActorGraph& view = actorGraph;
+
+    // Every actor and movie is found at its own index
+    ActorRange actors = view.getActors(view);
+    ASSERT_EQ(actors.size(), view.getNodeCount(view));
+    for (size_t i = 0; i < actors.size(); i++) {
+        ASSERT_EQ(actors[i]->index, i);
+    }
+    MovieRange movies = view.getMovies(view);
+    ASSERT_EQ(movies.size(), view.getMovieCount(view));
+    for (size_t i = 0; i < movies.size(); i++) {
+        ASSERT_EQ(movies[i]->index, i);
+    }
+
+    // Adjacency views point straight at the nodes' own vectors
+    ActorNode* hanks = view.get(view, NameKey("Tom Hanks", 9));
+    ASSERT_NE(hanks, nullptr);
+    ASSERT_EQ(moviesOf(hanks).begin(), hanks->movieVect.data());
+    ASSERT_EQ(moviesOf(hanks).size(), hanks->movieVect.size());
+    for (MovieNode* movie : moviesOf(hanks)) {
+        ActorRange cast = castOf(movie);
+        ASSERT_NE(find(cast.begin(), cast.end(), hanks), cast.end());
+    }
+}
+
+TEST(ActorGraphTests, TEST_APPEND_AND_SAVE) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", true));
+    ASSERT_TRUE(actorGraph.appendFromFile(actorGraph,
+                                          "test/test_files/imdb_delta.tsv"));
+
+    // Meryl Streep is new, and takes the next disjoint set index
+    ASSERT_EQ(actorGraph.getNodeCount(actorGraph), 15);
+    ActorNode* streep = actorGraph.get(actorGraph, "Meryl Streep");
+    ASSERT_NE(streep, nullptr);
+    ASSERT_EQ(actorGraph.getIndexMap(actorGraph).at(streep), 14);
+    ASSERT_EQ(actorGraph.getDSM(actorGraph).at(14).second, streep);
+
+    // New movies are edges, weighted like the movies loaded before them
+    ASSERT_EQ(actorGraph.getEdgeVect(actorGraph).size(), 15);
+    MovieNode* post = streep->movieVect[0];
+    ASSERT_EQ(post->edgeWeight, 3);
+    ASSERT_EQ(post->actorVect.size(), 2);
+
+    // Apollo 13 was already linked to Kevin Bacon, so that row is dropped
+    ASSERT_EQ(actorGraph.get(actorGraph, "Kevin Bacon")->movieVect.size(), 4);
+    ASSERT_EQ(actorGraph.getDuplicateCount(actorGraph), 1);
+
+    // A saved snapshot loads back into the same graph
+    string snapshot = TempDir() + "imdb_snapshot.tsv";
+    ASSERT_TRUE(actorGraph.saveToFile(actorGraph, snapshot.c_str()));
+
+    ActorGraph reloaded;
+    ASSERT_TRUE(reloaded.loadFromFile(reloaded, snapshot.c_str(), true));
+    ASSERT_EQ(reloaded.getNodeCount(reloaded), 15);
+    ASSERT_EQ(reloaded.getEdgeVect(reloaded).size(), 15);
+    ActorNode* reloadedStreep = reloaded.get(reloaded, "Meryl Streep");
+    ASSERT_EQ(reloaded.getIndexMap(reloaded).at(reloadedStreep), 14);
+    ASSERT_EQ(reloadedStreep->movieVect[1]->movieName, "Mamma Mia!");
+}
+
+TEST(ActorGraphTests, TEST_MALFORMED_YEARS) {
+    string filename = TempDir() + "malformed_years.tsv";
+    ofstream rows(filename);
+    rows << "Actor/Actress\tMovie\tYear\n";
+    rows << "Kevin Bacon\tApollo 13\t1995\n";
+    rows << "Tom Hanks\tApollo 13\t1995\r\n";
+    rows << "Tom Hanks\tBig\tunknown\n";
+    rows << "Tom Hanks\tSplash\t1984a\n";
+    rows << "Tom Hanks\tCast Away\t99999999999\n";
+    rows.close();
+
+    // Rows whose year is not a number are counted and dropped
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(actorGraph, filename.c_str(), true));
+    ASSERT_EQ(actorGraph.getMalformedCount(actorGraph), 3);
+    ASSERT_EQ(actorGraph.getEdgeVect(actorGraph).size(), 1);
+    ASSERT_EQ(actorGraph.get(actorGraph, "Tom Hanks")->movieVect.size(), 1);
+}
+
+TEST(ActorGraphTests, TEST_QUERY_SERVICE) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", true));
+    QueryService service(actorGraph);
+    QueryService::Worker worker(actorGraph);
+
+    string response;
+    service.handle("path\tu\tKevin Bacon\tTom Hanks", worker, response);
+    ASSERT_EQ(response,
+              "OK\t1\n(Kevin Bacon)--[Apollo 13#@1995]-->(Tom Hanks)\n");
+
+    // The worker's search state is reset between requests
+    response.clear();
+    service.handle("path\tu\tKevin Bacon\tTom Hanks", worker, response);
+    ASSERT_EQ(response,
+              "OK\t1\n(Kevin Bacon)--[Apollo 13#@1995]-->(Tom Hanks)\n");
+
+    // Unknown actors answer with an empty path
+    response.clear();
+    service.handle("path\tw\tKevin Bacon\tNobody", worker, response);
+    ASSERT_EQ(response, "OK\t1\n\n");
+
+    response.clear();
+    service.handle("mst", worker, response);
+    ASSERT_EQ(response.compare(0, 3, "OK\t"), 0);
+
+    response.clear();
+    service.handle("path\tx\tKevin Bacon", worker, response);
+    ASSERT_EQ(response.compare(0, 4, "ERR\t"), 0);
+
+    response.clear();
+    service.handle("bogus", worker, response);
+    ASSERT_EQ(response.compare(0, 4, "ERR\t"), 0);
+}
+
+TEST(ActorGraphTests, TEST_YEAR_WINDOW) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", true));
+
+    // Movies are kept sorted by year alongside their original order
+    ActorNode* singer = actorGraph.get(actorGraph, "Lori Singer");
+    ASSERT_EQ(singer->moviesByYear.size(), 2);
+    ASSERT_EQ(singer->moviesByYear[0]->year, 1984);
+    ASSERT_EQ(singer->moviesByYear[1]->year, 2011);
+
+    YearWindow window;
+    window.minYear = 1990;
+    window.maxYear = 2005;
+    ActorNode* bacon = actorGraph.get(actorGraph, "Kevin Bacon");
+    MovieRange range = moviesByYearInWindow(bacon, window);
+    ASSERT_EQ(range.size(), 2);
+    ASSERT_EQ((*range.begin())->movieName, "Apollo 13");
+
+    QueryService service(actorGraph);
+    QueryService::Worker worker(actorGraph);
+
+    // Footloose (2011) is outside the window, so there is no path
+    string response;
+    service.handle("path\tu\tKevin Bacon\tJulianne Hough\tto=2000", worker,
+                   response);
+    ASSERT_EQ(response, "OK\t1\n\n");
+
+    // Ages are measured from the reference year
+    ActorNode* hanks = actorGraph.get(actorGraph, "Tom Hanks");
+    window = YearWindow();
+    window.refYear = 2000;
+    ASSERT_EQ(worker.pathFinder.shortestPath(bacon, hanks, true, window),
+              hanks);
+    response.clear();
+    worker.pathFinder.appendPath(response, hanks, bacon);
+    ASSERT_EQ(response, "(Kevin Bacon)--[Apollo 13#@1995]-->(Tom Hanks)");
+
+    // Only collaborations inside the window are counted
+    response.clear();
+    service.handle("predict\tKevin Bacon\tfrom=2000", worker, response);
+    ASSERT_EQ(response, "OK\t2\nSean Penn\tTim Robbins\t\n\n");
+
+    response.clear();
+    service.handle("predict\tKevin Bacon\tsince=2000", worker, response);
+    ASSERT_EQ(response.compare(0, 4, "ERR\t"), 0);
+
+    // Rows that are not sorted by year, with two equally short paths
+    string filename = TempDir() + "unsorted_years.tsv";
+    ofstream rows(filename);
+    rows << "Actor/Actress\tMovie\tYear\n";
+    rows << "A\tNew\t2000\nB\tNew\t2000\nA\tOld\t1990\nB\tOld\t1990\n";
+    rows.close();
+
+    ActorGraph unsorted;
+    ASSERT_TRUE(unsorted.loadFromFile(unsorted, filename.c_str(), false));
+    ActorNode* first = unsorted.get(unsorted, "A");
+    ActorNode* last = unsorted.get(unsorted, "B");
+
+    // A window covering every movie yields them in the order they were
+    // loaded, so it finds the same path as no window
+    YearWindow covering;
+    covering.minYear = 1000;
+    covering.maxYear = 3000;
+    vector<MovieNode*> windowed;
+    for (MovieNode* movie : moviesInWindow(first, covering)) {
+        windowed.push_back(movie);
+    }
+    ASSERT_EQ(windowed, first->movieVect);
+
+    PathFinder pathFinder(unsorted);
+    for (const YearWindow& each : {YearWindow(), covering}) {
+        ASSERT_EQ(pathFinder.shortestPath(first, last, false, each), last);
+        string path;
+        pathFinder.appendPath(path, last, first);
+        ASSERT_EQ(path, "(A)--[New#@2000]-->(B)");
+    }
+
+    // On shuffled rows, a window finds the paths of a graph loaded with only
+    // the window's rows
+    GraphShape shape(300, 150);
+    string generated = TempDir() + "window_generated.tsv";
+    string shuffled = TempDir() + "window_shuffled.tsv";
+    string filtered = TempDir() + "window_filtered.tsv";
+    ASSERT_TRUE(generateGraph(shape, generated.c_str()));
+    ifstream generatedRows(generated);
+    string header;
+    getline(generatedRows, header);
+    vector<string> lines;
+    for (string line; getline(generatedRows, line);) {
+        lines.push_back(line);
+    }
+    mt19937 rng(23);
+    shuffle(lines.begin(), lines.end(), rng);
+
+    window = YearWindow();
+    window.minYear = 1970;
+    window.maxYear = 2005;
+    ofstream shuffledRows(shuffled);
+    ofstream filteredRows(filtered);
+    shuffledRows << header << '\n';
+    filteredRows << header << '\n';
+    for (const string& line : lines) {
+        shuffledRows << line << '\n';
+        int year = atoi(line.c_str() + line.rfind('\t') + 1);
+        if (year >= window.minYear && year <= window.maxYear) {
+            filteredRows << line << '\n';
+        }
+    }
+    shuffledRows.close();
+    filteredRows.close();
+
+    for (bool weighted : {false, true}) {
+        ActorGraph full;
+        ActorGraph part;
+        ASSERT_TRUE(full.loadFromFile(full, shuffled.c_str(), weighted));
+        ASSERT_TRUE(part.loadFromFile(part, filtered.c_str(), weighted));
+        ActorRange actors = full.getActors(full);
+        PathFinder fullFinder(full);
+        PathFinder partFinder(part);
+        for (int i = 0; i < 150; i++) {
+            ActorNode* start = actors[rng() % actors.size()];
+            ActorNode* end = actors[rng() % actors.size()];
+            string windowedPath;
+            if (fullFinder.shortestPath(start, end, weighted, window)) {
+                fullFinder.appendPath(windowedPath, end, start);
+            }
+
+            ActorNode* partStart = part.get(part, start->actorName);
+            ActorNode* partEnd = part.get(part, end->actorName);
+            string partPath;
+            if (partStart != nullptr && partEnd != nullptr &&
+                partFinder.shortestPath(partStart, partEnd, weighted)) {
+                partFinder.appendPath(partPath, partEnd, partStart);
+            }
+            ASSERT_EQ(windowedPath, partPath);
+        }
+    }
+}
+
+TEST(ActorGraphTests, TEST_K_SHORTEST_PATHS) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    ActorNode* bacon = actorGraph.get(actorGraph, "Kevin Bacon");
+    ActorNode* hanks = actorGraph.get(actorGraph, "Tom Hanks");
+
+    KShortestPaths kShortestPaths(actorGraph);
+    vector<ActorPath> paths;
+    kShortestPaths.kShortestPaths(bacon, hanks, 5, false, YearWindow(),
+                                  paths);
+    ASSERT_FALSE(paths.empty());
+    ASSERT_LE(paths.size(), 5);
+
+    // The first path is as short as the one PathFinder finds
+    string path;
+    KShortestPaths::appendPath(path, paths[0]);
+    ASSERT_EQ(path, "(Kevin Bacon)--[Apollo 13#@1995]-->(Tom Hanks)");
+
+    for (size_t i = 0; i < paths.size(); i++) {
+        // Paths are loopless, in order of cost, and all different
+        vector<ActorNode*> actors = paths[i].actors;
+        sort(actors.begin(), actors.end());
+        ASSERT_EQ(unique(actors.begin(), actors.end()), actors.end());
+        ASSERT_EQ(paths[i].cost, paths[i].movies.size());
+        ASSERT_EQ(paths[i].actors.front(), bacon);
+        ASSERT_EQ(paths[i].actors.back(), hanks);
+        if (i > 0) {
+            ASSERT_LE(paths[i - 1].cost, paths[i].cost);
+        }
+        for (size_t j = 0; j < i; j++) {
+            ASSERT_FALSE(paths[i].actors == paths[j].actors &&
+                         paths[i].movies == paths[j].movies);
+        }
+    }
+
+    // No path goes outside the window
+    YearWindow window;
+    window.maxYear = 2000;
+    ActorNode* hough = actorGraph.get(actorGraph, "Julianne Hough");
+    kShortestPaths.kShortestPaths(bacon, hough, 5, false, window, paths);
+    ASSERT_TRUE(paths.empty());
+}
+
+TEST(ActorGraphTests, TEST_K_SHORTEST_FIRST_PATH) {
+    GraphShape shape(300, 150);
+    string filename = TempDir() + "k_shortest_first.tsv";
+    ASSERT_TRUE(generateGraph(shape, filename.c_str()));
+
+    for (bool weighted : {false, true}) {
+        ActorGraph actorGraph;
+        ASSERT_TRUE(
+            actorGraph.loadFromFile(actorGraph, filename.c_str(), weighted));
+        ActorRange actors = actorGraph.getActors(actorGraph);
+
+        // Among paths of equal cost, the first path is the one PathFinder
+        // finds, so pathfinder prints the same path for every k
+        PathFinder pathFinder(actorGraph);
+        KShortestPaths kShortestPaths(actorGraph);
+        vector<ActorPath> paths;
+        mt19937 rng(17);
+        for (int i = 0; i < 300; i++) {
+            ActorNode* first = actors[rng() % actors.size()];
+            ActorNode* final = actors[rng() % actors.size()];
+            kShortestPaths.kShortestPaths(first, final, 2, weighted,
+                                          YearWindow(), paths);
+            ActorNode* found = pathFinder.shortestPath(first, final, weighted);
+
+            string expected;
+            if (found != nullptr) {
+                pathFinder.appendPath(expected, found, first);
+            }
+            string path;
+            if (!paths.empty()) {
+                KShortestPaths::appendPath(path, paths[0]);
+            }
+            ASSERT_EQ(path, expected);
+        }
+    }
+}
+
+TEST(ActorGraphTests, TEST_SEARCH_STATS) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    ActorNode* bacon = actorGraph.get(actorGraph, "Kevin Bacon");
+    ActorNode* hanks = actorGraph.get(actorGraph, "Tom Hanks");
+
+    // Every actor in the sample is reachable from Kevin Bacon
+    PathFinder pathFinder(actorGraph);
+    SearchStats stats;
+    ASSERT_EQ(pathFinder.shortestPath(bacon, hanks, false, YearWindow(),
+                                      &stats),
+              hanks);
+    ASSERT_EQ(stats.settled, 14);
+    ASSERT_EQ(stats.pushes, stats.touched);
+    ASSERT_EQ(stats.pushes - stats.stalePops, stats.settled);
+
+    // Stats are cleared by every query
+    LinkPredictor linkPredictor(actorGraph);
+    vector<ActorNode*> predictions;
+    linkPredictor.collaboratedActors(bacon, predictions, YearWindow(), &stats);
+    ASSERT_EQ(stats.settled, 6);
+    ASSERT_EQ(stats.stalePops, 0);
+
+    string line;
+    appendStatsHeader(line);
+    ASSERT_EQ(line,
+              "kind,source,target,settled,relaxed,pushes,stale_pops,touched,"
+              "micros\n");
+
+    // Names are quoted in CSV and escaped in JSON
+    stats.clear();
+    line.clear();
+    appendStats(line, "path", "Dwayne \"The Rock\" Johnson", "", stats, false);
+    ASSERT_EQ(line,
+              "path,\"Dwayne \"\"The Rock\"\" Johnson\",\"\",0,0,0,0,0,0\n");
+
+    line.clear();
+    appendStats(line, "path", "Dwayne \"The Rock\" Johnson", "", stats, true);
+    ASSERT_EQ(line,
+              "{\"kind\":\"path\",\"source\":\"Dwayne \\\"The Rock\\\" "
+              "Johnson\",\"target\":\"\",\"settled\":0,\"relaxed\":0,"
+              "\"pushes\":0,\"stale_pops\":0,\"touched\":0,\"micros\":0}\n");
+}
+
+TEST(ActorGraphTests, TEST_GENERATE_GRAPH) {
+    GraphShape shape(200, 100);
+    string first = TempDir() + "generated_one.tsv";
+    string second = TempDir() + "generated_two.tsv";
+    ASSERT_TRUE(generateGraph(shape, first.c_str()));
+    ASSERT_TRUE(generateGraph(shape, second.c_str()));
+
+    // The same seed always gives the same file
+    ifstream firstFile(first);
+    ifstream secondFile(second);
+    stringstream firstRows;
+    stringstream secondRows;
+    firstRows << firstFile.rdbuf();
+    secondRows << secondFile.rdbuf();
+    ASSERT_EQ(firstRows.str(), secondRows.str());
+
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(actorGraph, first.c_str(), true));
+    ASSERT_GT(actorGraph.getNodeCount(actorGraph), 0);
+    ASSERT_LE(actorGraph.getNodeCount(actorGraph), shape.actors);
+    ASSERT_LE(actorGraph.getMovieCount(actorGraph), shape.movies);
+
+    // Roles follow a power law, so the most popular actor is cast often
+    ActorNode* popular = actorGraph.get(actorGraph, generatedActorName(0));
+    ASSERT_NE(popular, nullptr);
+    ASSERT_GT(popular->movieVect.size(), shape.movies / 20);
+}
+
+TEST(ActorGraphTests, TEST_OUTPUT_WRITER) {
+    // A tiny block size hands off a block every few lines
+    string filename = TempDir() + "output_writer.tsv";
+    string expected;
+    {
+        OutputWriter outFile(filename.c_str(), 64);
+        outFile.writeLine("header");
+        expected += "header\n";
+        for (int i = 0; i < 10000; i++) {
+            outFile.buffer() += to_string(i);
+            outFile.endLine();
+            expected += to_string(i) + "\n";
+        }
+        outFile.buffer() += "last";
+        expected += "last";
+        ASSERT_TRUE(outFile.close());
+        ASSERT_TRUE(outFile.close());
+    }
+
+    // Blocks are written whole and in order
+    ifstream infile(filename);
+    stringstream written;
+    written << infile.rdbuf();
+    ASSERT_EQ(written.str(), expected);
+
+    OutputWriter missing("/nonexistent/output_writer.tsv");
+    missing.writeLine("lost");
+    ASSERT_FALSE(missing.close());
+}
+
+TEST(ActorGraphTests, TEST_SEPARATION) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    long actors = actorGraph.getNodeCount(actorGraph);
+
+    // Every pair of the sample is counted once per source
+    SeparationReport report;
+    separationStats(actorGraph, 0, 1, 1, YearWindow(), report);
+    ASSERT_EQ(report.sources.size(), actors);
+    ASSERT_EQ(report.histogram[0], actors);
+    long pairs = report.unreachable;
+    for (long count : report.histogram) {
+        pairs += count;
+    }
+    ASSERT_EQ(pairs, actors * actors);
+
+    // The whole sample is connected
+    ASSERT_EQ(report.unreachable, 0);
+    ASSERT_GT(report.averageSeparation(), 1);
+    ASSERT_EQ(report.diameterEstimate(),
+              *max_element(report.eccentricity.begin(),
+                           report.eccentricity.end()));
+
+    // Threads only change the order the sources are searched in
+    SeparationReport parallel;
+    separationStats(actorGraph, 0, 1, 4, YearWindow(), parallel);
+    ASSERT_EQ(parallel.histogram, report.histogram);
+    ASSERT_EQ(parallel.eccentricity, report.eccentricity);
+    ASSERT_EQ(parallel.closeness, report.closeness);
+
+    // A sample draws distinct sources
+    separationStats(actorGraph, 5, 7, 2, YearWindow(), report);
+    ASSERT_EQ(report.sources.size(), 5);
+    sort(report.sources.begin(), report.sources.end());
+    ASSERT_EQ(unique(report.sources.begin(), report.sources.end()),
+              report.sources.end());
+    ASSERT_EQ(report.histogram[0], 5);
+}
+
+TEST(ActorGraphTests, TEST_HEAVY_MOVIES) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    ASSERT_EQ(actorGraph.getHeavyCount(actorGraph), 0);
+
+    // Every cast above the threshold is heavy
+    actorGraph.setHeavyCast(actorGraph, 2);
+    int heavy = 0;
+    for (MovieNode* movie : actorGraph.getMovies(actorGraph)) {
+        ASSERT_EQ(movie->heavy, movie->actorVect.size() > 2);
+        heavy += movie->heavy;
+    }
+    ASSERT_GT(heavy, 0);
+    ASSERT_EQ(actorGraph.getHeavyCount(actorGraph), heavy);
+
+    // Skipping heavy casts never predicts a co-star as uncollaborated
+    ActorNode* bacon = actorGraph.get(actorGraph, "Kevin Bacon");
+    LinkPredictor linkPredictor(actorGraph);
+    linkPredictor.skipHeavyMovies(true);
+    vector<ActorNode*> predictions;
+    linkPredictor.uncollaboratedActors(bacon, predictions);
+    for (ActorNode* prediction : predictions) {
+        for (MovieNode* movie : moviesOf(bacon)) {
+            ActorRange cast = castOf(movie);
+            ASSERT_EQ(find(cast.begin(), cast.end(), prediction), cast.end());
+        }
+    }
+
+    // Turned off, predictions are exact again
+    vector<ActorNode*> exact;
+    linkPredictor.skipHeavyMovies(false);
+    linkPredictor.uncollaboratedActors(bacon, exact);
+    LinkPredictor fresh(actorGraph);
+    predictions.clear();
+    fresh.uncollaboratedActors(bacon, predictions);
+    ASSERT_EQ(exact, predictions);
+}
+
+TEST(ActorGraphTests, TEST_SORTED_ADJACENCY) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    ASSERT_EQ(actorGraph.getDuplicateCount(actorGraph), 0);
+    ASSERT_TRUE(actorGraph.appendFromFile(actorGraph,
+                                          "test/test_files/imdb_delta.tsv"));
+
+    // Every run holds the same nodes as the vector, once each and sorted
+    for (ActorNode* actor : actorGraph.getActors(actorGraph)) {
+        IdRange ids = actorGraph.getMovieIds(actorGraph, actor);
+        ASSERT_EQ(ids.size(), actor->movieVect.size());
+        ASSERT_TRUE(is_sorted(ids.begin(), ids.end()));
+        ASSERT_EQ(adjacent_find(ids.begin(), ids.end()), ids.end());
+        for (MovieNode* movie : actor->movieVect) {
+            ASSERT_TRUE(binary_search(ids.begin(), ids.end(), movie->index));
+        }
+    }
+    for (MovieNode* movie : actorGraph.getMovies(actorGraph)) {
+        IdRange ids = actorGraph.getCastIds(actorGraph, movie);
+        ASSERT_EQ(ids.size(), movie->actorVect.size());
+        ASSERT_TRUE(is_sorted(ids.begin(), ids.end()));
+        ASSERT_EQ(adjacent_find(ids.begin(), ids.end()), ids.end());
+        for (ActorNode* actor : movie->actorVect) {
+            ASSERT_TRUE(binary_search(ids.begin(), ids.end(), actor->index));
+        }
+    }
+
+    // The same link twice is loaded once
+    ActorNode* bacon = actorGraph.get(actorGraph, "Kevin Bacon");
+    MovieNode* apollo = actorGraph.getMovie(
+        actorGraph, MovieKey(NameKey("Apollo 13", 9), 1995));
+    ASSERT_EQ(count(bacon->movieVect.begin(), bacon->movieVect.end(), apollo),
+              1);
+    ASSERT_EQ(count(apollo->actorVect.begin(), apollo->actorVect.end(), bacon),
+              1);
+    ASSERT_EQ(bacon->moviesByYear.size(), bacon->movieVect.size());
+}
+
+TEST(ActorGraphTests, TEST_APPENDED_ADJACENCY) {
+    GraphShape shape(300, 150);
+    string filename = TempDir() + "appended_adjacency.tsv";
+    ASSERT_TRUE(generateGraph(shape, filename.c_str()));
+
+    // Deal the rows into deltas, so that each cast is spread over several
+    // deltas and later ones link actors and movies that earlier ones added
+    const int DELTAS = 12;
+    ifstream rows(filename);
+    string header;
+    getline(rows, header);
+    vector<ofstream> deltas;
+    for (int i = 0; i < DELTAS; i++) {
+        deltas.emplace_back(TempDir() + "appended_delta" + to_string(i) +
+                            ".tsv");
+        deltas[i] << header << '\n';
+    }
+    string line;
+    for (int row = 0; getline(rows, line); row++) {
+        deltas[row % DELTAS] << line << '\n';
+    }
+    for (ofstream& delta : deltas) {
+        delta.close();
+    }
+
+    // The appended runs match those of a graph loaded from the same rows
+    ActorGraph actorGraph;
+    ofstream sofar(TempDir() + "appended_sofar.tsv");
+    sofar << header << '\n';
+    for (int i = 0; i < DELTAS; i++) {
+        string delta = TempDir() + "appended_delta" + to_string(i) + ".tsv";
+        ASSERT_TRUE(actorGraph.appendFromFile(actorGraph, delta.c_str()));
+        ifstream deltaRows(delta);
+        getline(deltaRows, line);
+        while (getline(deltaRows, line)) {
+            sofar << line << '\n';
+        }
+        sofar.flush();
+
+        ActorGraph loaded;
+        string all = TempDir() + "appended_sofar.tsv";
+        ASSERT_TRUE(loaded.loadFromFile(loaded, all.c_str(), false));
+        ActorRange actors = actorGraph.getActors(actorGraph);
+        MovieRange movies = actorGraph.getMovies(actorGraph);
+        ASSERT_EQ(actors.size(), loaded.getActors(loaded).size());
+        ASSERT_EQ(movies.size(), loaded.getMovies(loaded).size());
+        for (size_t j = 0; j < actors.size(); j++) {
+            IdRange ids = actorGraph.getMovieIds(actorGraph, actors[j]);
+            IdRange expected =
+                loaded.getMovieIds(loaded, loaded.getActors(loaded)[j]);
+            ASSERT_TRUE(equal(ids.begin(), ids.end(), expected.begin(),
+                              expected.end()));
+        }
+        for (size_t j = 0; j < movies.size(); j++) {
+            IdRange ids = actorGraph.getCastIds(actorGraph, movies[j]);
+            IdRange expected =
+                loaded.getCastIds(loaded, loaded.getMovies(loaded)[j]);
+            ASSERT_TRUE(equal(ids.begin(), ids.end(), expected.begin(),
+                              expected.end()));
+        }
+    }
+}
+
+TEST(ActorGraphTests, TEST_INTERSECTION) {
+    mt19937 rng(7);
+
+    // Runs of similar and very different sizes take the merge and gallop paths
+    vector<pair<int, int>> sizes = {{0, 5},   {1, 1},    {3, 9},    {17, 23},
+                                    {64, 64}, {5, 1000}, {2, 4000}, {100, 150}};
+    for (pair<int, int> size : sizes) {
+        for (int trial = 0; trial < 20; trial++) {
+            set<uint32_t> lhsSet;
+            set<uint32_t> rhsSet;
+            uint32_t range = 2 * (size.first + size.second) + 1;
+            while ((int)lhsSet.size() < size.first) {
+                lhsSet.insert(rng() % range);
+            }
+            while ((int)rhsSet.size() < size.second) {
+                rhsSet.insert(rng() % range);
+            }
+            vector<uint32_t> lhs(lhsSet.begin(), lhsSet.end());
+            vector<uint32_t> rhs(rhsSet.begin(), rhsSet.end());
+
+            vector<uint32_t> shared;
+            set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                             back_inserter(shared));
+            IdRange lhsIds{lhs.data(), lhs.data() + lhs.size()};
+            IdRange rhsIds{rhs.data(), rhs.data() + rhs.size()};
+            ASSERT_EQ(intersectCount(lhsIds, rhsIds), shared.size());
+            ASSERT_EQ(intersectCount(rhsIds, lhsIds), shared.size());
+        }
+    }
+
+    // Actors share the movies they have in common
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    for (ActorNode* lhs : actorGraph.getActors(actorGraph)) {
+        for (ActorNode* rhs : actorGraph.getActors(actorGraph)) {
+            size_t shared = 0;
+            for (MovieNode* movie : moviesOf(lhs)) {
+                ActorRange cast = castOf(movie);
+                shared += find(cast.begin(), cast.end(), rhs) != cast.end();
+            }
+            ASSERT_EQ(sharedMovieCount(actorGraph, lhs, rhs), shared);
+        }
+    }
+}
+
+TEST(ActorGraphTests, TEST_HUGE_PAGES) {
+    ActorGraph actorGraph;
+    ActorGraph hugeGraph;
+    ASSERT_TRUE(hugeGraph.setHugePages(hugeGraph, true));
+    ASSERT_TRUE(hugeGraph.usesHugePages(hugeGraph));
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    ASSERT_TRUE(hugeGraph.loadFromFile(
+        hugeGraph, "test/test_files/imdb_small_sample.tsv", false));
+
+    // Only an empty graph can change
+    ASSERT_FALSE(hugeGraph.setHugePages(hugeGraph, false));
+
+    // The graph in huge pages holds the same nodes and runs
+    ASSERT_EQ(hugeGraph.getNodeCount(hugeGraph),
+              actorGraph.getNodeCount(actorGraph));
+    ASSERT_EQ(hugeGraph.getMovieCount(hugeGraph),
+              actorGraph.getMovieCount(actorGraph));
+    ActorRange actors = actorGraph.getActors(actorGraph);
+    ActorRange hugeActors = hugeGraph.getActors(hugeGraph);
+    for (size_t i = 0; i < actors.size(); i++) {
+        ASSERT_EQ(hugeActors[i]->actorName, actors[i]->actorName);
+        IdRange ids = actorGraph.getMovieIds(actorGraph, actors[i]);
+        IdRange hugeIds = hugeGraph.getMovieIds(hugeGraph, hugeActors[i]);
+        ASSERT_TRUE(equal(ids.begin(), ids.end(), hugeIds.begin(),
+                          hugeIds.end()));
+    }
+
+    // Runs too large for a single huge page allocate and free their pages
+    IdVector ids{HugePageAllocator<uint32_t>(true)};
+    ids.resize(HUGE_PAGE_BYTES, 7);
+    ASSERT_EQ(ids[HUGE_PAGE_BYTES - 1], 7);
+    ids.clear();
+    ids.shrink_to_fit();
+
+    // An emptied graph can leave huge pages and load again
+    hugeGraph.deleteGraph();
+    ASSERT_TRUE(hugeGraph.setHugePages(hugeGraph, false));
+    ASSERT_FALSE(hugeGraph.usesHugePages(hugeGraph));
+    ASSERT_TRUE(hugeGraph.loadFromFile(
+        hugeGraph, "test/test_files/imdb_small_sample.tsv", false));
+    ASSERT_EQ(hugeGraph.getNodeCount(hugeGraph),
+              actorGraph.getNodeCount(actorGraph));
+}
+
+TEST(ActorGraphTests, TEST_BATCH_PATHS) {
+    GraphShape shape(400, 200);
+    string filename = TempDir() + "batch_paths.tsv";
+    ASSERT_TRUE(generateGraph(shape, filename.c_str()));
+
+    for (bool weighted : {false, true}) {
+        ActorGraph actorGraph;
+        ASSERT_TRUE(
+            actorGraph.loadFromFile(actorGraph, filename.c_str(), weighted));
+        ActorRange actors = actorGraph.getActors(actorGraph);
+
+        // Pairs include a missing first actor and a missing final actor
+        mt19937 rng(11);
+        vector<PathQuery> queries;
+        queries.push_back(PathQuery{nullptr, actors[0], ""});
+        queries.push_back(PathQuery{actors[0], nullptr, ""});
+        for (int i = 0; i < 50; i++) {
+            queries.push_back(PathQuery{actors[rng() % actors.size()],
+                                        actors[rng() % actors.size()], ""});
+        }
+
+        // Every width finds the paths that one search at a time finds
+        PathFinder pathFinder(actorGraph);
+        for (int width : {1, 3, 8}) {
+            YearWindow window;
+            window.minYear = 1980;
+            BatchPathFinder batchPathFinder(actorGraph, width);
+            batchPathFinder.shortestPaths(queries, weighted, window);
+            for (PathQuery& query : queries) {
+                string path;
+                if (query.firstActor != nullptr) {
+                    ActorNode* found = pathFinder.shortestPath(
+                        query.firstActor, query.finalActor, weighted, window);
+                    if (found != nullptr) {
+                        pathFinder.appendPath(path, found, query.firstActor);
+                    }
+                }
+                ASSERT_EQ(query.path, path);
+            }
+        }
+    }
+}
+
+TEST(ActorGraphTests, TEST_INCREMENTAL_TREE) {
+    GraphShape shape(300, 150);
+    string filename = TempDir() + "incremental_tree.tsv";
+    string baseFilename = TempDir() + "incremental_base.tsv";
+    string deltaFilename = TempDir() + "incremental_delta.tsv";
+    string stateFilename = TempDir() + "incremental_state.tsv";
+    ASSERT_TRUE(generateGraph(shape, filename.c_str()));
+
+    // Split the rows into a base and a delta, both with the header
+    ifstream rows(filename);
+    ofstream base(baseFilename);
+    ofstream delta(deltaFilename);
+    string line;
+    getline(rows, line);
+    base << line << '\n';
+    delta << line << '\n';
+    for (int row = 0; getline(rows, line); row++) {
+        (row % 4 == 3 ? delta : base) << line << '\n';
+    }
+    base.close();
+    delta.close();
+
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(actorGraph, baseFilename.c_str(), true));
+    SpanningTree tree;
+    movieTraveler(actorGraph, tree);
+    SpanningForest forest(actorGraph);
+    forest.build(tree);
+    ASSERT_TRUE(forest.save(stateFilename.c_str()));
+
+    // A saved forest reads back the same
+    SpanningForest saved(actorGraph);
+    ASSERT_TRUE(saved.load(stateFilename.c_str()));
+    ASSERT_EQ(saved.getEdgeCount(), tree.edges.size());
+    ASSERT_EQ(saved.getTotalEdgeWeights(), tree.totalEdgeWeights);
+
+    // The updated forest is as light as a tree of the whole graph
+    ASSERT_TRUE(actorGraph.appendFromFile(actorGraph, deltaFilename.c_str()));
+    vector<TreeChange> changes;
+    saved.addLinks(actorGraph.getAppendedLinks(actorGraph), changes);
+    ASSERT_FALSE(changes.empty());
+
+    ActorGraph fullGraph;
+    ASSERT_TRUE(fullGraph.loadFromFile(fullGraph, filename.c_str(), true));
+    SpanningTree fullTree;
+    movieTraveler(fullGraph, fullTree);
+    ASSERT_EQ(saved.getEdgeCount(), fullTree.edges.size());
+    ASSERT_EQ(saved.getTotalEdgeWeights(), fullTree.totalEdgeWeights);
+
+    // Every change is counted in the totals
+    int weights = tree.totalEdgeWeights;
+    int edges = tree.edges.size();
+    for (const TreeChange& change : changes) {
+        weights += (change.added ? 1 : -1) * change.edge.movie->edgeWeight;
+        edges += change.added ? 1 : -1;
+    }
+    ASSERT_EQ(weights, saved.getTotalEdgeWeights());
+    ASSERT_EQ(edges, saved.getEdgeCount());
+}
+
+TEST(ActorGraphTests, TEST_PPR) {
+    GraphShape shape(400, 200);
+    string filename = TempDir() + "ppr.tsv";
+    ASSERT_TRUE(generateGraph(shape, filename.c_str()));
+
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(actorGraph, filename.c_str(), false));
+    ActorRange actors = actorGraph.getActors(actorGraph);
+
+    PersonalizedPageRank pageRank(actorGraph, 5000);
+    PersonalizedPageRank threaded(actorGraph, 5000, 3);
+    for (int i = 0; i < 20; i++) {
+        ActorNode* query = actors[i * 7];
+        vector<ActorNode*> collaborated;
+        vector<ActorNode*> uncollaborated;
+        pageRank.predict(query, collaborated, uncollaborated);
+        ASSERT_LE(collaborated.size(), MAX_CANDIDATES);
+        ASSERT_LE(uncollaborated.size(), MAX_CANDIDATES);
+
+        // Actors are split by whether they share a movie with the query
+        set<ActorNode*> costars;
+        for (MovieNode* movie : moviesOf(query)) {
+            for (ActorNode* costar : castOf(movie)) {
+                costars.insert(costar);
+            }
+        }
+        for (ActorNode* node : collaborated) {
+            ASSERT_NE(node, query);
+            ASSERT_EQ(costars.count(node), 1u);
+        }
+        for (ActorNode* node : uncollaborated) {
+            ASSERT_EQ(costars.count(node), 0u);
+        }
+        if (costars.size() > MAX_CANDIDATES) {
+            ASSERT_EQ(collaborated.size(), MAX_CANDIDATES);
+        }
+
+        // The same seed gives the same predictions on any number of threads
+        vector<ActorNode*> threadedCollaborated;
+        vector<ActorNode*> threadedUncollaborated;
+        threaded.predict(query, threadedCollaborated, threadedUncollaborated);
+        ASSERT_EQ(collaborated, threadedCollaborated);
+        ASSERT_EQ(uncollaborated, threadedUncollaborated);
+    }
+}
+
+TEST(ActorGraphTests, TEST_NAME_INDEX) {
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(
+        actorGraph, "test/test_files/imdb_small_sample.tsv", false));
+    NameIndex nameIndex(actorGraph);
+    ActorNode* bacon = actorGraph.get(actorGraph, "Kevin Bacon");
+
+    // Exact names resolve as get does, others within the edits allowed
+    ASSERT_EQ(nameIndex.resolve("Kevin Bacon"), bacon);
+    ASSERT_EQ(nameIndex.resolve("kevin bacon"), bacon);
+    ASSERT_EQ(nameIndex.resolve("Kvn Bacon"), bacon);
+    ASSERT_EQ(nameIndex.resolve("Kvn Bacon", 1), nullptr);
+    ASSERT_EQ(nameIndex.resolve("Kevn Bacon", 0), nullptr);
+    ASSERT_EQ(nameIndex.resolve("Nobody At All"), nullptr);
+
+    // The index finds every name a scan of all of them finds
+    GraphShape shape(2000, 500);
+    string filename = TempDir() + "name_index.tsv";
+    ASSERT_TRUE(generateGraph(shape, filename.c_str()));
+    ActorGraph generated;
+    ASSERT_TRUE(generated.loadFromFile(generated, filename.c_str(), false));
+    NameIndex generatedIndex(generated);
+    ActorRange actors = generated.getActors(generated);
+
+    mt19937 rng(5);
+    for (int i = 0; i < 200; i++) {
+        // Misspell a name with up to three random edits
+        string name = actors[rng() % actors.size()]->actorName;
+        for (int edit = rng() % 4; edit > 0; edit--) {
+            size_t at = rng() % (name.size() + 1);
+            char c = '0' + rng() % 10;
+            if (rng() % 2 == 0 && at < name.size()) {
+                name.erase(at, 1);
+            } else {
+                name.insert(at, 1, c);
+            }
+        }
+
+        for (int maxEdits : {1, 2}) {
+            vector<NameMatch> matches;
+            generatedIndex.findNames(name, matches, maxEdits, actors.size());
+            size_t expected = 0;
+            for (ActorNode* node : actors) {
+                int distance = 0;
+                vector<int> row(node->actorName.size() + 1);
+                for (size_t j = 0; j < row.size(); j++) {
+                    row[j] = j;
+                }
+                for (size_t a = 1; a <= name.size(); a++) {
+                    int diagonal = row[0];
+                    row[0] = a;
+                    for (size_t b = 1; b < row.size(); b++) {
+                        int up = row[b];
+                        row[b] = min(min(row[b], row[b - 1]) + 1,
+                                     diagonal + (name[a - 1] !=
+                                                 node->actorName[b - 1]));
+                        diagonal = up;
+                    }
+                }
+                distance = row.back();
+                expected += distance <= maxEdits;
+            }
+            ASSERT_EQ(matches.size(), expected);
+            for (size_t m = 1; m < matches.size(); m++) {
+                ASSERT_LE(matches[m - 1].distance, matches[m].distance);
+            }
+        }
+    }
+}
+
+TEST(ActorGraphTests, TEST_GRAPH_REPORT) {
+    GraphShape shape(500, 150);
+    string filename = TempDir() + "graph_report.tsv";
+    ASSERT_TRUE(generateGraph(shape, filename.c_str()));
+    ActorGraph actorGraph;
+    ASSERT_TRUE(actorGraph.loadFromFile(actorGraph, filename.c_str(), false));
+
+    GraphReport report;
+    graphReport(actorGraph, 3, report);
+    ASSERT_EQ(report.actors, actorGraph.getNodeCount(actorGraph));
+    ASSERT_EQ(report.movies, actorGraph.getMovieCount(actorGraph));
+
+    // Every node is in one degree bucket and every link is counted
+    long links = 0;
+    for (ActorNode* node : actorGraph.getActors(actorGraph)) {
+        links += node->movieVect.size();
+    }
+    ASSERT_EQ(report.links, links);
+    long actors = 0;
+    for (long count : report.actorDegrees) {
+        actors += count;
+    }
+    ASSERT_EQ(actors, report.actors);
+
+    // The largest casts come first
+    ASSERT_EQ(report.largestCasts.size(), 3u);
+    for (MovieNode* movie : actorGraph.getMovies(actorGraph)) {
+        ASSERT_LE(movie->actorVect.size(),
+                  report.largestCasts[0]->actorVect.size());
+    }
+    ASSERT_EQ(report.maxMovieDegree,
+              (long)report.largestCasts[0]->actorVect.size());
+
+    // Components match those found by searching from every actor
+    vector<int> component(report.actors, -1);
+    vector<long> sizes;
+    for (ActorNode* start : actorGraph.getActors(actorGraph)) {
+        if (component[start->index] != -1) {
+            continue;
+        }
+        vector<ActorNode*> stack{start};
+        component[start->index] = sizes.size();
+        sizes.push_back(0);
+        while (!stack.empty()) {
+            ActorNode* node = stack.back();
+            stack.pop_back();
+            sizes.back()++;
+            for (MovieNode* movie : moviesOf(node)) {
+                for (ActorNode* costar : castOf(movie)) {
+                    if (component[costar->index] == -1) {
+                        component[costar->index] = component[start->index];
+                        stack.push_back(costar);
+                    }
+                }
+            }
+        }
+    }
+    sort(sizes.begin(), sizes.end(), greater<long>());
+    ASSERT_EQ(report.components, (long)sizes.size());
+    sizes.resize(min(sizes.size(), (size_t)3));
+    ASSERT_EQ(report.largestComponents, sizes);
+
+    // Every structure the graph holds is counted, and the maps built on
+    // demand are not
+    size_t held = 0;
+    bool dsmListed = false;
+    for (const StructureBytes& structure : report.structures) {
+        held += structure.onDemand ? 0 : structure.bytes;
+        dsmListed |= structure.name == "disjointSetMap" && structure.onDemand;
+    }
+    ASSERT_TRUE(dsmListed);
+    ASSERT_EQ(report.heldBytes(), held);
+    ASSERT_GT(held, (size_t)links * sizeof(uint32_t));
+}
@@ -0,0 +1,139 @@
+/**
+ * Creates a vector of bits that counts the ones before any position in
+ * constant time
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+#include "BitVector.hpp"
+
+/* Initializes an empty vector of bits */
+BitVector::BitVector() {
+    bits = nullptr;
+    ranks = nullptr;
+    numBits = 0;
+}
+
+/* Empties the vector */
+void BitVector::clear() {
+    words.clear();
+    blockRanks.clear();
+    bits = nullptr;
+    ranks = nullptr;
+    numBits = 0;
+}
+
+/* Returns the number of counts kept for a number of bits
+   numBits: number of bits
+*/
+size_t BitVector::numRanks(size_t numBits) {
+    size_t numWords = (numBits + 63) / 64;
+    return (numWords + RANK_BLOCK_WORDS - 1) / RANK_BLOCK_WORDS + 1;
+}
+
+/* Appends a bit
+   bit: bit to be appended
+*/
+void BitVector::push_back(bool bit) {
+    // Start a new word every 64 bits
+    if (numBits % 64 == 0) {
+        words.push_back(0);
+    }
+    if (bit) {
+        words.back() |= uint64_t(1) << (numBits % 64);
+    }
+    numBits++;
+}
+
+/* Counts the ones of every block, to be called once every bit is appended
+   and before rank is */
+void BitVector::buildRanks() {
+    blockRanks.clear();
+    uint32_t ones = 0;
+    for (size_t w = 0; w < words.size(); w++) {
+        if (w % RANK_BLOCK_WORDS == 0) {
+            blockRanks.push_back(ones);
+        }
+        ones += __builtin_popcountll(words[w]);
+    }
+
+    // The total is the count before the block past the last
+    blockRanks.push_back(ones);
+
+    bits = words.data();
+    ranks = blockRanks.data();
+}
+
+/* Writes the number of bits, the bits, and the counts, padded to whole words
+   out: stream written to
+*/
+void BitVector::save(ostream& out) const {
+    uint64_t header = numBits;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(bits),
+              (numBits + 63) / 64 * sizeof(uint64_t));
+
+    // Counts take half words, so an odd number of them is padded
+    size_t rankCount = numRanks(numBits);
+    out.write(reinterpret_cast<const char*>(ranks),
+              rankCount * sizeof(uint32_t));
+    if (rankCount % 2 != 0) {
+        uint32_t padding = 0;
+        out.write(reinterpret_cast<const char*>(&padding), sizeof(padding));
+    }
+}
+
+/* Reads the bits and counts saved in an image in place, advancing past them.
+   Returns false if the image ends before them
+   cursor: first word of the saved bits, moved past them
+   end: end of the image
+*/
+bool BitVector::attach(const uint64_t*& cursor, const uint64_t* end) {
+    if (end - cursor < 1) {
+        return false;
+    }
+    size_t savedBits = *cursor;
+    if (savedBits > size_t(end - cursor) * 64) {
+        return false;
+    }
+    size_t numWords = (savedBits + 63) / 64;
+    size_t rankWords = (numRanks(savedBits) + 1) / 2;
+    if (size_t(end - cursor - 1) < numWords + rankWords) {
+        return false;
+    }
+
+    vector<uint64_t>().swap(words);
+    vector<uint32_t>().swap(blockRanks);
+    numBits = savedBits;
+    bits = cursor + 1;
+    ranks = reinterpret_cast<const uint32_t*>(bits + numWords);
+    cursor = bits + numWords + rankWords;
+    return true;
+}
+
+/* Returns the number of ones before a position
+   pos: position, at most the number of bits
+*/
+size_t BitVector::rank(size_t pos) const {
+    size_t word = pos / 64;
+    size_t block = word / RANK_BLOCK_WORDS;
+    size_t ones = ranks[block];
+
+    // Whole words of the block before the position
+    for (size_t w = block * RANK_BLOCK_WORDS; w < word; w++) {
+        ones += __builtin_popcountll(bits[w]);
+    }
+
+    // Bits of the position's word below it
+    if (pos % 64 != 0) {
+        uint64_t below = (uint64_t(1) << (pos % 64)) - 1;
+        ones += __builtin_popcountll(bits[word] & below);
+    }
+    return ones;
+}
+
+/* Returns the bytes held by the bits and counts */
+size_t BitVector::bytes() const {
+    return (numBits + 63) / 64 * sizeof(uint64_t) +
+           numRanks(numBits) * sizeof(uint32_t);
+}
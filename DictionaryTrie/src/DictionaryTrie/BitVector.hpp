@@ -0,0 +1,103 @@
+/**
+ * File that defines a vector of bits that counts the ones before any
+ * position in constant time
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+#ifndef BIT_VECTOR_HPP
+#define BIT_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+// Number of 64-bit words between two stored counts of ones
+#define RANK_BLOCK_WORDS 8
+
+/**
+ * The class for a vector of bits that is appended to and then read, or read
+ * from a saved image in place. Once buildRanks is called, the number of ones
+ * in every block of RANK_BLOCK_WORDS words is kept, so rank only counts the
+ * ones of at most one block, adding 32 bits for every 512.
+ */
+class BitVector {
+  private:
+    // Bits, the first in the lowest bit of the first word
+    vector<uint64_t> words;
+
+    // Ones before each block of words, with the total at the back
+    vector<uint32_t> blockRanks;
+
+    // Bits and counts read, either those above or those of an image
+    const uint64_t* bits;
+    const uint32_t* ranks;
+
+    // Number of bits appended
+    size_t numBits;
+
+    /* Returns the number of counts kept for a number of bits
+       numBits: number of bits
+    */
+    static size_t numRanks(size_t numBits);
+
+  public:
+    /* Initializes an empty vector of bits */
+    BitVector();
+
+    /* Bits are read through pointers into their vectors, so they are not
+       copied */
+    BitVector(const BitVector&) = delete;
+    BitVector& operator=(const BitVector&) = delete;
+
+    /* Empties the vector */
+    void clear();
+
+    /* Reserves room for a number of bits
+       bits: number of bits to be appended
+    */
+    void reserve(size_t bits) { words.reserve((bits + 63) / 64); }
+
+    /* Appends a bit
+       bit: bit to be appended
+    */
+    void push_back(bool bit);
+
+    /* Counts the ones of every block, to be called once every bit is
+       appended and before any is read */
+    void buildRanks();
+
+    /* Writes the number of bits, the bits, and the counts, padded to whole
+       words
+       out: stream written to
+    */
+    void save(ostream& out) const;
+
+    /* Reads the bits and counts saved in an image in place, advancing past
+       them. Returns false if the image ends before them
+       cursor: first word of the saved bits, moved past them
+       end: end of the image
+    */
+    bool attach(const uint64_t*& cursor, const uint64_t* end);
+
+    /* Returns the bit at a position
+       pos: position of the bit
+    */
+    bool get(size_t pos) const { return (bits[pos / 64] >> (pos % 64)) & 1; }
+
+    /* Returns the number of ones before a position
+       pos: position, at most the number of bits
+    */
+    size_t rank(size_t pos) const;
+
+    /* Returns the number of bits appended */
+    size_t size() const { return numBits; }
+
+    /* Returns the bytes held by the bits and counts */
+    size_t bytes() const;
+};
+
+#endif  // BIT_VECTOR_HPP
@@ -12,7 +12,11 @@
 #include "TSTNode.hpp"
 
 /* Initializes an empty ternary search trie. */
-DictionaryTrie::DictionaryTrie() { root = nullptr; }
+DictionaryTrie::DictionaryTrie() {
+    // Index NO_NODE is taken by a placeholder, so no real node has it
+    nodes.emplace_back('\0');
+    root = NO_NODE;
+}
 
 /* Inserts a word into the trie and marks the last letter as the end of the word
  * along with its frequency. If an empty string is inserted or the word already
@@ -26,123 +30,81 @@ bool DictionaryTrie::insert(string word, unsigned int freq) {
         return false;
     }
 
-    // Create node to traverse trie
-    TSTNode* node = root;
-
-    // Keeps track of the current letter in word
-    unsigned int currIdx = 0;
-
-    // Return false if string already exists in trie
-    if (findHelper(word, root, true, freq) != nullptr) {
+    // Return false if string already exists in trie, marking it as a word if
+    // it was only the prefix of others
+    uint32_t found = findHelper(word, root, false, 0);
+    if (found != NO_NODE) {
+        if (!nodes[found].isEndWord) {
+            nodes[found].isEndWord = true;
+            nodes[found].freq = freq;
+            raiseMaxFreq(word, freq);
+        }
         return false;
     }
 
-    // Create root node
-    if (root == nullptr) {
-        root = new TSTNode(word.at(currIdx));
-        if (word.at(currIdx) == word.at(word.size() - 1) &&
-            currIdx == word.size() - 1) {
-            root->isEndWord = true;
-            root->freq = freq;
-            return true;
-        }
-
-        node = root;
-
-        // Create nodes for rest of letters in word with middle
-        // child
-        for (auto i = 1; i < word.size(); i++) {
-            node->middle = new TSTNode(word.at(i));
-            node = node->middle;
-        }
-
-        // Mark last letter as end of word and add the word's
-        // frequency
-        node->isEndWord = true;
-        node->freq = freq;
+    // Create root node along with the rest of the word
+    if (root == NO_NODE) {
+        root = addChain(word, 0, freq);
+        raiseMaxFreq(word, freq);
         return true;
     }
 
+    // Create node to traverse trie. Adding nodes may move the pool, so nodes
+    // are only held by index
+    uint32_t node = root;
+
+    // Keeps track of the current letter in word
+    unsigned int currIdx = 0;
+
     // Loop until end of word is found
     while (true) {
         // Checks left child
-        if (word.at(currIdx) < node->data) {
+        if (word.at(currIdx) < nodes[node].data) {
             // If left node exists, go left
-            if (node->left != nullptr) {
-                node = node->left;
+            if (nodes[node].left != NO_NODE) {
+                node = nodes[node].left;
             } else {
-                // Create new node on left and go to it
-                node->left = new TSTNode(word.at(currIdx));
-                currIdx++;
-                node = node->left;
-
-                // Create nodes for rest of letters in word with the middle
-                // child
-                for (auto i = currIdx; i < word.size(); i++) {
-                    node->middle = new TSTNode(word.at(i));
-                    node = node->middle;
-                    currIdx++;
-                }
-
-                // Mark last letter as end of word and add the word's frequency
-                node->isEndWord = true;
-                node->freq = freq;
+                // Create new node on left along with the rest of the word
+                uint32_t child = addChain(word, currIdx, freq);
+                nodes[node].left = child;
+                raiseMaxFreq(word, freq);
                 return true;
             }
 
             // Checks right child
-        } else if (word.at(currIdx) > node->data) {
+        } else if (word.at(currIdx) > nodes[node].data) {
             // If right node exists, go right
-            if (node->right != nullptr) {
-                node = node->right;
+            if (nodes[node].right != NO_NODE) {
+                node = nodes[node].right;
             } else {
-                // Create new node on right and go to it
-                node->right = new TSTNode(word.at(currIdx));
-                currIdx++;
-                node = node->right;
-
-                // Creates nodes for rest of letters in word with middle child
-                for (auto i = currIdx; i < word.size(); i++) {
-                    node->middle = new TSTNode(word.at(currIdx));
-                    node = node->middle;
-                    currIdx++;
-                }
-
-                // Mark last letter as end of word and add the word's frequency
-                node->isEndWord = true;
-                node->freq = freq;
+                // Create new node on right along with the rest of the word
+                uint32_t child = addChain(word, currIdx, freq);
+                nodes[node].right = child;
+                raiseMaxFreq(word, freq);
                 return true;
             }
 
             // Checks middle child
         } else {
             // If current letter is the last letter, mark as end of word
-            if (word.at(currIdx) == word.at(word.size() - 1) &&
-                currIdx == word.size() - 1) {
-                if (node->freq == 0) {
-                    node->isEndWord = true;
-                    node->freq = freq;
+            if (currIdx == word.size() - 1) {
+                if (nodes[node].freq == 0) {
+                    nodes[node].isEndWord = true;
+                    nodes[node].freq = freq;
                 }
+                raiseMaxFreq(word, freq);
                 return true;
             } else {
                 // If middle node exists, go to it and proceed to next letter
-                if (node->middle != nullptr) {
-                    node = node->middle;
+                if (nodes[node].middle != NO_NODE) {
+                    node = nodes[node].middle;
                     currIdx++;
                 } else {
                     // Create nodes for rest of letters in word with middle
                     // child
-                    currIdx++;
-                    for (auto i = currIdx; i < word.size(); i++) {
-                        node->middle = new TSTNode(word.at(i));
-                        node = node->middle;
-                        currIdx++;
-                    }
-
-                    // Mark last letter as end of word and add the word's
-                    // frequency
-                    node->isEndWord = true;
-                    node->freq = freq;
+                    uint32_t child = addChain(word, currIdx + 1, freq);
+                    nodes[node].middle = child;
+                    raiseMaxFreq(word, freq);
                     return true;
                 }
             }
@@ -152,17 +114,41 @@ bool DictionaryTrie::insert(string word, unsigned int freq) {
     return false;
 }
 
+/* Adds a node for each letter of word from start on, each the middle child of
+   the one before, and marks the last as the end of the word. The nodes are
+   next to each other in the pool, so a word is read straight through.
+   Returns the index of the first
+   word: word whose letters are added
+   start: index of the first letter added
+   freq: frequency of word
+*/
+uint32_t DictionaryTrie::addChain(const string& word, unsigned int start,
+                                  unsigned int freq) {
+    uint32_t first = nodes.size();
+    for (unsigned int i = start; i < word.size(); i++) {
+        nodes.emplace_back(word[i]);
+        if (i + 1 < word.size()) {
+            nodes.back().middle = nodes.size();
+        }
+    }
+
+    // Mark last letter as end of word and add the word's frequency
+    nodes.back().isEndWord = true;
+    nodes.back().freq = freq;
+    return first;
+}
+
 /* Finds a word in the Ternary Search Trie and returns true if the word is
  * found. Returns false otherwise.
  * word: string that is searched within the trie
  */
 bool DictionaryTrie::find(string word) const {
     // If trie empty, return false
-    if (root == nullptr) {
+    if (root == NO_NODE) {
         return false;
     }
 
-    TSTNode* node = root;
+    uint32_t node = root;
 
     // Keeps track of current letter within word
     unsigned int currIdx = 0;
@@ -173,20 +159,20 @@ bool DictionaryTrie::find(string word) const {
             return false;
         }
         // Checks left child
-        if (word.at(currIdx) < node->data) {
+        if (word.at(currIdx) < nodes[node].data) {
             // If left node exists, go left
-            if (node->left != nullptr) {
-                node = node->left;
+            if (nodes[node].left != NO_NODE) {
+                node = nodes[node].left;
             } else {
                 // If no node exists, word is not in trie, return false
                 return false;
             }
 
             // Checks right child
-        } else if (word.at(currIdx) > node->data) {
+        } else if (word.at(currIdx) > nodes[node].data) {
             // If right node exists, go right
-            if (node->right != nullptr) {
-                node = node->right;
+            if (nodes[node].right != NO_NODE) {
+                node = nodes[node].right;
             } else {
                 // If no node exists, word is not in trie, return false
                 return false;
@@ -201,8 +187,8 @@ bool DictionaryTrie::find(string word) const {
             } else {
                 // If middle node exists, go middle, and increment to the
                 // next letter
-                if (node->middle != nullptr) {
-                    node = node->middle;
+                if (nodes[node].middle != NO_NODE) {
+                    node = nodes[node].middle;
                     currIdx++;
                 } else {
                     // Word has not been found in trie
@@ -216,131 +202,53 @@ bool DictionaryTrie::find(string word) const {
     return false;
 }
 
-/* Predicts numCompletion words with the given prefix
+/* Predicts numCompletion words with the given prefix, highest frequency
+   first, then alphabetically
    prefix: beginning of word to be found
    numCompletions: maximum amount of words to be found
 */
-vector<string> DictionaryTrie::predictCompletions(string prefix,
+vector<string> DictionaryTrie::predictCompletions(const string& prefix,
                                                   unsigned int numCompletions) {
     // Find last letter of prefix
-    TSTNode* begin = findHelper(prefix, root, false, 0);
+    uint32_t begin = findHelper(prefix, root, false, 0);
 
     // If beginning node does not exist, return empty vector
-    if (begin == nullptr) {
+    if (begin == NO_NODE) {
         return {};
     }
 
-    // Vector to store all possible matches
-    vector<pair<int, string>> wordVector;
-
-    // Call predict to traverse trie and add autocompleted words to wordVector
-    predict(wordVector, begin->middle, "");
-
-    // Insert the prefix to each of the words found using predict
-    for (auto i = 0; i < wordVector.size(); i++) {
-        wordVector[i].second.insert(0, prefix);
-    }
-
-    // If prefix itself is a word, add to wordVector
-    if (begin->isEndWord) {
-        wordVector.push_back(make_pair(begin->freq, prefix));
-    }
-
-    // Return empty vector if no words
-    if (wordVector.size() == 0) {
-        return {};
-    }
-
-    // Sort by frequencies, then alphabetically if equal
-    sort(wordVector.begin(), wordVector.end(), [](auto& left, auto& right) {
-        if (left.first != right.first) {
-            return left.first > right.first;
-        }
-        return left.second < right.second;
-    });
-
-    // String vector containing only words
-    vector<string> wordsWithPrefix;
-
-    int iterations = numCompletions;
-
-    // Make number of iterations equal to wordVector's size if smaller than
-    // numCompletions
-    if (numCompletions > wordVector.size() - 1) {
-        iterations = wordVector.size();
-    }
-
-    // Insert words into wordsWithPrefix
-    for (int i = 0; i < iterations; i++) {
-        wordsWithPrefix.push_back(wordVector[i].second);
-    }
-
-    return wordsWithPrefix;
+    return search.predictCompletions(*this, begin, prefix, numCompletions);
 }
 
-/* Predict completions with given word with wildcard underscores
+/* Predict completions with given word with wildcard underscores, highest
+   frequency first, then alphabetically
    pattern: word with underscores to be autocompleted
    numCompletions: maximum amount of words to be found
 */
 std::vector<string> DictionaryTrie::predictUnderscores(
-    string pattern, unsigned int numCompletions) {
+    const string& pattern, unsigned int numCompletions) {
     // If root does not exist, return empty vector
-    if (root == nullptr) {
+    if (root == NO_NODE) {
         return {};
     }
 
-    // Create wordVector storing freq and word
-    vector<pair<int, string>> wordVector;
-
-    // Call helper to traverse trie and find autocompleted words
-    underscoreHelper(wordVector, root, "", 0, pattern);
-
-    // If no words, return empty vector
-    if (wordVector.size() == 0) {
-        return {};
-    }
-
-    // Sort vector by frequency, then alphabetically if freq equal
-    sort(wordVector.begin(), wordVector.end(), [](auto& left, auto& right) {
-        if (left.first != right.first) {
-            return left.first > right.first;
-        }
-        return left.second < right.second;
-    });
-
-    // Vector with valid words
-    vector<string> results;
-
-    int iterations = numCompletions;
-
-    // Make number of iterations equal to wordVector's size if smaller than
-    // numCompletions
-    if (numCompletions > wordVector.size() - 1) {
-        iterations = wordVector.size();
-    }
-
-    // Insert words into wordsWithPrefix
-    for (int i = 0; i < iterations; i++) {
-        results.push_back(wordVector[i].second);
-    }
-
-    return results;
+    return search.predictUnderscores(*this, root, pattern, numCompletions);
 }
 
-/* Delete nodes of entire TST */
-DictionaryTrie::~DictionaryTrie() { deleteAll(root); }
+/* Frees the pool of nodes of the entire TST, every node at once */
+DictionaryTrie::~DictionaryTrie() {}
 
 /* Helper method that finds the node of the last letter of word. If word is
- * not found, return nullptr.
+ * not found, return NO_NODE.
  * word: word to be searched for in trie
  * node: beginning node of where to start searching
  * setFreq: if last node exists in trie, set its freq
  * freq: freq of word
  */
-TSTNode* DictionaryTrie::findHelper(string word, TSTNode* node, bool setFreq,
-                                    unsigned int freq) {
-    if (node == nullptr) {
-        return nullptr;
+uint32_t DictionaryTrie::findHelper(const string& word, uint32_t node,
+                                    bool setFreq, unsigned int freq) {
+    if (node == NO_NODE) {
+        return NO_NODE;
     }
 
     // Keeps track of current letter within word
@@ -349,23 +257,23 @@ TSTNode* DictionaryTrie::findHelper(string word, TSTNode* node, bool setFreq,
     // Keep looping until word is found or reaches end of trie
     while (true) {
         // Checks left child
-        if (word.at(currIdx) < node->data) {
+        if (word.at(currIdx) < nodes[node].data) {
             // If left node exists, go left
-            if (node->left != nullptr) {
-                node = node->left;
+            if (nodes[node].left != NO_NODE) {
+                node = nodes[node].left;
             } else {
-                // If no node exists, word is not in trie, return nullptr
-                return nullptr;
+                // If no node exists, word is not in trie, return NO_NODE
+                return NO_NODE;
             }
 
             // Checks right child
-        } else if (word.at(currIdx) > node->data) {
+        } else if (word.at(currIdx) > nodes[node].data) {
             // If right node exists, go right
-            if (node->right != nullptr) {
-                node = node->right;
+            if (nodes[node].right != NO_NODE) {
+                node = nodes[node].right;
             } else {
-                // If no node exists, word is not in trie, return nullptr
-                return nullptr;
+                // If no node exists, word is not in trie, return NO_NODE
+                return NO_NODE;
             }
 
             // Checks middle child
@@ -374,153 +282,53 @@ TSTNode* DictionaryTrie::findHelper(string word, TSTNode* node, bool setFreq,
             // the node
             if (word.at(currIdx) == word.at(word.size() - 1) &&
                 currIdx == word.size() - 1) {
-                if (node->isEndWord == false && setFreq == true) {
-                    node->isEndWord = true;
-                    node->freq = freq;
+                if (nodes[node].isEndWord == false && setFreq == true) {
+                    nodes[node].isEndWord = true;
+                    nodes[node].freq = freq;
                     return node;
                 }
                 return node;
             } else {
                 // If middle node exists, go middle, and increment to the
                 // next letter
-                if (node->middle != nullptr) {
-                    node = node->middle;
+                if (nodes[node].middle != NO_NODE) {
+                    node = nodes[node].middle;
                     currIdx++;
                 } else {
                     // Word has not been found in trie
-                    return nullptr;
+                    return NO_NODE;
                 }
             }
         }
     }
 
-    // Returns nullptr is find is unsuccessful
-    return nullptr;
-}
-
-/* Recursively traverse through trie to predict words based on given prefix
-   wordVector: vector to add valid words to
-   node: node containing letter being checked
-   curString: string containing letters of valid nodes
-*/
-void DictionaryTrie::predict(vector<pair<int, string>>& wordVector,
-                             TSTNode* node, string curString) {
-    // If node does not exist return
-    if (node == nullptr) {
-        return;
-    }
-
-    // If node has the flag of end word, add to wordVector
-    if (node->isEndWord) {
-        wordVector.push_back(make_pair(node->freq, curString + node->data));
-    }
-
-    // Traverse left if left node exists
-    if (node->left != nullptr) {
-        predict(wordVector, node->left, curString);
-    }
-
-    // Traverse middle if middle node exists and add its letter to curString
-    if (node->middle != nullptr) {
-        predict(wordVector, node->middle, curString + node->data);
-    }
-
-    // Traverse right if right node exists
-    if (node->right != nullptr) {
-        predict(wordVector, node->right, curString);
-    }
-
-    return;
+    // Returns NO_NODE is find is unsuccessful
+    return NO_NODE;
 }
 
-/* Recursively traverse through trie to predict words based on given prefix with
-   underscores
-   wordVector: vector for words and freqencies to be added to
-   node: node containing letter being checked
-   curString: string containing letters of valid nodes
-   curIdx: current index of the words being checked
-   word: word to be searched in trie
+/* Raises the highest frequency of every node on the path of word
+   word: word whose path is raised
+   freq: frequency of word
 */
-void DictionaryTrie::underscoreHelper(vector<pair<int, string>>& wordVector,
-                                      TSTNode* node, string curString,
-                                      int curIdx, string word) {
-    // If curIdx about to go out of bounds, return
-    if (curIdx > word.size() - 1) {
-        return;
-    }
-
-    // If letter is a wildcard
-    if (word.at(curIdx) == '_') {
-        // If letter is end of word, add to wordVector
-        if (node->isEndWord == true && curIdx == word.size() - 1) {
-            wordVector.push_back(make_pair(node->freq, curString + node->data));
-        }
+void DictionaryTrie::raiseMaxFreq(const string& word, int freq) {
+    uint32_t node = root;
 
-        // Go left if left node exists
-        if (node->left != nullptr) {
-            underscoreHelper(wordVector, node->left, curString, curIdx, word);
-        }
+    // Keeps track of current letter within word
+    unsigned int currIdx = 0;
 
-        // Go middle if middle node exists, add letter to curString, and
-        // increment curIdx
-        if (node->middle != nullptr) {
-            underscoreHelper(wordVector, node->middle, curString + node->data,
-                             curIdx + 1, word);
-        }
+    // Every node passed holds word in its subtree
+    while (node != NO_NODE) {
+        nodes[node].maxFreq = max(nodes[node].maxFreq, freq);
 
-        // Go right if right node exists
-        if (node->right != nullptr) {
-            underscoreHelper(wordVector, node->right, curString, curIdx, word);
-        }
-    }
-
-    // If letter is not an underscore
-    if (word.at(curIdx) != '_') {
-        // If letter is end of word, add to wordVector
-        if (node->isEndWord == true && curIdx == word.size() - 1 &&
-            word.at(curIdx) == node->data) {
-            wordVector.push_back(make_pair(node->freq, curString + node->data));
+        if (word.at(currIdx) < nodes[node].data) {
+            node = nodes[node].left;
+        } else if (word.at(currIdx) > nodes[node].data) {
+            node = nodes[node].right;
+        } else if (currIdx == word.size() - 1) {
+            return;
         } else {
-            // If current letter is less than the node's letter go left
-            if (node->left != nullptr && word.at(curIdx) < node->data) {
-                underscoreHelper(wordVector, node->left, curString, curIdx,
-                                 word);
-
-                // If current letter equals the node's letter go middle, add
-                // letter to curString, and increment curIdx
-            } else if (node->middle != nullptr &&
-                       word.at(curIdx) == node->data) {
-                underscoreHelper(wordVector, node->middle,
-                                 curString + node->data, curIdx + 1, word);
-
-                // If current letter is greater than the node's letter go right
-            } else {
-                if (node->right != nullptr) {
-                    underscoreHelper(wordVector, node->right, curString, curIdx,
-                                     word);
-                }
-            }
+            node = nodes[node].middle;
+            currIdx++;
         }
     }
-
-    return;
 }
-
-/* Helper method to recursively delete nodes in trie
-   node: node to be deleted
-*/
-void DictionaryTrie::deleteAll(TSTNode* node) {
-    // If trie empty, return
-    if (node == nullptr) {
-        return;
-    }
-
-    // Recurse left to delete
-    deleteAll(node->left);
-
-    // Recurse right to delete
-    deleteAll(node->right);
-
-    // Delete node
-    delete node;
-}
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 #include "TSTNode.hpp"
+#include "TrieSearch.hpp"
 
 using namespace std;
 
@@ -23,40 +24,53 @@ using namespace std;
  */
 class DictionaryTrie {
   private:
+    /* Pool holding every node of the TST, the placeholder of NO_NODE first.
+       The whole pool is freed at once when the trie is */
+    vector<TSTNode> nodes;
+
     /* Keeps track of the TST's root */
-    TSTNode* root;
+    uint32_t root;
+
+    /* State of the prefix and wildcard searches, kept between queries */
+    TrieSearch<DictionaryTrie> search;
+
+    /* Nodes as read by the searches and by FrozenTrie
+       node: index of the node in the pool
+    */
+    uint32_t leftOf(uint32_t node) const { return nodes[node].left; }
+    uint32_t middleOf(uint32_t node) const { return nodes[node].middle; }
+    uint32_t rightOf(uint32_t node) const { return nodes[node].right; }
+    char letterOf(uint32_t node) const { return nodes[node].data; }
+    bool isWord(uint32_t node) const { return nodes[node].isEndWord; }
+    int freqOf(uint32_t node) const { return nodes[node].freq; }
+    int maxFreqOf(uint32_t node) const { return nodes[node].maxFreq; }
+
+    friend class TrieSearch<DictionaryTrie>;
+    friend class FrozenTrie;
 
     /* Helper method that finds the node of the last letter of word. If word is
-     * not found, return nullptr.
+     * not found, return NO_NODE.
      * word: word to be searched for in trie
      * node: beginning node of where to start searching
      */
-    TSTNode* findHelper(string word, TSTNode* root, bool setFreq,
+    uint32_t findHelper(const string& word, uint32_t root, bool setFreq,
                         unsigned int freq);
 
-    /* Recursively traverse through trie to predict words based on given prefix
-       wordVector: vector to add valid words to
-       node: node containing letter being checked
-       curString: string containing letters of valid nodes
-    */
-    void predict(vector<pair<int, string>>& wordVector, TSTNode* node,
-                 string curString);
-
-    /* Recursively traverse through trie to predict words based on given prefix
-       with underscores
-       wordVector: vector for words and freqencies to be added to
-       node: node containing letter being checked
-       curString: string containing letters of valid nodes
-       curIdx: current index of the words being checked
-       word: word to be searched in trie
+    /* Adds a node for each letter of word from start on, each the middle
+       child of the one before, and marks the last as the end of the word.
+       Returns the index of the first
+       word: word whose letters are added
+       start: index of the first letter added
+       freq: frequency of word
     */
-    void underscoreHelper(vector<pair<int, string>>& wordVector, TSTNode* node,
-                          string curString, int curIdx, string word);
+    uint32_t addChain(const string& word, unsigned int start,
+                      unsigned int freq);
 
-    /* Helper method to recursively delete nodes in trie
-       node: node to be deleted
+    /* Raises the highest frequency of every node on the path of word
+       word: word whose path is raised
+       freq: frequency of word
     */
-    void deleteAll(TSTNode* node);
+    void raiseMaxFreq(const string& word, int freq);
 
   public:
     /* Initializes an empty ternary search trie. */
@@ -80,17 +94,17 @@ class DictionaryTrie {
        prefix: beginning of word to be found
        numCompletions: maximum amount of words to be found
     */
-    vector<string> predictCompletions(string prefix,
+    vector<string> predictCompletions(const string& prefix,
                                       unsigned int numCompletions);
 
     /* Predict completions with given word with wildcard underscores
       pattern: word with underscores to be autocompleted
       numCompletions: maximum amount of words to be found
     */
-    vector<string> predictUnderscores(string pattern,
+    vector<string> predictUnderscores(const string& pattern,
                                       unsigned int numCompletions);
 
-    /* Delete nodes of entire TST */
+    /* Frees the pool of nodes of the entire TST */
     ~DictionaryTrie();
 };
 
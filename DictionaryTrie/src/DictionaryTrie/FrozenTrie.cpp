@@ -0,0 +1,295 @@
+/**
+ * Creates a read-only dictionary trie in succinct form, frozen from a built
+ * DictionaryTrie
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+#include "FrozenTrie.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+/* Initializes an empty frozen trie */
+FrozenTrie::FrozenTrie() {
+    mapping = nullptr;
+    mappingBytes = 0;
+    freeze(DictionaryTrie());
+}
+
+/* Freezes a built trie, which may then be changed or deleted
+   trie: trie to be frozen
+*/
+FrozenTrie::FrozenTrie(const DictionaryTrie& trie) {
+    mapping = nullptr;
+    mappingBytes = 0;
+    freeze(trie);
+}
+
+/* Unmaps the snapshot read from, if any */
+FrozenTrie::~FrozenTrie() { unmap(); }
+
+/* Replaces the nodes with those of a built trie, which may then be changed or
+   deleted
+   trie: trie to be frozen
+*/
+void FrozenTrie::freeze(const DictionaryTrie& trie) {
+    // Nodes of trie in level order, the order they are numbered in
+    vector<uint32_t> order;
+    if (trie.root != NO_NODE) {
+        order.push_back(trie.root);
+    }
+
+    // Each node's children bits, its children queued behind the nodes before
+    children.clear();
+    children.reserve(size_t(trie.nodes.size()) * NUM_SLOTS);
+    for (size_t i = 0; i < order.size(); i++) {
+        uint32_t node = order[i];
+        for (uint32_t child : {trie.leftOf(node), trie.middleOf(node),
+                               trie.rightOf(node)}) {
+            children.push_back(child != NO_NODE);
+            if (child != NO_NODE) {
+                order.push_back(child);
+            }
+        }
+    }
+    children.buildRanks();
+
+    // Frequencies take the bits of the highest
+    uint32_t highestMax = 0;
+    uint32_t highestFreq = 0;
+    size_t numWords = 0;
+    for (uint32_t node : order) {
+        highestMax = max(highestMax, uint32_t(trie.maxFreqOf(node)));
+        if (trie.isWord(node)) {
+            highestFreq = max(highestFreq, uint32_t(trie.freqOf(node)));
+            numWords++;
+        }
+    }
+    maxFreqs.reset(PackedArray::bitsNeeded(highestMax), order.size());
+    freqs.reset(PackedArray::bitsNeeded(highestFreq), numWords);
+
+    letters.clear();
+    letters.reserve(order.size());
+    wordEnds.clear();
+    wordEnds.reserve(order.size());
+    for (uint32_t node : order) {
+        letters.push_back(trie.letterOf(node));
+        wordEnds.push_back(trie.isWord(node));
+        maxFreqs.push_back(trie.maxFreqOf(node));
+        if (trie.isWord(node)) {
+            freqs.push_back(trie.freqOf(node));
+        }
+    }
+    wordEnds.buildRanks();
+    letterData = letters.data();
+    numNodes = letters.size();
+
+    // Nothing is read from a snapshot any more
+    unmap();
+}
+
+/* Writes the nodes to a snapshot file. Returns false if it could not be
+   written
+   filename: name of the snapshot file
+*/
+bool FrozenTrie::save(const char* filename) const {
+    ofstream out(filename, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    uint64_t header[SNAPSHOT_HEADER_WORDS] = {0, SNAPSHOT_VERSION,
+                                              SNAPSHOT_BYTE_ORDER};
+    memcpy(header, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_BYTES);
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    children.save(out);
+    wordEnds.save(out);
+
+    // Letters, padded to whole words
+    uint64_t count = numNodes;
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(letterData, numNodes);
+    uint64_t padding = 0;
+    out.write(reinterpret_cast<const char*>(&padding),
+              (sizeof(uint64_t) - numNodes % sizeof(uint64_t)) %
+                  sizeof(uint64_t));
+
+    maxFreqs.save(out);
+    freqs.save(out);
+
+    out.close();
+    return !out.fail();
+}
+
+/* Replaces the nodes with those of a snapshot file, mapped into memory and
+   read in place. Returns false, leaving the trie empty, if the file could not
+   be mapped or is not a snapshot
+   filename: name of the snapshot file
+*/
+bool FrozenTrie::load(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        freeze(DictionaryTrie());
+        return false;
+    }
+
+    struct stat info;
+    void* image = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        image = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    // The mapping stays valid once its file is closed
+    close(fd);
+    if (image == MAP_FAILED) {
+        freeze(DictionaryTrie());
+        return false;
+    }
+
+    // Release the nodes held so far and read those of the snapshot
+    unmap();
+    mapping = image;
+    mappingBytes = info.st_size;
+    if (!attach()) {
+        freeze(DictionaryTrie());
+        return false;
+    }
+    vector<char>().swap(letters);
+    return true;
+}
+
+/* Returns true if a file starts as a snapshot does
+   filename: name of the file
+*/
+bool FrozenTrie::isSnapshot(const char* filename) {
+    ifstream in(filename, ios::binary);
+    char magic[SNAPSHOT_MAGIC_BYTES];
+    if (!in.read(magic, SNAPSHOT_MAGIC_BYTES)) {
+        return false;
+    }
+    return memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_BYTES) == 0;
+}
+
+/* Reads the nodes in place from the mapped snapshot. Returns false if it is
+   not a snapshot of this version and byte order or its sizes do not agree */
+bool FrozenTrie::attach() {
+    const uint64_t* cursor = static_cast<const uint64_t*>(mapping);
+    const uint64_t* end = cursor + mappingBytes / sizeof(uint64_t);
+
+    if (end - cursor < SNAPSHOT_HEADER_WORDS ||
+        memcmp(cursor, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_BYTES) != 0 ||
+        cursor[1] != SNAPSHOT_VERSION || cursor[2] != SNAPSHOT_BYTE_ORDER) {
+        return false;
+    }
+    cursor += SNAPSHOT_HEADER_WORDS;
+
+    if (!children.attach(cursor, end) || !wordEnds.attach(cursor, end)) {
+        return false;
+    }
+
+    // Letters, padded to whole words
+    if (end - cursor < 1 ||
+        cursor[0] > size_t(end - cursor - 1) * sizeof(uint64_t)) {
+        return false;
+    }
+    numNodes = cursor[0];
+    letterData = reinterpret_cast<const char*>(cursor + 1);
+    cursor += 1 + (numNodes + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    if (!maxFreqs.attach(cursor, end) || !freqs.attach(cursor, end)) {
+        return false;
+    }
+
+    // Every node but the root is the child of one set bit, and every word
+    // has a frequency
+    return children.size() == numNodes * NUM_SLOTS &&
+           children.rank(children.size()) + (numNodes > 0) == numNodes &&
+           wordEnds.size() == numNodes && maxFreqs.size() == numNodes &&
+           freqs.size() == wordEnds.rank(numNodes);
+}
+
+/* Unmaps the snapshot, if any */
+void FrozenTrie::unmap() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingBytes);
+        mapping = nullptr;
+        mappingBytes = 0;
+    }
+}
+
+/* Returns the node of the last letter of word, or NO_NODE if word is not
+   found
+   word: word to be searched for in trie
+*/
+uint32_t FrozenTrie::findNode(const string& word) const {
+    // If trie empty, word is not in it
+    if (numNodes == 0) {
+        return NO_NODE;
+    }
+
+    uint32_t node = 1;
+
+    // Keeps track of current letter within word
+    unsigned int currIdx = 0;
+
+    // Keep looping until word is found or reaches end of trie
+    while (node != NO_NODE) {
+        if (word.at(currIdx) < letterOf(node)) {
+            node = leftOf(node);
+        } else if (word.at(currIdx) > letterOf(node)) {
+            node = rightOf(node);
+        } else if (currIdx == word.size() - 1) {
+            return node;
+        } else {
+            node = middleOf(node);
+            currIdx++;
+        }
+    }
+
+    return NO_NODE;
+}
+
+/* Predicts numCompletion words with the given prefix, highest frequency
+   first, then alphabetically
+   prefix: beginning of word to be found
+   numCompletions: maximum amount of words to be found
+*/
+vector<string> FrozenTrie::predictCompletions(const string& prefix,
+                                              unsigned int numCompletions) {
+    // Find last letter of prefix
+    uint32_t begin = findNode(prefix);
+
+    // If beginning node does not exist, return empty vector
+    if (begin == NO_NODE) {
+        return {};
+    }
+
+    return search.predictCompletions(*this, begin, prefix, numCompletions);
+}
+
+/* Predict completions with given word with wildcard underscores, highest
+   frequency first, then alphabetically
+   pattern: word with underscores to be autocompleted
+   numCompletions: maximum amount of words to be found
+*/
+vector<string> FrozenTrie::predictUnderscores(const string& pattern,
+                                              unsigned int numCompletions) {
+    // If root does not exist, return empty vector
+    if (numNodes == 0) {
+        return {};
+    }
+
+    return search.predictUnderscores(*this, 1, pattern, numCompletions);
+}
+
+/* Returns the bytes held by the nodes and frequencies */
+size_t FrozenTrie::bytes() const {
+    return children.bytes() + wordEnds.bytes() + numNodes * sizeof(char) +
+           maxFreqs.bytes() + freqs.bytes();
+}
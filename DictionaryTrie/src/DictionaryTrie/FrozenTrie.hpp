@@ -0,0 +1,193 @@
+/**
+ * File that defines a read-only dictionary trie in succinct form, frozen from
+ * a built DictionaryTrie
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+#ifndef FROZEN_TRIE_HPP
+#define FROZEN_TRIE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BitVector.hpp"
+#include "DictionaryTrie.hpp"
+#include "PackedArray.hpp"
+#include "TrieSearch.hpp"
+
+using namespace std;
+
+// Positions of a node's left, middle, and right bits among its children bits
+#define LEFT_SLOT 0
+#define MIDDLE_SLOT 1
+#define RIGHT_SLOT 2
+#define NUM_SLOTS 3
+
+// First words of a snapshot: its magic, its version, and a number that reads
+// the same only on machines of the same byte order
+#define SNAPSHOT_MAGIC "DTFROZEN"
+#define SNAPSHOT_MAGIC_BYTES 8
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_BYTE_ORDER 0x0102030405060708ULL
+#define SNAPSHOT_HEADER_WORDS 3
+
+/**
+ * The class for a ternary search trie that is only queried, kept as level
+ * order unary degree sequence (LOUDS) bits. Nodes are numbered from 1 in
+ * level order, and three bits per node tell whether it has a left, middle,
+ * and right node. The children of every node come after those of the nodes
+ * before it, so the child behind a set bit is found by counting the set bits
+ * before it. Letters take a byte per node, and frequencies take as few bits
+ * as the highest needs. Predictions match those of the DictionaryTrie it was
+ * frozen from.
+ *
+ * None of this holds a pointer, so it is saved as a snapshot that is mapped
+ * back into memory and queried in place, without reading or copying it.
+ */
+class FrozenTrie {
+  private:
+    // Whether each node has a left, middle, and right node
+    BitVector children;
+
+    // Whether each node is the end of a word
+    BitVector wordEnds;
+
+    // Letter of each node
+    vector<char> letters;
+
+    // Letters read, either those above or those of a snapshot
+    const char* letterData;
+
+    // Number of nodes
+    size_t numNodes;
+
+    // Highest frequency of a word in each node's subtree, counting its left
+    // and right nodes along with its middle
+    PackedArray maxFreqs;
+
+    // Frequency of each word, in the order of the nodes it ends in
+    PackedArray freqs;
+
+    // State of the prefix and wildcard searches, kept between queries
+    TrieSearch<FrozenTrie> search;
+
+    // Snapshot mapped into memory and its size, if the nodes are read from
+    // one
+    void* mapping;
+    size_t mappingBytes;
+
+    /* Returns a child of a node, or NO_NODE if it has none there
+       node: number of the node
+       slot: position of the child's bit among the node's
+    */
+    uint32_t childOf(uint32_t node, unsigned int slot) const {
+        size_t pos = size_t(node - 1) * NUM_SLOTS + slot;
+        if (!children.get(pos)) {
+            return NO_NODE;
+        }
+
+        // Children are numbered from 2, after the root
+        return children.rank(pos) + 2;
+    }
+
+    /* Nodes as read by the searches
+       node: number of the node
+    */
+    uint32_t leftOf(uint32_t node) const { return childOf(node, LEFT_SLOT); }
+    uint32_t middleOf(uint32_t node) const {
+        return childOf(node, MIDDLE_SLOT);
+    }
+    uint32_t rightOf(uint32_t node) const {
+        return childOf(node, RIGHT_SLOT);
+    }
+    char letterOf(uint32_t node) const { return letterData[node - 1]; }
+    bool isWord(uint32_t node) const { return wordEnds.get(node - 1); }
+    int freqOf(uint32_t node) const {
+        return freqs.get(wordEnds.rank(node - 1));
+    }
+    int maxFreqOf(uint32_t node) const { return maxFreqs.get(node - 1); }
+
+    friend class TrieSearch<FrozenTrie>;
+
+    /* Returns the node of the last letter of word, or NO_NODE if word is not
+       found
+       word: word to be searched for in trie
+    */
+    uint32_t findNode(const string& word) const;
+
+    /* Reads the nodes in place from the mapped snapshot. Returns false if it
+       is not a snapshot of this version and byte order or its sizes do not
+       agree */
+    bool attach();
+
+    /* Unmaps the snapshot, if any */
+    void unmap();
+
+  public:
+    /* Initializes an empty frozen trie */
+    FrozenTrie();
+
+    /* Freezes a built trie, which may then be changed or deleted
+       trie: trie to be frozen
+    */
+    explicit FrozenTrie(const DictionaryTrie& trie);
+
+    /* Nodes may be read from a mapped snapshot, so they are not copied */
+    FrozenTrie(const FrozenTrie&) = delete;
+    FrozenTrie& operator=(const FrozenTrie&) = delete;
+
+    /* Unmaps the snapshot read from, if any */
+    ~FrozenTrie();
+
+    /* Replaces the nodes with those of a built trie, which may then be
+       changed or deleted
+       trie: trie to be frozen
+    */
+    void freeze(const DictionaryTrie& trie);
+
+    /* Writes the nodes to a snapshot file. Returns false if it could not be
+       written
+       filename: name of the snapshot file
+    */
+    bool save(const char* filename) const;
+
+    /* Replaces the nodes with those of a snapshot file, mapped into memory
+       and read in place, so only the pages queries touch are read from disk.
+       A snapshot is trusted to have been written by save: only its header
+       and the sizes of its parts are checked. Returns false, leaving the trie
+       empty, if the file could not be mapped or is not a snapshot
+       filename: name of the snapshot file
+    */
+    bool load(const char* filename);
+
+    /* Returns true if a file starts as a snapshot does
+       filename: name of the file
+    */
+    static bool isSnapshot(const char* filename);
+
+    /* Predicts numCompletion words with the given prefix, highest frequency
+       first, then alphabetically
+       prefix: beginning of word to be found
+       numCompletions: maximum amount of words to be found
+    */
+    vector<string> predictCompletions(const string& prefix,
+                                      unsigned int numCompletions);
+
+    /* Predict completions with given word with wildcard underscores, highest
+       frequency first, then alphabetically
+       pattern: word with underscores to be autocompleted
+       numCompletions: maximum amount of words to be found
+    */
+    vector<string> predictUnderscores(const string& pattern,
+                                      unsigned int numCompletions);
+
+    /* Returns the number of nodes */
+    size_t size() const { return numNodes; }
+
+    /* Returns the bytes held by the nodes and frequencies */
+    size_t bytes() const;
+};
+
+#endif  // FROZEN_TRIE_HPP
@@ -0,0 +1,103 @@
+/**
+ * Creates an array of unsigned numbers packed into as few bits as the
+ * largest of them needs
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+#include "PackedArray.hpp"
+
+/* Initializes an empty array of numbers taking no bits */
+PackedArray::PackedArray() {
+    data = nullptr;
+    width = 0;
+    count = 0;
+}
+
+/* Returns the bits needed by a number
+   value: number to be measured
+*/
+unsigned int PackedArray::bitsNeeded(uint32_t value) {
+    unsigned int bits = 0;
+    while (value > 0) {
+        value >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
+/* Empties the array and sets the bits taken by each number
+   bits: bits taken by each number, from 0 to 32
+   capacity: number of numbers to be appended
+*/
+void PackedArray::reset(unsigned int bits, size_t capacity) {
+    words.clear();
+    words.reserve((capacity * bits + 63) / 64);
+    data = words.data();
+    width = bits;
+    count = 0;
+}
+
+/* Appends a number
+   value: number to be appended, which must fit in the width
+*/
+void PackedArray::push_back(uint32_t value) {
+    size_t bit = count * width;
+    count++;
+    if (width == 0) {
+        return;
+    }
+
+    // Grow to hold the last bit of the number
+    while (words.size() * 64 < bit + width) {
+        words.push_back(0);
+    }
+
+    size_t word = bit / 64;
+    unsigned int offset = bit % 64;
+    words[word] |= uint64_t(value) << offset;
+    if (offset + width > 64) {
+        words[word + 1] |= uint64_t(value) >> (64 - offset);
+    }
+    data = words.data();
+}
+
+/* Writes the width, the number of numbers, and the numbers
+   out: stream written to
+*/
+void PackedArray::save(ostream& out) const {
+    uint64_t header[2] = {width, count};
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(data),
+              numWords() * sizeof(uint64_t));
+}
+
+/* Reads the numbers saved in an image in place, advancing past them. Returns
+   false if the image ends before them or is not a valid array
+   cursor: first word of the saved numbers, moved past them
+   end: end of the image
+*/
+bool PackedArray::attach(const uint64_t*& cursor, const uint64_t* end) {
+    if (end - cursor < 2 || cursor[0] > 32) {
+        return false;
+    }
+    unsigned int savedWidth = cursor[0];
+    size_t savedCount = cursor[1];
+
+    // A count too high for the image is rejected before it is multiplied
+    size_t imageBits = size_t(end - cursor) * 64;
+    if (savedWidth > 0 && savedCount > imageBits / savedWidth) {
+        return false;
+    }
+    size_t savedWords = (savedCount * savedWidth + 63) / 64;
+    if (size_t(end - cursor - 2) < savedWords) {
+        return false;
+    }
+
+    vector<uint64_t>().swap(words);
+    width = savedWidth;
+    count = savedCount;
+    data = cursor + 2;
+    cursor = data + savedWords;
+    return true;
+}
@@ -0,0 +1,101 @@
+/**
+ * File that defines an array of unsigned numbers packed into as few bits as
+ * the largest of them needs
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+#ifndef PACKED_ARRAY_HPP
+#define PACKED_ARRAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The class for an array of numbers that each take the same number of bits,
+ * set before any is appended, or read from a saved image in place. A number
+ * may cross from one 64-bit word into the next.
+ */
+class PackedArray {
+  private:
+    // Packed numbers, the first in the lowest bits of the first word
+    vector<uint64_t> words;
+
+    // Numbers read, either those above or those of an image
+    const uint64_t* data;
+
+    // Bits taken by each number, from 0 to 32
+    unsigned int width;
+
+    // Number of numbers appended
+    size_t count;
+
+  public:
+    /* Initializes an empty array of numbers taking no bits */
+    PackedArray();
+
+    /* Numbers are read through a pointer into their vector, so they are not
+       copied */
+    PackedArray(const PackedArray&) = delete;
+    PackedArray& operator=(const PackedArray&) = delete;
+
+    /* Returns the bits needed by a number
+       value: number to be measured
+    */
+    static unsigned int bitsNeeded(uint32_t value);
+
+    /* Empties the array and sets the bits taken by each number
+       bits: bits taken by each number, from 0 to 32
+       capacity: number of numbers to be appended
+    */
+    void reset(unsigned int bits, size_t capacity);
+
+    /* Appends a number
+       value: number to be appended, which must fit in the width
+    */
+    void push_back(uint32_t value);
+
+    /* Writes the width, the number of numbers, and the numbers
+       out: stream written to
+    */
+    void save(ostream& out) const;
+
+    /* Reads the numbers saved in an image in place, advancing past them.
+       Returns false if the image ends before them or is not a valid array
+       cursor: first word of the saved numbers, moved past them
+       end: end of the image
+    */
+    bool attach(const uint64_t*& cursor, const uint64_t* end);
+
+    /* Returns the number at an index
+       index: index of the number
+    */
+    uint32_t get(size_t index) const {
+        if (width == 0) {
+            return 0;
+        }
+        size_t bit = index * width;
+        size_t word = bit / 64;
+        unsigned int offset = bit % 64;
+        uint64_t value = data[word] >> offset;
+        if (offset + width > 64) {
+            value |= data[word + 1] << (64 - offset);
+        }
+        return value & ((uint64_t(1) << width) - 1);
+    }
+
+    /* Returns the number of numbers appended */
+    size_t size() const { return count; }
+
+    /* Returns the bytes held by the numbers */
+    size_t bytes() const { return numWords() * sizeof(uint64_t); }
+
+    /* Returns the number of words holding the numbers */
+    size_t numWords() const { return (count * width + 63) / 64; }
+};
+
+#endif  // PACKED_ARRAY_HPP
@@ -6,38 +6,46 @@
  */
 #ifndef TSTNODE_HPP
 #define TSTNODE_HPP
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 using namespace std;
 
-/* The class to initialize a single node within the TST */
+// Index of no node, taken by a placeholder at the front of every pool
+#define NO_NODE 0
+
+/* The class to initialize a single node within the TST. Nodes live in the
+   pool of their trie and refer to their children by index into it, which
+   keeps a node to 24 bytes */
 class TSTNode {
   public:
-    // Pointers to a node's left, right, and middle nodes
-    TSTNode* left;
-    TSTNode* right;
-    TSTNode* middle;
+    // Indices of a node's left, right, and middle nodes, or NO_NODE
+    uint32_t left;
+    uint32_t right;
+    uint32_t middle;
+
+    // Frequency word appears
+    int freq;
+
+    // Highest frequency of a word ending in this node's subtree, counting its
+    // left and right nodes along with its middle
+    int maxFreq;
 
     // Letter to be inserted into the node
-    char const data;
+    char data;
 
     // Marks if node is the end of the word
     bool isEndWord;
 
-    // Marks if node has been visited
-    bool visited;
-
-    // Frequency word appears
-    int freq;
-
     /* Initializes a Ternary Search Trie Node */
     TSTNode(const char& d) : data(d) {
-        left = nullptr;
-        right = nullptr;
-        middle = nullptr;
+        left = NO_NODE;
+        right = NO_NODE;
+        middle = NO_NODE;
         isEndWord = false;
         freq = 0;
+        maxFreq = 0;
     }
 };
 
-#endif  // TSTNODE_HPP
\ No newline at end of file
+#endif  // TSTNODE_HPP
@@ -0,0 +1,413 @@
+/**
+ * File that defines the prefix and wildcard searches shared by every trie
+ * whose nodes form a ternary search trie
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+#ifndef TRIE_SEARCH_HPP
+#define TRIE_SEARCH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TSTNode.hpp"
+
+using namespace std;
+
+/**
+ * The class holding the state of the searches of a ternary search trie, kept
+ * between queries so its memory is reused. Trie gives its nodes by index,
+ * NO_NODE being none, through leftOf, middleOf, rightOf, letterOf, isWord,
+ * freqOf, and maxFreqOf, the highest frequency of a word in a node's subtree
+ * counting its left and right nodes along with its middle.
+ */
+template <class Trie>
+class TrieSearch {
+  private:
+    /* Letter on the path of a word or subtree reached by the best-first
+       search of predictCompletions. Paths that share letters share links, so
+       each path is kept as the link of its last letter */
+    struct PathLink {
+        // Letter of the link
+        char letter;
+
+        // Link of the letter before, or -1 if it follows the prefix
+        int parent;
+
+        // Number of letters on the path after the prefix
+        int depth;
+    };
+
+    /* Entry of the best-first search of predictCompletions: a word found, or
+       a node whose subtree holds words of at most its frequency */
+    struct Candidate {
+        // Frequency of the word, or highest frequency in the subtree
+        int freq;
+
+        // Node whose subtree is still to be searched, or NO_NODE for a word
+        uint32_t node;
+
+        // Link of the last letter of the word or of the letters leading to
+        // the node, or -1 for the prefix itself
+        int path;
+    };
+
+    /* Links of the paths reached by the current search */
+    vector<PathLink> pathLinks;
+
+    /* Heap of the words and subtrees still to be searched */
+    vector<Candidate> candidates;
+
+    /* Letters of the path being searched by underscoreHelper */
+    string pathBuffer;
+
+    /* Best words found so far by predictUnderscores, worst on top of the
+       heap. Only the first topSize are in use, the rest keep their memory for
+       later searches */
+    vector<pair<int, string>> topWords;
+    unsigned int topSize;
+
+    /* Returns true if a word is ranked before another: a higher frequency,
+       then alphabetically
+       left: first frequency and word
+       right: second frequency and word
+    */
+    static bool rankedBefore(const pair<int, string>& left,
+                             const pair<int, string>& right) {
+        if (left.first != right.first) {
+            return left.first > right.first;
+        }
+        return left.second < right.second;
+    }
+
+    /* Returns a negative number, zero, or a positive number as the path of
+       one link is alphabetically before, the same as, or after another's.
+       Both are walked up to their last shared link, so no word is built
+       left: link of the first path
+       right: link of the second path
+    */
+    int comparePaths(int left, int right) const {
+        if (left == right) {
+            return 0;
+        }
+
+        int leftDepth = left < 0 ? 0 : pathLinks[left].depth;
+        int rightDepth = right < 0 ? 0 : pathLinks[right].depth;
+
+        // Walk the longer path up to the length of the other, which comes
+        // first if it is what the longer path starts with
+        int longer = leftDepth - rightDepth;
+        while (leftDepth > rightDepth) {
+            left = pathLinks[left].parent;
+            leftDepth--;
+        }
+        while (rightDepth > leftDepth) {
+            right = pathLinks[right].parent;
+            rightDepth--;
+        }
+        if (left == right) {
+            return longer;
+        }
+
+        // Letters after the last shared link differ, as every letter after a
+        // path has a single link
+        while (pathLinks[left].parent != pathLinks[right].parent) {
+            left = pathLinks[left].parent;
+            right = pathLinks[right].parent;
+        }
+        return pathLinks[left].letter - pathLinks[right].letter;
+    }
+
+    /* Returns true if a candidate is searched after another: a lower
+       frequency, a word at the frequency of a subtree, or a word
+       alphabetically after another at the same frequency. A word is only
+       taken once no subtree can hold an alphabetically smaller word of the
+       same frequency
+       left: first candidate
+       right: second candidate
+    */
+    bool searchedAfter(const Candidate& left, const Candidate& right) const {
+        if (left.freq != right.freq) {
+            return left.freq < right.freq;
+        }
+        if ((left.node == NO_NODE) != (right.node == NO_NODE)) {
+            return left.node == NO_NODE;
+        }
+        if (left.node == NO_NODE) {
+            return comparePaths(left.path, right.path) > 0;
+        }
+        return false;
+    }
+
+    /* Adds a link after the path of another and returns it
+       letter: letter of the link
+       parent: link of the path it follows, or -1 for the prefix
+    */
+    int addLink(char letter, int parent) {
+        int depth = parent < 0 ? 1 : pathLinks[parent].depth + 1;
+        pathLinks.push_back(PathLink{letter, parent, depth});
+        return pathLinks.size() - 1;
+    }
+
+    /* Builds the word whose path ends in a link
+       prefix: letters before the path
+       path: link of the last letter, or -1 for the prefix itself
+    */
+    string buildWord(const string& prefix, int path) const {
+        int depth = path < 0 ? 0 : pathLinks[path].depth;
+        string word(prefix.size() + depth, ' ');
+        copy(prefix.begin(), prefix.end(), word.begin());
+
+        // Fill in the letters from the last back to the prefix
+        for (int i = word.size() - 1; path >= 0; i--) {
+            word[i] = pathLinks[path].letter;
+            path = pathLinks[path].parent;
+        }
+        return word;
+    }
+
+    /* Offers the word in pathBuffer to the best numCompletions words found,
+       copying it only if it is kept
+       freq: frequency of the word
+       numCompletions: number of words kept
+    */
+    void offerWord(int freq, unsigned int numCompletions) {
+        if (numCompletions == 0) {
+            return;
+        }
+
+        // Keep the word while there is room, reusing the memory of a word
+        // kept by an earlier search
+        if (topSize < numCompletions) {
+            if (topSize == topWords.size()) {
+                topWords.emplace_back(freq, pathBuffer);
+            } else {
+                topWords[topSize].first = freq;
+                topWords[topSize].second.assign(pathBuffer);
+            }
+            topSize++;
+            push_heap(topWords.begin(), topWords.begin() + topSize,
+                      rankedBefore);
+            return;
+        }
+
+        // Otherwise the word must beat the worst kept, which it replaces
+        const pair<int, string>& worst = topWords.front();
+        if (freq < worst.first ||
+            (freq == worst.first && pathBuffer >= worst.second)) {
+            return;
+        }
+        pop_heap(topWords.begin(), topWords.begin() + topSize, rankedBefore);
+        topWords[topSize - 1].first = freq;
+        topWords[topSize - 1].second.assign(pathBuffer);
+        push_heap(topWords.begin(), topWords.begin() + topSize, rankedBefore);
+    }
+
+    /* Recursively traverse through trie to predict words based on given
+       prefix with underscores. The letters of the path are pushed to
+       pathBuffer on the way down and popped on the way back
+       trie: trie being searched
+       node: node containing letter being checked
+       curIdx: current index of the pattern being checked
+       pattern: pattern to be searched in trie
+       numCompletions: number of words kept
+    */
+    void underscoreHelper(const Trie& trie, uint32_t node, unsigned int curIdx,
+                          const string& pattern, unsigned int numCompletions) {
+        // If curIdx about to go out of bounds, return
+        if (curIdx > pattern.size() - 1) {
+            return;
+        }
+
+        char letter = trie.letterOf(node);
+
+        // If letter is a wildcard
+        if (pattern.at(curIdx) == '_') {
+            // If letter is end of word, offer it
+            if (trie.isWord(node) && curIdx == pattern.size() - 1) {
+                pathBuffer.push_back(letter);
+                offerWord(trie.freqOf(node), numCompletions);
+                pathBuffer.pop_back();
+            }
+
+            // Go left if left node exists
+            uint32_t left = trie.leftOf(node);
+            if (left != NO_NODE) {
+                underscoreHelper(trie, left, curIdx, pattern, numCompletions);
+            }
+
+            // Go middle if middle node exists, add letter to the path, and
+            // increment curIdx
+            uint32_t middle = trie.middleOf(node);
+            if (middle != NO_NODE) {
+                pathBuffer.push_back(letter);
+                underscoreHelper(trie, middle, curIdx + 1, pattern,
+                                 numCompletions);
+                pathBuffer.pop_back();
+            }
+
+            // Go right if right node exists
+            uint32_t right = trie.rightOf(node);
+            if (right != NO_NODE) {
+                underscoreHelper(trie, right, curIdx, pattern, numCompletions);
+            }
+        }
+
+        // If letter is not an underscore
+        if (pattern.at(curIdx) != '_') {
+            // If letter is end of word, offer it
+            if (trie.isWord(node) && curIdx == pattern.size() - 1 &&
+                pattern.at(curIdx) == letter) {
+                pathBuffer.push_back(letter);
+                offerWord(trie.freqOf(node), numCompletions);
+                pathBuffer.pop_back();
+            } else if (pattern.at(curIdx) < letter) {
+                // If current letter is less than the node's letter go left
+                uint32_t left = trie.leftOf(node);
+                if (left != NO_NODE) {
+                    underscoreHelper(trie, left, curIdx, pattern,
+                                     numCompletions);
+                }
+            } else if (pattern.at(curIdx) == letter) {
+                // If current letter equals the node's letter go middle, add
+                // letter to the path, and increment curIdx
+                uint32_t middle = trie.middleOf(node);
+                if (middle != NO_NODE) {
+                    pathBuffer.push_back(letter);
+                    underscoreHelper(trie, middle, curIdx + 1, pattern,
+                                     numCompletions);
+                    pathBuffer.pop_back();
+                }
+            } else {
+                // If current letter is greater than the node's letter go
+                // right
+                uint32_t right = trie.rightOf(node);
+                if (right != NO_NODE) {
+                    underscoreHelper(trie, right, curIdx, pattern,
+                                     numCompletions);
+                }
+            }
+        }
+    }
+
+  public:
+    /* Initializes the state of a search that has not been run */
+    TrieSearch() { topSize = 0; }
+
+    /* Predicts numCompletion words below the node of a prefix's last letter,
+       highest frequency first, then alphabetically. Subtrees are searched
+       best first by their highest frequency, so only the nodes that can hold
+       one of the top words are visited. Candidates keep the link of their
+       path rather than its letters, so a word is only built once it is taken
+       trie: trie being searched
+       begin: node of the last letter of prefix
+       prefix: beginning of word to be found
+       numCompletions: maximum amount of words to be found
+    */
+    vector<string> predictCompletions(const Trie& trie, uint32_t begin,
+                                      const string& prefix,
+                                      unsigned int numCompletions) {
+        // Start from no links and no candidates, keeping their memory
+        pathLinks.clear();
+        candidates.clear();
+
+        // Heap order of the candidates, the one searched first on top
+        auto after = [this](const Candidate& left, const Candidate& right) {
+            return searchedAfter(left, right);
+        };
+        auto push = [&](const Candidate& candidate) {
+            candidates.push_back(candidate);
+            push_heap(candidates.begin(), candidates.end(), after);
+        };
+
+        // If prefix itself is a word, it is a candidate
+        if (trie.isWord(begin)) {
+            push(Candidate{trie.freqOf(begin), NO_NODE, -1});
+        }
+
+        // Every word below the prefix is in the middle subtree
+        uint32_t middle = trie.middleOf(begin);
+        if (middle != NO_NODE) {
+            push(Candidate{trie.maxFreqOf(middle), middle, -1});
+        }
+
+        // String vector containing only words
+        vector<string> wordsWithPrefix;
+
+        // Take words until enough are found or no candidates are left
+        while (!candidates.empty() &&
+               wordsWithPrefix.size() < numCompletions) {
+            pop_heap(candidates.begin(), candidates.end(), after);
+            Candidate candidate = candidates.back();
+            candidates.pop_back();
+
+            // No candidate left can beat a word taken off the top
+            if (candidate.node == NO_NODE) {
+                wordsWithPrefix.push_back(buildWord(prefix, candidate.path));
+                continue;
+            }
+
+            // Split the subtree into its word and its three children, the
+            // word and the middle child sharing the link of the node's letter
+            uint32_t node = candidate.node;
+            uint32_t left = trie.leftOf(node);
+            uint32_t middle = trie.middleOf(node);
+            uint32_t right = trie.rightOf(node);
+            bool isWord = trie.isWord(node);
+            int link = -1;
+            if (isWord || middle != NO_NODE) {
+                link = addLink(trie.letterOf(node), candidate.path);
+            }
+            if (isWord) {
+                push(Candidate{trie.freqOf(node), NO_NODE, link});
+            }
+            if (left != NO_NODE) {
+                push(Candidate{trie.maxFreqOf(left), left, candidate.path});
+            }
+            if (middle != NO_NODE) {
+                push(Candidate{trie.maxFreqOf(middle), middle, link});
+            }
+            if (right != NO_NODE) {
+                push(Candidate{trie.maxFreqOf(right), right, candidate.path});
+            }
+        }
+
+        return wordsWithPrefix;
+    }
+
+    /* Predict completions with given word with wildcard underscores, highest
+       frequency first, then alphabetically. Only the best numCompletions
+       words found are kept as the trie is searched
+       trie: trie being searched
+       root: root node of trie
+       pattern: word with underscores to be autocompleted
+       numCompletions: maximum amount of words to be found
+    */
+    vector<string> predictUnderscores(const Trie& trie, uint32_t root,
+                                      const string& pattern,
+                                      unsigned int numCompletions) {
+        // Start from an empty path and no words, keeping their memory
+        pathBuffer.clear();
+        topSize = 0;
+
+        // Call helper to traverse trie and find autocompleted words
+        underscoreHelper(trie, root, 0, pattern, numCompletions);
+
+        // Sort the words kept by frequency, then alphabetically if freq equal
+        sort(topWords.begin(), topWords.begin() + topSize, rankedBefore);
+
+        // Vector with valid words
+        vector<string> results;
+        results.reserve(topSize);
+        for (unsigned int i = 0; i < topSize; i++) {
+            results.push_back(topWords[i].second);
+        }
+
+        return results;
+    }
+};
+
+#endif  // TRIE_SEARCH_HPP
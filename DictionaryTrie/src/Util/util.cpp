@@ -3,6 +3,7 @@
  * benchmarking DictionaryTrie
  */
 #include "util.hpp"
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -111,3 +112,21 @@ void Utils::loadDict(vector<string>& dict, istream& words) {
         if (words.eof()) break;
     }
 }
+
+/* Load a snapshot into the frozen trie, or the words of a dictionary file
+ * frozen once loaded. Returns false if the file could not be read */
+bool Utils::loadFrozen(FrozenTrie& frozen, const char* filename) {
+    // A snapshot is mapped and read in place
+    if (FrozenTrie::isSnapshot(filename)) {
+        return frozen.load(filename);
+    }
+
+    ifstream in(filename, ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    DictionaryTrie dict;
+    loadDict(dict, in);
+    frozen.freeze(dict);
+    return true;
+}
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <vector>
 #include "DictionaryTrie.hpp"
+#include "FrozenTrie.hpp"
 
 using namespace std;
 
@@ -40,6 +41,10 @@ class Utils {
 
     /* Load all the words in word stream into a vector */
     void static loadDict(vector<string>& dict, istream& words);
+
+    /* Load a snapshot into the frozen trie, or the words of a dictionary file
+     * frozen once loaded. Returns false if the file could not be read */
+    bool static loadFrozen(FrozenTrie& frozen, const char* filename);
 };
 
 #endif  // UTIL_HPP
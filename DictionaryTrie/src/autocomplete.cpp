@@ -6,6 +6,7 @@
 #include <sstream>
 #include <vector>
 #include "DictionaryTrie.hpp"
+#include "FrozenTrie.hpp"
 #include "util.hpp"
 
 using namespace std;
@@ -42,28 +43,34 @@ bool fileValid(const char* fileName) {
  * cout << completion << endl;
  * cout << "Continue? (y/n)" << endl;
  *
- * arg 1 - Input file name (in format like freq_dict.txt)
+ * arg 1 - Input file name (in format like freq_dict.txt), or a snapshot
+ * written by ./snapshot
  */
 int main(int argc, char** argv) {
     const int NUM_ARG = 2;
     if (argc != NUM_ARG) {
         cout << "Invalid number of arguments.\n"
-             << "Usage: ./autocomplete <dictionary filename>" << endl;
+             << "Usage: ./autocomplete <dictionary or snapshot filename>"
+             << endl;
         return -1;
     }
     if (!fileValid(argv[1])) return -1;
 
-    DictionaryTrie* dt = new DictionaryTrie();
+    // The dictionary is only queried, so it is kept frozen in its succinct
+    // form. A snapshot is mapped as it is, and a dictionary file is read into
+    // a trie and frozen
+    FrozenTrie* frozen = new FrozenTrie();
 
     // Read all the tokens of the file in order to get every word
     cout << "Reading file: " << argv[1] << endl;
 
-    ifstream in;
-    in.open(argv[1], ios::binary);
     string word;
 
-    Utils::loadDict(*dt, in);
-    in.close();
+    if (!Utils::loadFrozen(*frozen, argv[1])) {
+        cout << "Invalid input file. Please try again.\n";
+        delete frozen;
+        return -1;
+    }
 
     char cont = 'y';
     unsigned int numberOfCompletions;
@@ -84,9 +91,11 @@ int main(int argc, char** argv) {
         }
 
         if (isUnderscore == false) {
-            completionVect = dt->predictCompletions(word, numberOfCompletions);
+            completionVect =
+                frozen->predictCompletions(word, numberOfCompletions);
         } else {
-            completionVect = dt->predictUnderscores(word, numberOfCompletions);
+            completionVect =
+                frozen->predictUnderscores(word, numberOfCompletions);
         }
 
         for (int i = 0; i < completionVect.size(); i++) {
@@ -97,6 +106,6 @@ int main(int argc, char** argv) {
         cin >> cont;
         cin.ignore();
     }
-    delete dt;
+    delete frozen;
     return 0;
 }
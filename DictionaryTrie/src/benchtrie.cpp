@@ -4,24 +4,18 @@
 #include <fstream>
 #include <sstream>
 #include "DictionaryTrie.hpp"
+#include "FrozenTrie.hpp"
 #include "util.hpp"
 using namespace std;
 
 /* Test the runtime of autocompelte using different prefix and number of
  * completions
+ * trie: DictionaryTrie or FrozenTrie to be queried
  */
-void testRuntime(string filename) {
+template <class Trie>
+void testQueries(Trie* trie) {
     const unsigned int NUM_COMP = 10;
 
-    ifstream in;
-    in.open(filename, ios::binary);
-
-    // Testing student's trie
-    cout << "\nLoading dictionary..." << endl;
-
-    DictionaryTrie* trie = new DictionaryTrie();
-    Utils::loadDict(*trie, in);
-
     Timer timer;
     vector<string> results;
     long long time = 0;
@@ -97,6 +91,42 @@ void testRuntime(string filename) {
             cout << "Enter prefix: ";
         }
     }
+}
+
+/* Load the dictionary, timing how long it takes, and test the runtime of
+ * autocomplete on it. A snapshot is mapped and queried as a FrozenTrie
+ */
+void testRuntime(string filename) {
+    Timer timer;
+
+    // Testing student's trie
+    cout << "\nLoading dictionary..." << endl;
+
+    if (FrozenTrie::isSnapshot(filename.c_str())) {
+        FrozenTrie* frozen = new FrozenTrie();
+        timer.begin_timer();
+        bool loaded = frozen->load(filename.c_str());
+        long long time = timer.end_timer();
+        if (!loaded) {
+            cout << "Invalid snapshot file. Please try again.\n";
+            delete frozen;
+            return;
+        }
+        cout << "\tTime taken: " << time << " nanoseconds." << endl;
+        testQueries(frozen);
+        delete frozen;
+        return;
+    }
+
+    ifstream in;
+    in.open(filename, ios::binary);
+
+    DictionaryTrie* trie = new DictionaryTrie();
+    timer.begin_timer();
+    Utils::loadDict(*trie, in);
+    cout << "\tTime taken: " << timer.end_timer() << " nanoseconds." << endl;
+
+    testQueries(trie);
     delete trie;
 }
 
@@ -128,7 +158,8 @@ int main(int argc, char* argv[]) {
 
     if (argc != NUM_ARG) {
         cout << "Invalid number of arguments.\n"
-             << "Usage: ./benchtrie <dictionary filename>" << endl;
+             << "Usage: ./benchtrie <dictionary or snapshot filename>"
+             << endl;
         return -1;
     }
 
@@ -0,0 +1,52 @@
+/*
+ * Program that freezes a dictionary and writes it to a snapshot, which
+ * autocomplete and benchtrie map and query without rebuilding the trie
+ */
+#include <fstream>
+#include <iostream>
+#include "DictionaryTrie.hpp"
+#include "FrozenTrie.hpp"
+#include "util.hpp"
+
+using namespace std;
+
+/* The main function that loads the dictionary, freezes it, and saves it
+ *
+ * arg 1 - Input file name (in format like freq_dict.txt)
+ * arg 2 - Snapshot file name
+ */
+int main(int argc, char** argv) {
+    const int NUM_ARG = 3;
+    if (argc != NUM_ARG) {
+        cout << "Invalid number of arguments.\n"
+             << "Usage: ./snapshot <dictionary filename> <snapshot filename>"
+             << endl;
+        return -1;
+    }
+
+    ifstream in;
+    in.open(argv[1], ios::binary);
+    if (!in.is_open()) {
+        cout << "Invalid input file. No file was opened. Please try again.\n";
+        return -1;
+    }
+
+    cout << "Reading file: " << argv[1] << endl;
+    DictionaryTrie* dt = new DictionaryTrie();
+    Utils::loadDict(*dt, in);
+    in.close();
+
+    // Freeze the trie, which is no longer needed afterwards
+    FrozenTrie* frozen = new FrozenTrie(*dt);
+    delete dt;
+
+    if (!frozen->save(argv[2])) {
+        cout << "Could not write snapshot: " << argv[2] << endl;
+        delete frozen;
+        return -1;
+    }
+    cout << "Wrote " << frozen->size() << " nodes in " << frozen->bytes()
+         << " bytes to " << argv[2] << endl;
+    delete frozen;
+    return 0;
+}
@@ -115,4 +115,48 @@ TEST(DictTrieTests, TEST_UNDERSCORES) {
 
     // Check inserting word that already exists in trie
     ASSERT_EQ(dict.insert("g", 10), false);
-}
\ No newline at end of file
+}
+
+/* Test that predictCompletions finds the top words of a large trie in order,
+ * with ties broken alphabetically */
+TEST(DictTrieTests, TEST_TOP_COMPLETIONS) {
+    DictionaryTrie dict;
+    vector<pair<int, string>> words;
+
+    // Every two letter word and some longer ones, with many equal frequencies
+    for (char first = 'a'; first <= 'z'; first++) {
+        for (char second = 'a'; second <= 'z'; second++) {
+            string word = {first, second};
+            words.push_back(make_pair((first * second) % 7, word));
+            words.push_back(make_pair((first + second) % 5, word + "ing"));
+        }
+    }
+    for (auto& word : words) {
+        ASSERT_EQ(dict.insert(word.second, word.first), true);
+    }
+
+    // A prefix marked as a word after its completions raises their subtree
+    ASSERT_EQ(dict.insert("q", 100), false);
+    words.push_back(make_pair(100, "q"));
+
+    sort(words.begin(), words.end(), [](auto& left, auto& right) {
+        if (left.first != right.first) {
+            return left.first > right.first;
+        }
+        return left.second < right.second;
+    });
+
+    for (string prefix : {"a", "q", "mo", "zz", "bing"}) {
+        for (unsigned int numCompletions : {1u, 3u, 10u, 100u}) {
+            vector<string> expected;
+            for (auto& word : words) {
+                if (word.second.compare(0, prefix.size(), prefix) == 0 &&
+                    expected.size() < numCompletions) {
+                    expected.push_back(word.second);
+                }
+            }
+            ASSERT_EQ(dict.predictCompletions(prefix, numCompletions),
+                      expected);
+        }
+    }
+}
@@ -0,0 +1,141 @@
+/**
+ * Tester File to test correctness of FrozenTrie.cpp
+ *
+ * Author: James Chong
+ * Email: j2chong@ucsd.edu
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "DictionaryTrie.hpp"
+#include "FrozenTrie.hpp"
+
+using namespace std;
+using namespace testing;
+
+/* Test that a frozen empty trie predicts nothing */
+TEST(FrozenTrieTests, EMPTY_TEST) {
+    DictionaryTrie dict;
+    FrozenTrie frozen(dict);
+    vector<string> vect = {};
+
+    ASSERT_EQ(frozen.size(), 0);
+    ASSERT_EQ(frozen.predictCompletions("hello", 10), vect);
+    ASSERT_EQ(frozen.predictUnderscores("h_llo", 10), vect);
+}
+
+/* Test that a frozen trie predicts the words of the trie it was frozen from,
+ * which may be deleted afterwards */
+TEST(FrozenTrieTests, TEST_SMALL_TRIE) {
+    DictionaryTrie* dict = new DictionaryTrie();
+    ASSERT_EQ(dict->insert("journal", 20), true);
+    ASSERT_EQ(dict->insert("journalist", 30), true);
+    ASSERT_EQ(dict->insert("journalize", 5), true);
+    ASSERT_EQ(dict->insert("journalese", 20), true);
+    ASSERT_EQ(dict->insert("journals", 100), true);
+    ASSERT_EQ(dict->insert("cat", 1), true);
+    ASSERT_EQ(dict->insert("car", 2), true);
+    ASSERT_EQ(dict->insert("got", 10), true);
+    ASSERT_EQ(dict->insert("gut", 11), true);
+
+    FrozenTrie frozen(*dict);
+    delete dict;
+
+    vector<string> vect1 = {"journals", "journalist", "journal",
+                            "journalese", "journalize"};
+    ASSERT_EQ(frozen.predictCompletions("journal", 30), vect1);
+
+    vector<string> vect2 = {"journals"};
+    ASSERT_EQ(frozen.predictCompletions("journal", 1), vect2);
+
+    vector<string> vect3 = {"gut", "got", "cat"};
+    ASSERT_EQ(frozen.predictUnderscores("__t", 10), vect3);
+
+    vector<string> vect4 = {};
+    ASSERT_EQ(frozen.predictCompletions("dog", 10), vect4);
+}
+
+/* Test that a frozen trie predicts as its trie does on many prefixes and
+ * patterns, with many equal frequencies */
+TEST(FrozenTrieTests, TEST_MATCHES_TRIE) {
+    DictionaryTrie dict;
+    for (char first = 'a'; first <= 'z'; first++) {
+        for (char second = 'a'; second <= 'z'; second++) {
+            string word = {first, second};
+            dict.insert(word, (first * second) % 7);
+            dict.insert(word + "ing", (first + second) % 5);
+            dict.insert(word + first + "s", first * 1000 + second);
+        }
+    }
+    ASSERT_EQ(dict.insert("q", 100), false);
+
+    FrozenTrie frozen(dict);
+    for (string prefix : {"a", "q", "mo", "zz", "bing", "kk", "x"}) {
+        for (unsigned int numCompletions : {0u, 1u, 3u, 10u, 100u}) {
+            ASSERT_EQ(frozen.predictCompletions(prefix, numCompletions),
+                      dict.predictCompletions(prefix, numCompletions));
+        }
+    }
+    for (string pattern : {"_", "__", "_a_", "__ing", "m___", "___s", "z__"}) {
+        for (unsigned int numCompletions : {0u, 1u, 5u, 100u}) {
+            ASSERT_EQ(frozen.predictUnderscores(pattern, numCompletions),
+                      dict.predictUnderscores(pattern, numCompletions));
+        }
+    }
+}
+
+/* Test that a saved snapshot loads into a trie predicting as the one saved,
+ * and that a file that is not a snapshot is rejected */
+TEST(FrozenTrieTests, TEST_SNAPSHOT) {
+    const char* snapshotName = "test_FrozenTrie.snapshot";
+    const char* textName = "test_FrozenTrie.txt";
+
+    DictionaryTrie dict;
+    for (char first = 'a'; first <= 'z'; first++) {
+        for (char second = 'a'; second <= 'z'; second++) {
+            string word = {first, second};
+            dict.insert(word, (first * second) % 11);
+            dict.insert(word + second + "ed", first + second * 100000);
+        }
+    }
+
+    FrozenTrie frozen(dict);
+    ASSERT_EQ(frozen.save(snapshotName), true);
+    ASSERT_EQ(FrozenTrie::isSnapshot(snapshotName), true);
+
+    FrozenTrie loaded;
+    ASSERT_EQ(loaded.load(snapshotName), true);
+    ASSERT_EQ(loaded.size(), frozen.size());
+    ASSERT_EQ(loaded.bytes(), frozen.bytes());
+    for (string prefix : {"a", "mm", "qz", "zzz", "x"}) {
+        ASSERT_EQ(loaded.predictCompletions(prefix, 10),
+                  dict.predictCompletions(prefix, 10));
+    }
+    for (string pattern : {"__", "a___", "_b_ed"}) {
+        ASSERT_EQ(loaded.predictUnderscores(pattern, 10),
+                  dict.predictUnderscores(pattern, 10));
+    }
+
+    // An empty trie saves and loads as well
+    FrozenTrie empty;
+    ASSERT_EQ(empty.save(snapshotName), true);
+    ASSERT_EQ(loaded.load(snapshotName), true);
+    ASSERT_EQ(loaded.size(), 0);
+
+    // A dictionary file is not a snapshot, and loading it leaves the trie
+    // empty
+    ofstream text(textName);
+    text << "10 hello\n";
+    text.close();
+    ASSERT_EQ(FrozenTrie::isSnapshot(textName), false);
+    ASSERT_EQ(frozen.load(textName), false);
+    ASSERT_EQ(frozen.size(), 0);
+    ASSERT_EQ(frozen.predictCompletions("he", 10), vector<string>());
+
+    remove(snapshotName);
+    remove(textName);
+}